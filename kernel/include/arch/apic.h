@@ -0,0 +1,136 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/apic.h                                                                        |
+// | Name          : x86 Local APIC Driver (Header)                                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the x2APIC/xAPIC register interface, IPI transmission and the one-shot timer.            |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_APIC_H
+#define _ARCH_APIC_H
+
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+
+// Registers are named by their x2APIC index (MSR address - 0x800); the xAPIC MMIO offset is the index times 16.
+#define APIC_REG_ID                  0x02
+#define APIC_REG_VERSION             0x03
+#define APIC_REG_TPR                 0x08
+#define APIC_REG_EOI                 0x0B
+#define APIC_REG_LDR                 0x0D
+#define APIC_REG_SIVR                0x0F
+#define APIC_REG_ESR                 0x28
+#define APIC_REG_ICR                 0x30
+#define APIC_REG_ICR_HIGH            0x31       /* xAPIC only */
+#define APIC_REG_LVT_TIMER           0x32
+#define APIC_REG_LVT_THERMAL         0x33
+#define APIC_REG_LVT_PMI             0x34
+#define APIC_REG_LVT_LINT0           0x35
+#define APIC_REG_LVT_LINT1           0x36
+#define APIC_REG_LVT_ERROR           0x37
+#define APIC_REG_TIMER_INIT          0x38
+#define APIC_REG_TIMER_CURRENT       0x39
+#define APIC_REG_TIMER_DIVIDE        0x3E
+
+#define APIC_BASE_BSP                (1ULL << 8)
+#define APIC_BASE_EXTD               (1ULL << 10)
+#define APIC_BASE_ENABLE             (1ULL << 11)
+#define APIC_BASE_ADDR_MASK          0x000FFFFFFFFFF000ULL
+
+#define APIC_SIVR_ENABLE             (1u << 8)
+#define APIC_LVT_MASKED              (1u << 16)
+#define APIC_LVT_DM_NMI              (4u << 8)
+#define APIC_LVT_TIMER_ONESHOT       (0u << 17)
+#define APIC_LVT_TIMER_TSC_DEADLINE  (2u << 17)
+
+#define APIC_ICR_DM_FIXED            (0u << 8)
+#define APIC_ICR_DM_INIT             (5u << 8)
+#define APIC_ICR_DM_STARTUP          (6u << 8)
+#define APIC_ICR_LOGICAL             (1u << 11)
+#define APIC_ICR_BUSY                (1u << 12)
+#define APIC_ICR_ASSERT              (1u << 14)
+#define APIC_ICR_SELF                (1u << 18)
+#define APIC_ICR_ALL_BUT_SELF        (3u << 18)
+
+/// Local APIC mode and addressing. The mode is chosen once on the bootstrap processor and every AP follows it.
+struct apic_state {
+    bool               x2apic;          ///< registers are accessed through MSRs 0x800-0x8FF
+    bool               tsc_deadline;    ///< the timer is armed by writing an absolute TSC value
+    volatile uint32_t *mmio;            ///< register page in xAPIC mode, uncached in the direct map after apic_map()
+    uint64_t           timer_mult;      ///< APIC timer ticks per TSC cycle, scaled by 2^32 (one-shot mode only)
+    uint32_t           apic_id[CONFIG_MAX_CPUS];
+    uint32_t           logical_id[CONFIG_MAX_CPUS];  ///< x2APIC LDR: cluster in bits 31:16, member bit in bits 15:0
+} __cacheline_aligned;
+
+extern struct apic_state apic;
+
+void apic_init(unsigned int cpu);
+int  apic_map(void);
+void apic_send_ipi(unsigned int cpu, uint8_t vector);
+void apic_send_ipi_mask(const struct cpumask *mask, uint8_t vector);
+void apic_send_ipi_all_but_self(uint8_t vector);
+void apic_send_init(unsigned int cpu);
+void apic_send_startup(unsigned int cpu, uint8_t page);
+void apic_timer_arm(uint64_t deadline_tsc);
+void apic_timer_cancel(void);
+
+/// @fn      static inline uint32_t apic_read(uint32_t reg)
+/// @brief   Reads a local APIC register of the executing processor.
+///
+/// @param   reg the register index (APIC_REG_*)
+/// @returns the register contents
+static __always_inline uint32_t apic_read(uint32_t reg)
+{
+    if (likely(apic.x2apic))
+        return (uint32_t) _rdmsr(0x800 + reg);
+    return apic.mmio[reg * 4];
+}
+
+/// @fn      static inline void apic_write(uint32_t reg, uint32_t value)
+/// @brief   Writes a local APIC register of the executing processor.
+///
+/// @param   reg   the register index (APIC_REG_*)
+/// @param   value the value to write
+/// @returns None (void)
+static __always_inline void apic_write(uint32_t reg, uint32_t value)
+{
+    if (likely(apic.x2apic))
+        _wrmsr(0x800 + reg, value);
+    else
+        apic.mmio[reg * 4] = value;
+}
+
+/// @fn      static inline void apic_eoi(void)
+/// @brief   Signals end-of-interrupt for the highest-priority in-service interrupt.
+///
+/// @details In x2APIC mode this is a single non-serializing WRMSR.
+///
+/// @returns None (void)
+static __always_inline void apic_eoi(void)
+{
+    apic_write(APIC_REG_EOI, 0);
+}
+
+#endif /* _ARCH_APIC_H */
\ No newline at end of file
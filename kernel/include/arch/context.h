@@ -0,0 +1,56 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/context.h                                                                     |
+// | Name          : x86 Kernel Context Switch (Header)                                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the callee-saved register switch between kernel thread stacks.                           |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_CONTEXT_H
+#define _ARCH_CONTEXT_H
+
+#include "sys/freestd.h"
+
+struct thread;
+
+/// @fn      struct thread *context_switch(uint64_t *save_rsp, uint64_t next_rsp, struct thread *prev)
+/// @brief   Saves the callee-saved registers on the current stack, stores the stack pointer, and resumes another stack.
+///
+/// @details Only RBX, RBP and R12-R15 are saved; every other register is caller-saved under the SysV ABI and already
+/// dead at the call site. The prev argument is carried across the switch in RAX, so the code that resumes on the new
+/// stack learns which thread it replaced without consulting any shared state.
+///
+/// @param   save_rsp where to store the outgoing stack pointer
+/// @param   next_rsp the stack pointer previously saved for the incoming context
+/// @param   prev     the outgoing thread
+/// @returns the thread that was running before the incoming context was resumed
+struct thread *context_switch(uint64_t *save_rsp, uint64_t next_rsp, struct thread *prev);
+
+/// @fn      uint64_t context_init(void *stack_top, void (*entry)(void *), void *arg)
+/// @brief   Builds an initial switch frame so that the first context_switch() to it starts entry(arg).
+///
+/// @param   stack_top the top (highest address) of the new thread's kernel stack
+/// @param   entry     the thread function
+/// @param   arg       the argument passed to entry
+/// @returns the stack pointer to store as the thread's saved RSP
+uint64_t context_init(void *stack_top, void (*entry)(void *), void *arg);
+
+#endif /* _ARCH_CONTEXT_H */
\ No newline at end of file
@@ -0,0 +1,215 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/cpu.h                                                                         |
+// | Name          : x86 CPU Feature Cache & Capability Queries (Header)                                               |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the per-CPU CPUID and capability-MSR cache populated once per processor at boot.         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_CPU_H
+#define _ARCH_CPU_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+// Feature numbers encode (capability word << 5) | bit, so cpu_has() is one load and one bit test. Words 0-10 mirror
+// CPUID output registers verbatim; words 11-12 hold the low halves of IA32_ARCH_CAPABILITIES and
+// IA32_CORE_CAPABILITIES, so mitigation code can test immunities with the same primitive.
+#define CPU_CAP_1_ECX                      0
+#define CPU_CAP_1_EDX                      1
+#define CPU_CAP_6_EAX                      2
+#define CPU_CAP_6_ECX                      3
+#define CPU_CAP_7_0_EBX                    4
+#define CPU_CAP_7_0_ECX                    5
+#define CPU_CAP_7_0_EDX                    6
+#define CPU_CAP_D_1_EAX                    7
+#define CPU_CAP_80000001_ECX               8
+#define CPU_CAP_80000001_EDX               9
+#define CPU_CAP_80000007_EDX               10
+#define CPU_CAP_ARCH_CAPABILITIES          11
+#define CPU_CAP_CORE_CAPABILITIES          12
+#define CPU_CAP_WORDS                      13
+
+// XSAVE state components whose layout is recorded, numbered as in XCR0 (through AMX tile data, component 18).
+#define CPU_XSAVE_COMPONENTS               19
+
+#define CPU_FEATURE(word, bit)       (((word) << 5) | (bit))
+
+#define CPU_FEATURE_SSE3                   CPU_FEATURE(CPU_CAP_1_ECX, 0)
+#define CPU_FEATURE_MONITOR                CPU_FEATURE(CPU_CAP_1_ECX, 3)
+#define CPU_FEATURE_EIST                   CPU_FEATURE(CPU_CAP_1_ECX, 7)
+#define CPU_FEATURE_PDCM                   CPU_FEATURE(CPU_CAP_1_ECX, 15)
+#define CPU_FEATURE_PCID                   CPU_FEATURE(CPU_CAP_1_ECX, 17)
+#define CPU_FEATURE_X2APIC                 CPU_FEATURE(CPU_CAP_1_ECX, 21)
+#define CPU_FEATURE_TSC_DEADLINE           CPU_FEATURE(CPU_CAP_1_ECX, 24)
+#define CPU_FEATURE_XSAVE                  CPU_FEATURE(CPU_CAP_1_ECX, 26)
+#define CPU_FEATURE_OSXSAVE                CPU_FEATURE(CPU_CAP_1_ECX, 27)
+#define CPU_FEATURE_AVX                    CPU_FEATURE(CPU_CAP_1_ECX, 28)
+#define CPU_FEATURE_HYPERVISOR             CPU_FEATURE(CPU_CAP_1_ECX, 31)
+#define CPU_FEATURE_FPU                    CPU_FEATURE(CPU_CAP_1_EDX, 0)
+#define CPU_FEATURE_TSC                    CPU_FEATURE(CPU_CAP_1_EDX, 4)
+#define CPU_FEATURE_MSR                    CPU_FEATURE(CPU_CAP_1_EDX, 5)
+#define CPU_FEATURE_APIC                   CPU_FEATURE(CPU_CAP_1_EDX, 9)
+#define CPU_FEATURE_PGE                    CPU_FEATURE(CPU_CAP_1_EDX, 13)
+#define CPU_FEATURE_ACPI                   CPU_FEATURE(CPU_CAP_1_EDX, 22)
+#define CPU_FEATURE_FXSR                   CPU_FEATURE(CPU_CAP_1_EDX, 24)
+#define CPU_FEATURE_DTS                    CPU_FEATURE(CPU_CAP_6_EAX, 0)
+#define CPU_FEATURE_TURBO                  CPU_FEATURE(CPU_CAP_6_EAX, 1)
+#define CPU_FEATURE_ARAT                   CPU_FEATURE(CPU_CAP_6_EAX, 2)
+#define CPU_FEATURE_PTM                    CPU_FEATURE(CPU_CAP_6_EAX, 6)
+#define CPU_FEATURE_HWP                    CPU_FEATURE(CPU_CAP_6_EAX, 7)
+#define CPU_FEATURE_HWP_EPP                CPU_FEATURE(CPU_CAP_6_EAX, 10)
+#define CPU_FEATURE_APERFMPERF             CPU_FEATURE(CPU_CAP_6_ECX, 0)
+#define CPU_FEATURE_EPB                    CPU_FEATURE(CPU_CAP_6_ECX, 3)
+#define CPU_FEATURE_FSGSBASE               CPU_FEATURE(CPU_CAP_7_0_EBX, 0)
+#define CPU_FEATURE_TSC_ADJUST             CPU_FEATURE(CPU_CAP_7_0_EBX, 1)
+#define CPU_FEATURE_SMEP                   CPU_FEATURE(CPU_CAP_7_0_EBX, 7)
+#define CPU_FEATURE_INVPCID                CPU_FEATURE(CPU_CAP_7_0_EBX, 10)
+#define CPU_FEATURE_AVX512F                CPU_FEATURE(CPU_CAP_7_0_EBX, 16)
+#define CPU_FEATURE_SMAP                   CPU_FEATURE(CPU_CAP_7_0_EBX, 20)
+#define CPU_FEATURE_WAITPKG                CPU_FEATURE(CPU_CAP_7_0_ECX, 5)
+#define CPU_FEATURE_LA57                   CPU_FEATURE(CPU_CAP_7_0_ECX, 16)
+#define CPU_FEATURE_MD_CLEAR               CPU_FEATURE(CPU_CAP_7_0_EDX, 10)
+#define CPU_FEATURE_AMX_TILE               CPU_FEATURE(CPU_CAP_7_0_EDX, 24)
+#define CPU_FEATURE_SPEC_CTRL              CPU_FEATURE(CPU_CAP_7_0_EDX, 26)
+#define CPU_FEATURE_STIBP                  CPU_FEATURE(CPU_CAP_7_0_EDX, 27)
+#define CPU_FEATURE_FLUSH_L1D              CPU_FEATURE(CPU_CAP_7_0_EDX, 28)
+#define CPU_FEATURE_ARCH_CAPABILITIES      CPU_FEATURE(CPU_CAP_7_0_EDX, 29)
+#define CPU_FEATURE_CORE_CAPABILITIES      CPU_FEATURE(CPU_CAP_7_0_EDX, 30)
+#define CPU_FEATURE_SSBD                   CPU_FEATURE(CPU_CAP_7_0_EDX, 31)
+#define CPU_FEATURE_XSAVEOPT               CPU_FEATURE(CPU_CAP_D_1_EAX, 0)
+#define CPU_FEATURE_XSAVEC                 CPU_FEATURE(CPU_CAP_D_1_EAX, 1)
+#define CPU_FEATURE_XGETBV1                CPU_FEATURE(CPU_CAP_D_1_EAX, 2)
+#define CPU_FEATURE_XSAVES                 CPU_FEATURE(CPU_CAP_D_1_EAX, 3)
+#define CPU_FEATURE_XFD                    CPU_FEATURE(CPU_CAP_D_1_EAX, 4)
+#define CPU_FEATURE_SYSCALL                CPU_FEATURE(CPU_CAP_80000001_EDX, 11)
+#define CPU_FEATURE_NX                     CPU_FEATURE(CPU_CAP_80000001_EDX, 20)
+#define CPU_FEATURE_PDPE1GB                CPU_FEATURE(CPU_CAP_80000001_EDX, 26)
+#define CPU_FEATURE_RDTSCP                 CPU_FEATURE(CPU_CAP_80000001_EDX, 27)
+#define CPU_FEATURE_LM                     CPU_FEATURE(CPU_CAP_80000001_EDX, 29)
+#define CPU_FEATURE_INVARIANT_TSC          CPU_FEATURE(CPU_CAP_80000007_EDX, 8)
+#define CPU_FEATURE_RDCL_NO                CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 0)
+#define CPU_FEATURE_IBRS_ALL               CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 1)
+#define CPU_FEATURE_RSBA                   CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 2)
+#define CPU_FEATURE_SKIP_L1DFL_VMENTRY     CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 3)
+#define CPU_FEATURE_SSB_NO                 CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 4)
+#define CPU_FEATURE_MDS_NO                 CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 5)
+#define CPU_FEATURE_TAA_NO                 CPU_FEATURE(CPU_CAP_ARCH_CAPABILITIES, 8)
+#define CPU_FEATURE_SPLIT_LOCK_DETECT      CPU_FEATURE(CPU_CAP_CORE_CAPABILITIES, 5)
+
+enum cpu_vendor {
+    CPU_VENDOR_UNKNOWN = 0,
+    CPU_VENDOR_INTEL,
+    CPU_VENDOR_AMD,
+};
+
+/// Everything the kernel needs to know about one logical processor, gathered once by cpu_features_init() on that
+/// processor. The capability words tested by cpu_info_has() lead the structure and, with the leaf limits and x2APIC
+/// ID, fill exactly its first cache line.
+struct cpu_info {
+    uint32_t caps[CPU_CAP_WORDS];
+    uint32_t max_leaf;
+    uint32_t max_ext_leaf;
+    uint32_t x2apic_id;
+    uint8_t  vendor;
+    uint8_t  family;
+    uint8_t  model;
+    uint8_t  stepping;
+
+    // Leaf 0xB/0x1F: right-shifts applied to the x2APIC ID to obtain the core and package identifiers.
+    uint8_t  smt_shift;
+    uint8_t  pkg_shift;
+    uint8_t  phys_addr_bits;
+    uint8_t  virt_addr_bits;
+
+    // Leaf 0xD: XSAVE area sizes (standard format for the enabled and all-supported sets, compacted for XSAVES).
+    uint32_t xsave_size;
+    uint32_t xsave_size_max;
+    uint32_t xsaves_size;
+    uint64_t xcr0_mask;
+    uint64_t xss_mask;
+
+    // Leaf 0xD, subleaves 2 and up: layout of each supported user (XCR0) component; zero for the others.
+    uint16_t xsave_comp_size[CPU_XSAVE_COMPONENTS];
+    uint16_t xsave_comp_offset[CPU_XSAVE_COMPONENTS];   ///< standard-format offset
+    uint32_t xsave_align64;                             ///< components 64-byte aligned in the compacted format
+    uint32_t xsave_xfd;                                 ///< components XFD can arm
+
+    // Leaf 5: smallest monitor-line size, MWAIT extensions (ECX) and the number of sub-states of each MWAIT C-state,
+    // four bits per state with C0 in bits 3:0 (EDX). Zero without MONITOR/MWAIT.
+    uint16_t monitor_line;
+    uint16_t mwait_ext;
+    uint32_t mwait_substates;
+
+    // Leaf 0x15/0x16: TSC/crystal ratio and nominal frequencies. Zero where not enumerated.
+    uint32_t tsc_denominator;
+    uint32_t tsc_numerator;
+    uint32_t crystal_hz;
+    uint16_t base_mhz;
+    uint16_t max_mhz;
+    uint16_t bus_mhz;
+
+    // Leaf 0xA: architectural performance-monitoring version, counter counts and widths, and the bitmap of
+    // architectural events the processor does NOT implement.
+    uint8_t  pmu_version;
+    uint8_t  pmu_gp_counters;
+    uint8_t  pmu_gp_width;
+    uint8_t  pmu_fixed_counters;
+    uint8_t  pmu_fixed_width;
+    uint8_t  pmu_events_unavailable;
+
+    // Full contents of the capability MSRs (zero when CPUID does not enumerate them).
+    uint64_t arch_capabilities;
+    uint64_t core_capabilities;
+} __cacheline_aligned;
+
+extern struct cpu_info cpu_info[CONFIG_MAX_CPUS];
+extern uint32_t        cpu_caps[CPU_CAP_WORDS];
+
+void cpu_features_init(unsigned int cpu);
+
+/// @fn      static inline bool cpu_has(unsigned int feature)
+/// @brief   Tests whether a feature is present on every processor initialized so far.
+///
+/// @details Tests the system-wide capability set, which is the intersection of the capability words of every CPU that
+/// has passed through cpu_features_init(). Kernel code that may run on any CPU should use this test, because a feature
+/// missing from a single core (as happens under some hypervisors) cannot be used safely anywhere.
+///
+/// @param   feature a CPU_FEATURE_* number
+/// @returns true if the feature is present on all initialized processors, otherwise false
+static __always_inline bool cpu_has(unsigned int feature)
+{
+    return (cpu_caps[feature >> 5] >> (feature & 31)) & 1;
+}
+
+/// @fn      static inline bool cpu_info_has(const struct cpu_info *info, unsigned int feature)
+/// @brief   Tests whether a feature is present on one particular processor.
+///
+/// @param   info    the cached description of the processor to test
+/// @param   feature a CPU_FEATURE_* number
+/// @returns true if the feature is present on that processor, otherwise false
+static __always_inline bool cpu_info_has(const struct cpu_info *info, unsigned int feature)
+{
+    return (info->caps[feature >> 5] >> (feature & 31)) & 1;
+}
+
+#endif /* _ARCH_CPU_H */
\ No newline at end of file
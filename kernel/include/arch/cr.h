@@ -0,0 +1,82 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/cr.h                                                                          |
+// | Name          : x86 Control Register Bit Definitions                                                              |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Contains definitions of the architectural bits of CR0, CR3, CR4 and IA32_EFER.                    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_CR_H
+#define _ARCH_CR_H
+
+#define CR0_PE                       (1ULL << 0)
+#define CR0_MP                       (1ULL << 1)
+#define CR0_EM                       (1ULL << 2)
+#define CR0_TS                       (1ULL << 3)
+#define CR0_ET                       (1ULL << 4)
+#define CR0_NE                       (1ULL << 5)
+#define CR0_WP                       (1ULL << 16)
+#define CR0_AM                       (1ULL << 18)
+#define CR0_NW                       (1ULL << 29)
+#define CR0_CD                       (1ULL << 30)
+#define CR0_PG                       (1ULL << 31)
+
+#define CR3_PCID_MASK                0x0000000000000FFFULL
+#define CR3_NOFLUSH                  (1ULL << 63)
+
+#define CR4_VME                      (1ULL << 0)
+#define CR4_PVI                      (1ULL << 1)
+#define CR4_TSD                      (1ULL << 2)
+#define CR4_DE                       (1ULL << 3)
+#define CR4_PSE                      (1ULL << 4)
+#define CR4_PAE                      (1ULL << 5)
+#define CR4_MCE                      (1ULL << 6)
+#define CR4_PGE                      (1ULL << 7)
+#define CR4_PCE                      (1ULL << 8)
+#define CR4_OSFXSR                   (1ULL << 9)
+#define CR4_OSXMMEXCPT               (1ULL << 10)
+#define CR4_UMIP                     (1ULL << 11)
+#define CR4_LA57                     (1ULL << 12)
+#define CR4_VMXE                     (1ULL << 13)
+#define CR4_SMXE                     (1ULL << 14)
+#define CR4_FSGSBASE                 (1ULL << 16)
+#define CR4_PCIDE                    (1ULL << 17)
+#define CR4_OSXSAVE                  (1ULL << 18)
+#define CR4_SMEP                     (1ULL << 20)
+#define CR4_SMAP                     (1ULL << 21)
+#define CR4_PKE                      (1ULL << 22)
+
+// IA32_EFER is an MSR but architecturally extends CR0/CR4, so its bits are listed here.
+#define EFER_SCE                     (1ULL << 0)
+#define EFER_LME                     (1ULL << 8)
+#define EFER_LMA                     (1ULL << 10)
+#define EFER_NXE                     (1ULL << 11)
+
+// RFLAGS system bits, kept with the control-register bits that govern the same processor state.
+#define RFLAGS_CF                    (1ULL << 0)
+#define RFLAGS_TF                    (1ULL << 8)
+#define RFLAGS_IF                    (1ULL << 9)
+#define RFLAGS_DF                    (1ULL << 10)
+#define RFLAGS_NT                    (1ULL << 14)
+#define RFLAGS_AC                    (1ULL << 18)
+#define RFLAGS_ID                    (1ULL << 21)
+
+#endif /* _ARCH_CR_H */
\ No newline at end of file
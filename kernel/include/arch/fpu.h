@@ -0,0 +1,106 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/fpu.h                                                                         |
+// | Name          : x86 Extended State Management (Header)                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares per-thread x87/SIMD state, lazily allocated and switched with XSAVE.                     |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_FPU_H
+#define _ARCH_FPU_H
+
+#include "kern/thread.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+// XSAVE state components (Intel SDM Vol. 1, 13.1).
+#define XFEATURE_X87                 0
+#define XFEATURE_SSE                 1
+#define XFEATURE_AVX                 2
+#define XFEATURE_OPMASK              5
+#define XFEATURE_ZMM_HI256           6
+#define XFEATURE_HI16_ZMM            7
+#define XFEATURE_PKRU                9
+#define XFEATURE_XTILECFG            17
+#define XFEATURE_XTILEDATA           18
+#define XFEATURE_MAX                 19
+
+#define XFEATURE_MASK_X87            (1ULL << XFEATURE_X87)
+#define XFEATURE_MASK_SSE            (1ULL << XFEATURE_SSE)
+#define XFEATURE_MASK_AVX            (1ULL << XFEATURE_AVX)
+#define XFEATURE_MASK_AVX512         ((1ULL << XFEATURE_OPMASK) | (1ULL << XFEATURE_ZMM_HI256) | \
+                                      (1ULL << XFEATURE_HI16_ZMM))
+#define XFEATURE_MASK_AMX            ((1ULL << XFEATURE_XTILECFG) | (1ULL << XFEATURE_XTILEDATA))
+
+#define XSAVE_LEGACY_SIZE            512
+#define XSAVE_HEADER_SIZE            64
+#define XSAVE_AREA_MIN               (XSAVE_LEGACY_SIZE + XSAVE_HEADER_SIZE)
+#define XSAVE_XCOMP_COMPACTED        (1ULL << 63)
+
+#define FPU_CPU_NONE                 UINT32_MAX
+
+/// Save/restore instruction family in use, chosen once from CPUID.
+enum fpu_mode {
+    FPU_MODE_FXSAVE,                    ///< no XSAVE: 512-byte legacy area
+    FPU_MODE_XSAVE,                     ///< standard format, no optimizations
+    FPU_MODE_XSAVEOPT,                  ///< standard format, init and modified optimizations
+    FPU_MODE_XSAVES,                    ///< compacted format, init and modified optimizations
+};
+
+/// A thread's saved extended state. The area is sized for the components the thread has been allowed to use so far:
+/// components still armed in xfd have no space reserved and are excluded from every save and restore.
+struct fpu_state {
+    uint64_t          xfd;              ///< IA32_XFD value while this thread runs
+    uint32_t          size;             ///< bytes available in area
+    uint32_t          last_cpu;         ///< CPU whose registers last held this state, or FPU_CPU_NONE
+    uint8_t           area[] __aligned(64);
+};
+
+/// System-wide extended-state configuration, fixed by fpu_init(0).
+struct fpu_config {
+    enum fpu_mode mode;
+    uint64_t      xcr0;                 ///< user components enabled in XCR0
+    uint64_t      xfd_mask;             ///< components whose first use is trapped through IA32_XFD
+    uint32_t      base_size;            ///< area size for xcr0 & ~xfd_mask
+    uint32_t      full_size;            ///< area size for xcr0
+};
+
+/// Per-CPU ownership of the live register state, and event counters.
+struct fpu_cpu {
+    struct thread *owner;               ///< thread whose state the registers hold, if unchanged since its last save
+    bool           ts;                  ///< CR0.TS is set
+    uint64_t       saves;
+    uint64_t       restores;
+    uint64_t       restores_skipped;    ///< switches back to the owner that found its state still loaded
+    uint64_t       first_use;           ///< #NM traps that allocated a thread's base area
+    uint64_t       xfd_faults;          ///< #NM traps that enabled an XFD-armed component
+} __cacheline_aligned;
+
+extern struct fpu_config fpu_config;
+extern struct fpu_cpu    fpu_cpus[CONFIG_MAX_CPUS];
+
+void fpu_init(unsigned int cpu);
+void fpu_switch(struct thread *prev, struct thread *next);
+int  fpu_trap(struct thread *t);
+void fpu_release(struct thread *t);
+
+#endif /* _ARCH_FPU_H */
\ No newline at end of file
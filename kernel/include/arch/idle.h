@@ -0,0 +1,99 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/idle.h                                                                        |
+// | Name          : x86 Idle States (Header)                                                                          |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares MWAIT-based idle entry, line-write wake-ups and the user UMWAIT/TPAUSE policy.           |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_IDLE_H
+#define _ARCH_IDLE_H
+
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+#define IDLE_MAX_STATES              8
+
+/// Wake-up word that an idle CPU monitors. It is embedded in a cache line that wakers write anyway (the scheduler's
+/// remote line), so waking a CPU sleeping in MWAIT is one store to a line already held exclusive, and no IPI.
+struct idle_line {
+    uint32_t wake;                      ///< set by a waker; the idle CPU sleeps only while this is zero
+    uint32_t polling;                   ///< set while the owner is armed in MONITOR/MWAIT on this line
+};
+
+/// One MWAIT C-state, with the minimum expected idle time for which entering it saves energy.
+struct idle_state {
+    uint32_t hint;                      ///< MWAIT EAX hint
+    uint32_t residency_ns;
+    uint64_t residency_tsc;
+};
+
+/// System-wide idle configuration, fixed by idle_init(0) apart from the user wait policy.
+struct idle_config {
+    bool              mwait;            ///< MONITOR/MWAIT usable for idle; otherwise HLT and IPI wake-ups
+    bool              waitpkg;          ///< UMONITOR/UMWAIT/TPAUSE available to user mode
+    uint32_t          nr_states;
+    uint32_t          monitor_line;     ///< largest monitor-line size reported by CPUID leaf 5
+    struct idle_state states[IDLE_MAX_STATES];
+    uint32_t          umwait_control;   ///< IA32_UMWAIT_CONTROL value imposed on user waits
+    uint32_t          umwait_gen;       ///< bumped whenever umwait_control changes
+};
+
+/// Per-CPU residency predictor and counters.
+struct idle_cpu {
+    uint64_t predicted_tsc;             ///< moving average of observed idle periods
+    uint32_t umwait_gen;                ///< generation of the policy last written to this CPU's MSR
+    uint64_t entries[IDLE_MAX_STATES];
+    uint64_t residency_tsc[IDLE_MAX_STATES];
+    uint64_t too_deep[IDLE_MAX_STATES]; ///< exits before the state's target residency had elapsed
+    uint64_t halts;
+} __cacheline_aligned;
+
+extern struct idle_config idle_config;
+extern struct idle_cpu    idle_cpus[CONFIG_MAX_CPUS];
+
+void idle_init(unsigned int cpu);
+void idle_enter(unsigned int cpu, struct idle_line *line);
+bool idle_wake(struct idle_line *line, unsigned int cpu, uint8_t vector);
+int  idle_set_umwait_policy(uint64_t max_ns, bool allow_c02);
+
+/// @fn      static inline void idle_sync_umwait(unsigned int cpu)
+/// @brief   Applies a changed user wait policy to the executing processor.
+///
+/// @details Policy changes are propagated lazily: each CPU compares one read-mostly generation number on its switch
+/// and idle paths and rewrites its own MSR only when the policy has changed.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+static __always_inline void idle_sync_umwait(unsigned int cpu)
+{
+    uint32_t gen = __atomic_load_n(&idle_config.umwait_gen, __ATOMIC_ACQUIRE);
+
+    if (unlikely(idle_cpus[cpu].umwait_gen != gen)) {
+        _wrmsr(IA32_UMWAIT_CONTROL, idle_config.umwait_control);
+        idle_cpus[cpu].umwait_gen = gen;
+    }
+}
+
+#endif /* _ARCH_IDLE_H */
\ No newline at end of file
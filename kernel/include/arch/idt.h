@@ -0,0 +1,98 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/idt.h                                                                         |
+// | Name          : Interrupt Descriptor Table (Header)                                                               |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the prebuilt IDT, its fixed-stride entry stubs and handler table.                        |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_IDT_H
+#define _ARCH_IDT_H
+
+#define IDT_ENTRIES                  256
+#define IDT_STUB_SIZE                16             /* stub for vector v is at idt_stubs + v * IDT_STUB_SIZE */
+
+// Exceptions for which the processor pushes an error code: #DF, #TS, #NP, #SS, #GP, #PF, #AC, #CP, #VC and #SX. The
+// other stubs push a zero in its place, so every handler sees the same frame.
+#define IDT_ERROR_CODE_MASK          0x60227D00
+
+// Gate attributes: present, 64-bit interrupt gate, DPL in bits 14:13, IST slot in bits 2:0.
+#define IDT_GATE_INTERRUPT           0x8E00
+#define IDT_GATE_DPL_USER            0x6000
+
+// Layout of struct idt_frame, in bytes, for the entry stubs.
+#define IDT_FRAME_VECTOR             120
+#define IDT_FRAME_CS                 144
+#define IDT_FRAME_SIZE               176
+
+#ifndef __ASSEMBLER__
+
+#include "arch/struct.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+/// Registers saved on every interrupt and exception: the general-purpose registers, the vector and error code pushed
+/// by the stub (zero for vectors without one), then the hardware interrupt frame.
+struct idt_frame {
+    uint64_t r15;
+    uint64_t r14;
+    uint64_t r13;
+    uint64_t r12;
+    uint64_t r11;
+    uint64_t r10;
+    uint64_t r9;
+    uint64_t r8;
+    uint64_t rbp;
+    uint64_t rdi;
+    uint64_t rsi;
+    uint64_t rdx;
+    uint64_t rcx;
+    uint64_t rbx;
+    uint64_t rax;
+    uint64_t vector;
+    uint64_t error;
+    uint64_t rip;
+    uint64_t cs;
+    uint64_t rflags;
+    uint64_t rsp;
+    uint64_t ss;
+};
+
+_Static_assert(offsetof(struct idt_frame, vector) == IDT_FRAME_VECTOR, "IDT_FRAME_VECTOR");
+_Static_assert(offsetof(struct idt_frame, cs) == IDT_FRAME_CS, "IDT_FRAME_CS");
+_Static_assert(sizeof(struct idt_frame) == IDT_FRAME_SIZE, "IDT_FRAME_SIZE");
+
+typedef void (*idt_handler_fn)(struct idt_frame *frame);
+
+/// idt_fault_frames holds the frame of the last fatal kernel exception on each processor, for post-mortem inspection.
+
+extern struct idt_gate      idt_table[IDT_ENTRIES];
+extern struct idt_frame     idt_fault_frames[CONFIG_MAX_CPUS];
+extern const idt_handler_fn idt_handlers[IDT_ENTRIES];
+extern const uint8_t        idt_stubs[IDT_ENTRIES * IDT_STUB_SIZE];
+
+void idt_init(void);
+void idt_load(void);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _ARCH_IDT_H */
\ No newline at end of file
@@ -7,7 +7,7 @@
 // | Version       : 0.0.0                                                                                             |
 // | License       : GNU General Public License (GPL), version 3.0                                                     |
 // | Date Created  : June 20, 2024                                                                                     |
-// | Date Modified : June 20, 2024                                                                                     |
+// | Date Modified : October 18, 2026                                                                                  |
 // | Description   : Provides inline C functions which expose specialized x86 and x86-64 instructions.                 |
 // +-------------------------------------------------------------------------------------------------------------------+
 // | Copyright (C) 2024 Elijah Creed Fedele                                                                            |
@@ -27,22 +27,665 @@
 #ifndef _ARCH_INST_H
 #define _ARCH_INST_H
 
+#include "sys/cdefs.h"
 #include "sys/freestd.h"
 
-inline void     _cpuid(uint32_t *eax, uint32_t *ebx, uint32_t *ecx, uint32_t *edx);
-inline uint8_t  _inb  (uint16_t port);
-inline uint16_t _inw  (uint16_t port);
-inline uint32_t _inl  (uint16_t port);
-inline void     _int  (uint8_t  vec);
-inline void     _lgdt (void *loc);
-inline void     _lidt (void *loc);
-inline void     _outb (uint16_t port, uint8_t  value);
-inline void     _outw (uint16_t port, uint16_t value);
-inline void     _outl (uint16_t port, uint32_t value);
-inline uint64_t _rdmsr(uint32_t msr);
-inline uint64_t _rdtsc(void);
-inline void     _sgdt (void *tab);
-inline void     _sidt (void *tab);
-inline void     _wrmsr(uint32_t msr, uint64_t value);
-
-#endif /* _ARCH_INST_H */
\ No newline at end of file
+// Every wrapper except _int_indirect is defined here as a static, always-inlined function so that callers in any
+// translation unit receive the bare instruction rather than a call to a one-instruction body. The runtime INT path
+// remains out of line because INT possesses only an imm8 encoding (see kernel/src/arch/inst.c).
+
+/// @fn      static inline void _cli(void)
+/// @brief   C function exposing the x86 CLI (clear interrupt flag) instruction.
+///
+/// @details Masks maskable external interrupts on the executing processor. NMIs and exceptions are unaffected.
+///
+/// @returns None (void)
+static __always_inline void _cli(void)
+{
+    asm volatile ("cli" : : : "memory");
+}
+
+/// @fn      static inline void _clts(void)
+/// @brief   C function exposing the x86 CLTS (clear task-switched flag) instruction.
+///
+/// @details Clears CR0.TS without a full CR0 read-modify-write, re-enabling x87/SSE/AVX instructions after a #NM.
+///
+/// @returns None (void)
+static __always_inline void _clts(void)
+{
+    asm volatile ("clts" : : : "memory");
+}
+
+/// @fn      static inline void _cpuid(uint32_t *eax, uint32_t *ebx, uint32_t *ecx, uint32_t *edx)
+/// @brief   C function exposing the x86 CPUID (CPU identification) instruction.
+///
+/// @details This function exposes the x86/x86-64 CPUID instruction used to identify late-80486 and post-80486 x86
+/// processors. Depending on the arguments passed via the register references, CPUID will return information regarding
+/// the CPU family, model, stepping, feature set, and hardware capabilities. For a comprehensive discussion of CPUID 
+/// features and semantics, it is recommended to consult the Intel SDM as well as the Intel AN-485 application note.
+/// 
+/// @param   eax a pointer to the value provided in the EAX register
+/// @param   ebx a pointer to the value provided in the EBX register
+/// @param   ecx a pointer to the value provided in the ECX register
+/// @param   edx a pointer to the value provided in the EDX register
+/// @returns None (void) - the four-GPR state post-CPUID is returned in the input argument references
+static __always_inline void _cpuid(uint32_t *eax, uint32_t *ebx, uint32_t *ecx, uint32_t *edx)
+{
+    uint32_t a = *eax, b = *ebx, c = *ecx, d = *edx;
+    asm volatile (
+        "cpuid"
+        : "+a" (a), "+b" (b), "+c" (c), "+d" (d)
+        :
+        : "memory"
+    );
+    *eax = a; *ebx = b; *ecx = c; *edx = d;
+}
+
+/// @fn      static inline void _fxrstor(const void *area)
+/// @brief   C function exposing the x86-64 FXRSTOR64 instruction.
+///
+/// @param   area a 16-byte aligned, 512-byte legacy save area
+/// @returns None (void)
+static __always_inline void _fxrstor(const void *area)
+{
+    asm volatile ("fxrstor64 (%0)" : : "r" (area) : "memory");
+}
+
+/// @fn      static inline void _fxsave(void *area)
+/// @brief   C function exposing the x86-64 FXSAVE64 instruction.
+///
+/// @param   area a 16-byte aligned, 512-byte legacy save area
+/// @returns None (void)
+static __always_inline void _fxsave(void *area)
+{
+    asm volatile ("fxsave64 (%0)" : : "r" (area) : "memory");
+}
+
+/// @fn      static inline void _hlt(void)
+/// @brief   C function exposing the x86 HLT (halt) instruction.
+///
+/// @details Stops instruction execution until the next interrupt, NMI or reset. With interrupts masked only an NMI or
+/// SMI resumes execution; to idle until any interrupt, use _sti_hlt().
+///
+/// @returns None (void)
+static __always_inline void _hlt(void)
+{
+    asm volatile ("hlt" : : : "memory");
+}
+
+/// @fn      static inline uint8_t _inb(uint16_t port)
+/// @brief   C function exposing the x86 IN (read byte from I/O port) instruction.
+///
+/// @details This function exposes the 8-bit form of the x86 IN (read byte from I/O port) instruction. Execution of 
+/// this function reads an unsigned 8-bit value over the I/O bus from the port address specified. Port addresses, in
+/// keeping with x86 I/O conventions, are always 16-bit, regardless of the return operand size.
+/// 
+/// @param   port the I/O port address to read from
+/// @returns the unsigned 8-bit value of the register occupying the specified I/O address
+static __always_inline uint8_t _inb(uint16_t port)
+{
+    uint8_t ret;
+    asm volatile ("inb %1, %0" : "=a" (ret) : "Nd" (port) : "memory");
+    return ret;
+}
+
+/// @fn      static inline uint16_t _inw(uint16_t port)
+/// @brief   C function exposing the x86 IN (read word from I/O port) instruction.
+///
+/// @details This function exposes the 16-bit form of the x86 IN (read word from I/O port) instruction. Execution of 
+/// this function reads an unsigned 16-bit value over the I/O bus from the port address specified. Port addresses, in
+/// keeping with x86 I/O conventions, are always 16-bit, regardless of the return operand size.
+/// 
+/// @param   port the I/O port address to read from
+/// @returns the unsigned 16-bit value of the register occupying the specified I/O address
+static __always_inline uint16_t _inw(uint16_t port)
+{
+    uint16_t ret;
+    asm volatile ("inw %1, %0" : "=a" (ret) : "Nd" (port) : "memory");
+    return ret;
+}
+
+/// @fn      static inline uint32_t _inl(uint16_t port)
+/// @brief   C function exposing the x86 IN (read doubleword from I/O port) instruction.
+///
+/// @details This function exposes the 32-bit form of the x86 IN (read doubleword from I/O port) instruction. Execution 
+/// of this function reads an unsigned 32-bit value over the I/O bus from the port address specified. Port addresses, in
+/// keeping with x86 I/O conventions, are always 16-bit, regardless of the return operand size.
+/// 
+/// @param   port the I/O port address to read from
+/// @returns the unsigned 32-bit value of the register occupying the specified I/O address
+static __always_inline uint32_t _inl(uint16_t port)
+{
+    uint32_t ret;
+    asm volatile ("inl %1, %0" : "=a" (ret) : "Nd" (port) : "memory");
+    return ret;
+}
+
+/// @fn      void _int_indirect(uint8_t vec)
+/// @brief   C function asserting an interrupt whose vector is only known at run time.
+///
+/// @details Defined out of line in kernel/src/arch/inst.c; see the definition for details. Callers should use the _int
+/// macro, which selects this path only when the vector is not a compile-time constant.
+///
+/// @param   vec the interrupt vector (number) to assert
+/// @returns None (void)
+void _int_indirect(uint8_t vec);
+
+/// @def     _int(vec)
+/// @brief   Macro exposing the x86 INT (assert interrupt) instruction.
+///
+/// @details INT possesses only an imm8 encoding. When the vector is an integer constant expression, the macro expands
+/// to a single inline INT imm8 with no call or branch. Otherwise it falls back to _int_indirect, which jumps into a
+/// fixed-stride table of INT thunks. Both paths emit the CD ib bytes directly, since the assembler encodes "int $3" as
+/// the one-byte INT3, which is not equivalent.
+///
+/// @param   vec the interrupt vector (number) to assert
+/// @returns None (void)
+#define _int(vec)                                                                                                      \
+    __builtin_choose_expr(__builtin_constant_p(vec),                                                                   \
+                          ({ asm volatile (".byte 0xCD, %c0" : : "i" ((uint8_t) (vec)) : "memory"); }),               \
+                          _int_indirect(vec))
+
+/// @fn      static inline void _invlpg(const void *addr)
+/// @brief   C function exposing the x86 INVLPG (invalidate TLB entries for a page) instruction.
+///
+/// @details Invalidates the translations for the page containing addr in the current PCID, including a global entry
+/// and the whole of a large page, plus paging-structure caches in every PCID.
+///
+/// @param   addr any linear address within the page to invalidate
+/// @returns None (void)
+static __always_inline void _invlpg(const void *addr)
+{
+    asm volatile ("invlpg (%0)" : : "r" (addr) : "memory");
+}
+
+/// @fn      static inline void _invpcid(uint64_t type, uint16_t pcid, uint64_t addr)
+/// @brief   C function exposing the x86 INVPCID (invalidate process-context identifier) instruction.
+///
+/// @details Unlike INVLPG, INVPCID can target a PCID other than the current one, and can drop all of a PCID's
+/// translations without reloading CR3. Requires CPU_FEATURE_INVPCID.
+///
+/// @param   type the invalidation type (INVPCID_* in arch/paging.h)
+/// @param   pcid the process-context identifier, used by the address and single-context types
+/// @param   addr the linear address, used by the address type
+/// @returns None (void)
+static __always_inline void _invpcid(uint64_t type, uint16_t pcid, uint64_t addr)
+{
+    struct { uint64_t pcid; uint64_t addr; } desc = { pcid, addr };
+    asm volatile ("invpcid %1, %0" : : "r" (type), "m" (desc) : "memory");
+}
+
+/// @fn      static inline void _lfence(void)
+/// @brief   C function exposing the x86 LFENCE (load fence) instruction.
+///
+/// @details This function exposes the x86 LFENCE instruction. Besides ordering loads, LFENCE does not complete until
+/// all prior instructions have completed locally, so placing it before RDTSC keeps the counter read from executing
+/// ahead of earlier loads.
+///
+/// @returns None (void)
+static __always_inline void _lfence(void)
+{
+    asm volatile ("lfence" : : : "memory");
+}
+
+/// @fn      static inline void _lgdt(void *loc)
+/// @brief   C function exposing the x86 LGDT (load global descriptor table register) instruction.
+///
+/// @details This function exposes the x86-64 LGDT instruction, which loads the GDTR from the 10-byte pseudo-descriptor
+/// (16-bit limit followed by 64-bit linear base) at the address given. Segment registers are not reloaded; callers
+/// that change the layout of the active GDT must reload them separately.
+///
+/// @param   loc a pointer to the pseudo-descriptor describing the new GDT
+/// @returns None (void)
+static __always_inline void _lgdt(void *loc)
+{
+    asm volatile ("lgdt (%0)" : : "r" (loc) : "memory");
+}
+
+/// @fn      static inline void _lidt(void *loc)
+/// @brief   C function exposing the x86 LIDT (load interrupt descriptor table register) instruction.
+///
+/// @details This function exposes the x86-64 LIDT instruction, which loads the IDTR from the 10-byte pseudo-descriptor
+/// (16-bit limit followed by 64-bit linear base) at the address given.
+///
+/// @param   loc a pointer to the pseudo-descriptor describing the new IDT
+/// @returns None (void)
+static __always_inline void _lidt(void *loc)
+{
+    asm volatile ("lidt (%0)" : : "r" (loc) : "memory");
+}
+
+/// @fn      static inline void _ltr(uint16_t sel)
+/// @brief   C function exposing the x86 LTR (load task register) instruction.
+///
+/// @details This function exposes the x86-64 LTR instruction, which loads the task register from the TSS descriptor
+/// selected in the current GDT and marks that descriptor busy. Loading the same selector twice raises #GP.
+///
+/// @param   sel the segment selector of an available TSS descriptor
+/// @returns None (void)
+static __always_inline void _ltr(uint16_t sel)
+{
+    asm volatile ("ltr %0" : : "rm" (sel) : "memory");
+}
+
+/// @fn      static inline void _monitor(const volatile void *addr, uint32_t ext, uint32_t hints)
+/// @brief   C function exposing the x86 MONITOR instruction.
+///
+/// @details Arms address-range monitoring on the line containing addr. A subsequent MWAIT wakes when any processor
+/// writes to that range, or on an interrupt or other break event.
+///
+/// @param   addr  any address within the range to monitor
+/// @param   ext   extensions (ECX); must be zero on current processors
+/// @param   hints hints (EDX); must be zero on current processors
+/// @returns None (void)
+static __always_inline void _monitor(const volatile void *addr, uint32_t ext, uint32_t hints)
+{
+    asm volatile ("monitor" : : "a" (addr), "c" (ext), "d" (hints) : "memory");
+}
+
+/// @fn      static inline void _outb(uint16_t port, uint8_t value)
+/// @brief   C function exposing the x86 OUT (write byte to I/O port) instruction.
+///
+/// @details This function exposes the 8-bit form of the x86 OUT (write byte to I/O port) instruction. Execution of 
+/// this function writes an unsigned 8-bit value over the I/O bus to the port address specified.
+///
+/// @param   port  the I/O port address to write to
+/// @param   value the unsigned 8-bit value to write
+/// @returns None (void)
+static __always_inline void _outb(uint16_t port, uint8_t value)
+{
+    asm volatile ("outb %0, %1" : : "a" (value), "Nd" (port) : "memory");
+}
+
+/// @fn      static inline void _outw(uint16_t port, uint16_t value)
+/// @brief   C function exposing the x86 OUT (write word to I/O port) instruction.
+///
+/// @details This function exposes the 16-bit form of the x86 OUT (write word to I/O port) instruction. Execution of 
+/// this function writes an unsigned 16-bit value over the I/O bus to the port address specified.
+///
+/// @param   port  the I/O port address to write to
+/// @param   value the unsigned 16-bit value to write
+/// @returns None (void)
+static __always_inline void _outw(uint16_t port, uint16_t value)
+{
+    asm volatile ("outw %0, %1" : : "a" (value), "Nd" (port) : "memory");
+}
+
+/// @fn      static inline void _outl(uint16_t port, uint32_t value)
+/// @brief   C function exposing the x86 OUT (write doubleword to I/O port) instruction.
+///
+/// @details This function exposes the 32-bit form of the x86 OUT (write doubleword to I/O port) instruction. Execution
+/// of this function writes an unsigned 32-bit value over the I/O bus to the port address specified.
+///
+/// @param   port  the I/O port address to write to
+/// @param   value the unsigned 32-bit value to write
+/// @returns None (void)
+static __always_inline void _outl(uint16_t port, uint32_t value)
+{
+    asm volatile ("outl %0, %1" : : "a" (value), "Nd" (port) : "memory");
+}
+
+/// @fn      static inline void _pause(void)
+/// @brief   C function exposing the x86 PAUSE (spin-loop hint) instruction.
+///
+/// @details This function exposes the x86 PAUSE instruction, which tells the processor that the caller is in a
+/// spin-wait loop. It avoids the memory-order mis-speculation penalty on loop exit and yields pipeline resources to the
+/// sibling hyperthread. The memory clobber forces polled variables to be reloaded on every iteration.
+///
+/// @returns None (void)
+static __always_inline void _pause(void)
+{
+    asm volatile ("pause" : : : "memory");
+}
+
+/// @fn      static inline uint64_t _rdcr0(void)
+/// @brief   C function reading control register CR0.
+///
+/// @returns the 64-bit contents of CR0
+static __always_inline uint64_t _rdcr0(void)
+{
+    uint64_t ret;
+    asm volatile ("mov %%cr0, %0" : "=r" (ret));
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdcr3(void)
+/// @brief   C function reading control register CR3.
+///
+/// @returns the 64-bit contents of CR3 (top-level page table address and PCID)
+static __always_inline uint64_t _rdcr3(void)
+{
+    uint64_t ret;
+    asm volatile ("mov %%cr3, %0" : "=r" (ret));
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdcr4(void)
+/// @brief   C function reading control register CR4.
+///
+/// @details CR4 bit definitions are listed in arch/cr.h.
+///
+/// @returns the 64-bit contents of CR4
+static __always_inline uint64_t _rdcr4(void)
+{
+    uint64_t ret;
+    asm volatile ("mov %%cr4, %0" : "=r" (ret));
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdflags(void)
+/// @brief   C function reading the RFLAGS register.
+///
+/// @returns the 64-bit contents of RFLAGS
+static __always_inline uint64_t _rdflags(void)
+{
+    uint64_t ret;
+    asm volatile ("pushfq; popq %0" : "=r" (ret) : : "memory");
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdfsbase(void)
+/// @brief   C function exposing the x86 RDFSBASE instruction.
+///
+/// @details Reads the FS segment base without an RDMSR. Requires CR4.FSGSBASE, otherwise it raises #UD.
+///
+/// @returns the FS base
+static __always_inline uint64_t _rdfsbase(void)
+{
+    uint64_t ret;
+    asm volatile ("rdfsbase %0" : "=r" (ret));
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdgsbase(void)
+/// @brief   C function exposing the x86 RDGSBASE instruction.
+///
+/// @details Reads the active GS segment base without an RDMSR. Requires CR4.FSGSBASE, otherwise it raises #UD.
+///
+/// @returns the GS base
+static __always_inline uint64_t _rdgsbase(void)
+{
+    uint64_t ret;
+    asm volatile ("rdgsbase %0" : "=r" (ret));
+    return ret;
+}
+
+/// @fn      static inline uint64_t _rdmsr(uint32_t msr)
+/// @brief   C function exposing the x86 RDMSR (read model-specific register) instruction.
+///
+/// @details This function exposes the x86 RDMSR instruction, which reads the 64-bit model-specific register addressed
+/// by ECX into EDX:EAX. Addresses are listed in arch/msr.h. Reading an unimplemented MSR raises #GP(0).
+///
+/// @param   msr the address of the model-specific register to read
+/// @returns the 64-bit contents of the model-specific register
+static __always_inline uint64_t _rdmsr(uint32_t msr)
+{
+    uint32_t lo, hi;
+    asm volatile ("rdmsr" : "=a" (lo), "=d" (hi) : "c" (msr));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+/// @fn      static inline uint64_t _rdpmc(uint32_t counter)
+/// @brief   C function exposing the x86 RDPMC (read performance-monitoring counter) instruction.
+///
+/// @details This function exposes the x86 RDPMC instruction, which reads the performance counter selected by ECX:
+/// general-purpose counter n for ECX = n, and fixed-function counter n for ECX = (1 << 30) | n. Unlike RDMSR it may be
+/// executed at CPL 3 when CR4.PCE is set. The value is not masked to the counter width.
+///
+/// @param   counter the counter selector
+/// @returns the contents of the selected counter
+static __always_inline uint64_t _rdpmc(uint32_t counter)
+{
+    uint32_t lo, hi;
+    asm volatile ("rdpmc" : "=a" (lo), "=d" (hi) : "c" (counter));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+/// @fn      static inline uint64_t _rdtsc(void)
+/// @brief   C function exposing the x86 RDTSC (read time-stamp counter) instruction.
+///
+/// @details This function exposes the x86 RDTSC instruction, which returns the 64-bit processor time-stamp counter.
+/// RDTSC is not serializing and may execute ahead of preceding instructions; no memory barrier is implied so that the
+/// compiler remains free to schedule around it.
+///
+/// @returns the current value of the time-stamp counter
+static __always_inline uint64_t _rdtsc(void)
+{
+    uint32_t lo, hi;
+    asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+/// @fn      static inline void _sgdt(void *tab)
+/// @brief   C function exposing the x86 SGDT (store global descriptor table register) instruction.
+///
+/// @details This function exposes the x86-64 SGDT instruction, which stores the current GDTR as a 10-byte
+/// pseudo-descriptor (16-bit limit followed by 64-bit linear base) at the address given.
+///
+/// @param   tab a pointer to a 10-byte buffer receiving the pseudo-descriptor
+/// @returns None (void)
+static __always_inline void _sgdt(void *tab)
+{
+    asm volatile ("sgdt (%0)" : : "r" (tab) : "memory");
+}
+
+/// @fn      static inline void _sidt(void *tab)
+/// @brief   C function exposing the x86 SIDT (store interrupt descriptor table register) instruction.
+///
+/// @details This function exposes the x86-64 SIDT instruction, which stores the current IDTR as a 10-byte
+/// pseudo-descriptor (16-bit limit followed by 64-bit linear base) at the address given.
+///
+/// @param   tab a pointer to a 10-byte buffer receiving the pseudo-descriptor
+/// @returns None (void)
+static __always_inline void _sidt(void *tab)
+{
+    asm volatile ("sidt (%0)" : : "r" (tab) : "memory");
+}
+
+/// @fn      static inline void _sti(void)
+/// @brief   C function exposing the x86 STI (set interrupt flag) instruction.
+///
+/// @details Unmasks maskable external interrupts. Recognition is delayed until after the following instruction.
+///
+/// @returns None (void)
+static __always_inline void _sti(void)
+{
+    asm volatile ("sti" : : : "memory");
+}
+
+/// @fn      static inline void _sti_hlt(void)
+/// @brief   Unmasks interrupts and halts as one uninterruptible pair.
+///
+/// @details STI delays interrupt recognition by one instruction, so an interrupt that becomes pending after the caller
+/// last checked for work cannot be taken between STI and HLT; it instead wakes the processor out of HLT. This closes
+/// the lost-wakeup window that separate _sti() and _hlt() calls would leave open.
+///
+/// @returns None (void)
+static __always_inline void _sti_hlt(void)
+{
+    asm volatile ("sti; hlt" : : : "memory");
+}
+
+/// @fn      static inline void _sti_mwait(uint32_t hint, uint32_t ext)
+/// @brief   Unmasks interrupts and executes MWAIT as one uninterruptible pair.
+///
+/// @details The STI shadow covers MWAIT, so an interrupt that became pending after the caller's last check is taken as
+/// a break event rather than lost; the processor then handles it immediately after waking.
+///
+/// @param   hint the target C-state (EAX bits 7:4) and sub-state (bits 3:0)
+/// @param   ext  MWAIT extensions (ECX)
+/// @returns None (void)
+static __always_inline void _sti_mwait(uint32_t hint, uint32_t ext)
+{
+    asm volatile ("sti; mwait" : : "a" (hint), "c" (ext) : "memory");
+}
+
+/// @fn      static inline void _swapgs(void)
+/// @brief   C function exposing the x86 SWAPGS instruction.
+///
+/// @details Exchanges the GS base with IA32_KERNEL_GS_BASE. Every gs-relative access, including this_cpu_read(),
+/// reaches the wrong block until the matching SWAPGS, so callers keep interrupts disabled and touch nothing between.
+///
+/// @returns None (void)
+static __always_inline void _swapgs(void)
+{
+    asm volatile ("swapgs" : : : "memory");
+}
+
+/// @fn      static inline void _wrcr0(uint64_t value)
+/// @brief   C function writing control register CR0.
+///
+/// @param   value the new contents of CR0
+/// @returns None (void)
+static __always_inline void _wrcr0(uint64_t value)
+{
+    asm volatile ("mov %0, %%cr0" : : "r" (value) : "memory");
+}
+
+/// @fn      static inline void _wrcr3(uint64_t value)
+/// @brief   C function writing control register CR3.
+///
+/// @details With CR4.PCIDE set, bit 63 (CR3_NOFLUSH) keeps the TLB entries tagged with the new PCID; otherwise the
+/// write invalidates all non-global translations of that PCID.
+///
+/// @param   value the new contents of CR3
+/// @returns None (void)
+static __always_inline void _wrcr3(uint64_t value)
+{
+    asm volatile ("mov %0, %%cr3" : : "r" (value) : "memory");
+}
+
+/// @fn      static inline void _wrcr4(uint64_t value)
+/// @brief   C function writing control register CR4.
+///
+/// @param   value the new contents of CR4
+/// @returns None (void)
+static __always_inline void _wrcr4(uint64_t value)
+{
+    asm volatile ("mov %0, %%cr4" : : "r" (value) : "memory");
+}
+
+/// @fn      static inline void _wrfsbase(uint64_t value)
+/// @brief   C function exposing the x86 WRFSBASE instruction.
+///
+/// @details Writes the FS segment base. Unlike WRMSR it is not serializing. Requires CR4.FSGSBASE.
+///
+/// @param   value the new FS base, canonical
+/// @returns None (void)
+static __always_inline void _wrfsbase(uint64_t value)
+{
+    asm volatile ("wrfsbase %0" : : "r" (value) : "memory");
+}
+
+/// @fn      static inline void _wrgsbase(uint64_t value)
+/// @brief   C function exposing the x86 WRGSBASE instruction.
+///
+/// @details Writes the active GS segment base. Unlike WRMSR it is not serializing. Requires CR4.FSGSBASE.
+///
+/// @param   value the new GS base, canonical
+/// @returns None (void)
+static __always_inline void _wrgsbase(uint64_t value)
+{
+    asm volatile ("wrgsbase %0" : : "r" (value) : "memory");
+}
+
+/// @fn      static inline void _wrmsr(uint32_t msr, uint64_t value)
+/// @brief   C function exposing the x86 WRMSR (write model-specific register) instruction.
+///
+/// @details This function exposes the x86 WRMSR instruction, which writes EDX:EAX to the 64-bit model-specific register
+/// addressed by ECX. Because many MSRs alter how subsequent memory accesses behave (segment bases, speculation
+/// controls, memory types), the write also acts as a compiler memory barrier.
+///
+/// @param   msr   the address of the model-specific register to write
+/// @param   value the 64-bit value to write
+/// @returns None (void)
+static __always_inline void _wrmsr(uint32_t msr, uint64_t value)
+{
+    asm volatile ("wrmsr" : : "c" (msr), "a" ((uint32_t) value), "d" ((uint32_t) (value >> 32)) : "memory");
+}
+
+/// @fn      static inline uint64_t _xgetbv(uint32_t xcr)
+/// @brief   C function exposing the x86 XGETBV (get extended control register) instruction.
+///
+/// @param   xcr the extended control register index (0 for XCR0)
+/// @returns the 64-bit contents of the register
+static __always_inline uint64_t _xgetbv(uint32_t xcr)
+{
+    uint32_t lo, hi;
+    asm volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (xcr));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+/// @fn      static inline void _xrstor(const void *area, uint64_t mask)
+/// @brief   C function exposing the x86-64 XRSTOR64 instruction (standard format).
+///
+/// @param   area a 64-byte aligned XSAVE area
+/// @param   mask the requested-feature bitmap; components absent from XSTATE_BV are initialized
+/// @returns None (void)
+static __always_inline void _xrstor(const void *area, uint64_t mask)
+{
+    asm volatile ("xrstor64 (%0)" : : "r" (area), "a" ((uint32_t) mask), "d" ((uint32_t) (mask >> 32)) : "memory");
+}
+
+/// @fn      static inline void _xrstors(const void *area, uint64_t mask)
+/// @brief   C function exposing the x86-64 XRSTORS64 instruction (compacted format, supervisor components).
+///
+/// @param   area a 64-byte aligned XSAVE area written by XSAVES or with a valid compacted header
+/// @param   mask the requested-feature bitmap
+/// @returns None (void)
+static __always_inline void _xrstors(const void *area, uint64_t mask)
+{
+    asm volatile ("xrstors64 (%0)" : : "r" (area), "a" ((uint32_t) mask), "d" ((uint32_t) (mask >> 32)) : "memory");
+}
+
+/// @fn      static inline void _xsave(void *area, uint64_t mask)
+/// @brief   C function exposing the x86-64 XSAVE64 instruction (standard format, no optimizations).
+///
+/// @param   area a 64-byte aligned XSAVE area
+/// @param   mask the requested-feature bitmap
+/// @returns None (void)
+static __always_inline void _xsave(void *area, uint64_t mask)
+{
+    asm volatile ("xsave64 (%0)" : : "r" (area), "a" ((uint32_t) mask), "d" ((uint32_t) (mask >> 32)) : "memory");
+}
+
+/// @fn      static inline void _xsaveopt(void *area, uint64_t mask)
+/// @brief   C function exposing the x86-64 XSAVEOPT64 instruction.
+///
+/// @details Standard format with the init and modified optimizations: components in their initial configuration, and
+/// components unchanged since the last XRSTOR from this same area, are not written.
+///
+/// @param   area a 64-byte aligned XSAVE area
+/// @param   mask the requested-feature bitmap
+/// @returns None (void)
+static __always_inline void _xsaveopt(void *area, uint64_t mask)
+{
+    asm volatile ("xsaveopt64 (%0)" : : "r" (area), "a" ((uint32_t) mask), "d" ((uint32_t) (mask >> 32)) : "memory");
+}
+
+/// @fn      static inline void _xsaves(void *area, uint64_t mask)
+/// @brief   C function exposing the x86-64 XSAVES64 instruction.
+///
+/// @details Compacted format with the init and modified optimizations; also saves supervisor components enabled in
+/// IA32_XSS.
+///
+/// @param   area a 64-byte aligned XSAVE area
+/// @param   mask the requested-feature bitmap
+/// @returns None (void)
+static __always_inline void _xsaves(void *area, uint64_t mask)
+{
+    asm volatile ("xsaves64 (%0)" : : "r" (area), "a" ((uint32_t) mask), "d" ((uint32_t) (mask >> 32)) : "memory");
+}
+
+/// @fn      static inline void _xsetbv(uint32_t xcr, uint64_t value)
+/// @brief   C function exposing the x86 XSETBV (set extended control register) instruction.
+///
+/// @param   xcr   the extended control register index (0 for XCR0)
+/// @param   value the new contents of the register
+/// @returns None (void)
+static __always_inline void _xsetbv(uint32_t xcr, uint64_t value)
+{
+    asm volatile ("xsetbv" : : "c" (xcr), "a" ((uint32_t) value), "d" ((uint32_t) (value >> 32)) : "memory");
+}
+
+#endif /* _ARCH_INST_H */
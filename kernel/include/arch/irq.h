@@ -0,0 +1,58 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/irq.h                                                                         |
+// | Name          : x86 Interrupt Masking                                                                             |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides save/restore helpers for disabling maskable interrupts around critical sections.         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_IRQ_H
+#define _ARCH_IRQ_H
+
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "sys/cdefs.h"
+#include "sys/freestd.h"
+
+/// @fn      static inline uint64_t irq_save(void)
+/// @brief   Disables maskable interrupts on the executing processor and returns the previous RFLAGS.
+///
+/// @returns the RFLAGS value to pass to irq_restore()
+static __always_inline uint64_t irq_save(void)
+{
+    uint64_t flags = _rdflags();
+
+    _cli();
+    return flags;
+}
+
+/// @fn      static inline void irq_restore(uint64_t flags)
+/// @brief   Re-enables maskable interrupts if they were enabled when the matching irq_save() was called.
+///
+/// @param   flags the value returned by irq_save()
+/// @returns None (void)
+static __always_inline void irq_restore(uint64_t flags)
+{
+    if (flags & RFLAGS_IF)
+        _sti();
+}
+
+#endif /* _ARCH_IRQ_H */
\ No newline at end of file
@@ -0,0 +1,46 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/ist.h                                                                         |
+// | Name          : x86 Interrupt Stack Table Assignments (Header)                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the IST slot assignments and the per-CPU stacks that back them.                          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_IST_H
+#define _ARCH_IST_H
+
+// IST slots (1-7) used by IDT gates. Each of these exceptions can arrive while the current stack is unusable or while
+// another handler on the same stack is mid-flight, so each gets a private, known-good stack per CPU.
+#define IST_NMI                      1
+#define IST_DOUBLE_FAULT             2
+#define IST_MACHINE_CHECK            3
+#define IST_COUNT                    3
+
+#ifndef __ASSEMBLER__
+
+#include "arch/struct.h"
+#include "sys/freestd.h"
+
+void ist_install(struct tss_entry *tss, unsigned int cpu);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _ARCH_IST_H */
\ No newline at end of file
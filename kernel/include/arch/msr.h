@@ -7,7 +7,7 @@
 // | Version       : 0.0.0                                                                                             |
 // | License       : GNU General Public License (GPL), version 3.0                                                     |
 // | Date Created  : June 21, 2024                                                                                     |
-// | Date Modified : June 21, 2024                                                                                     |
+// | Date Modified : October 18, 2026                                                                                  |
 // | Description   : Contains definitions of all current x86 and x86-64 model-specific registers (MSRs).               |
 // +-------------------------------------------------------------------------------------------------------------------+
 // | Copyright (C) 2024 Elijah Creed Fedele                                                                            |
@@ -309,4 +309,46 @@
 #define IA32_VMX_EPT_VPID_CAP        0x0000048C
 /* Page 2-41, Intel SDM, Vol. 4 */
 
+#define IA32_TSC_DEADLINE            0x000006E0
+
+#define IA32_PM_ENABLE               0x00000770
+#define IA32_HWP_CAPABILITIES        0x00000771
+#define IA32_HWP_REQUEST             0x00000774
+
+#define IA32_X2APIC_APICID           0x00000802
+#define IA32_X2APIC_VERSION          0x00000803
+#define IA32_X2APIC_TPR              0x00000808
+#define IA32_X2APIC_PPR              0x0000080A
+#define IA32_X2APIC_EOI              0x0000080B
+#define IA32_X2APIC_LDR              0x0000080D
+#define IA32_X2APIC_SIVR             0x0000080F
+#define IA32_X2APIC_ISR0             0x00000810
+#define IA32_X2APIC_TMR0             0x00000818
+#define IA32_X2APIC_IRR0             0x00000820
+#define IA32_X2APIC_ESR              0x00000828
+#define IA32_X2APIC_LVT_CMCI         0x0000082F
+#define IA32_X2APIC_ICR              0x00000830
+#define IA32_X2APIC_LVT_TIMER        0x00000832
+#define IA32_X2APIC_LVT_THERMAL      0x00000833
+#define IA32_X2APIC_LVT_PMI          0x00000834
+#define IA32_X2APIC_LVT_LINT0        0x00000835
+#define IA32_X2APIC_LVT_LINT1        0x00000836
+#define IA32_X2APIC_LVT_ERROR        0x00000837
+#define IA32_X2APIC_INIT_COUNT       0x00000838
+#define IA32_X2APIC_CUR_COUNT        0x00000839
+#define IA32_X2APIC_DIV_CONF         0x0000083E
+#define IA32_X2APIC_SELF_IPI         0x0000083F
+
+#define IA32_XSS                     0x00000DA0
+
+#define IA32_EFER                    0xC0000080
+#define IA32_STAR                    0xC0000081
+#define IA32_LSTAR                   0xC0000082
+#define IA32_CSTAR                   0xC0000083
+#define IA32_FMASK                   0xC0000084
+#define IA32_FS_BASE                 0xC0000100
+#define IA32_GS_BASE                 0xC0000101
+#define IA32_KERNEL_GS_BASE          0xC0000102
+#define IA32_TSC_AUX                 0xC0000103
+
 #endif /* _ARCH_MSR_H */
\ No newline at end of file
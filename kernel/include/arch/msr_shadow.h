@@ -0,0 +1,97 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/msr_shadow.h                                                                  |
+// | Name          : MSR Shadows (Header)                                                                              |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares per-CPU shadows that skip redundant writes to write-mostly MSRs.                         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_MSR_SHADOW_H
+#define _ARCH_MSR_SHADOW_H
+
+#include "arch/percpu.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+/// Shadowed registers. Each is written on context switches or policy changes far more often than its value changes.
+enum msr_slot {
+    MSR_SLOT_SPEC_CTRL,
+    MSR_SLOT_XFD,
+    MSR_SLOT_HWP_REQUEST,
+    MSR_SLOT_PERF_CTL,
+    MSR_SLOT_ENERGY_PERF_BIAS,
+    MSR_SLOT_PERF_GLOBAL_CTRL,
+    MSR_SLOT_FIXED_CTR_CTRL,
+    MSR_SLOT_FS_BASE,
+    MSR_SLOT_USER_GS_BASE,              ///< IA32_KERNEL_GS_BASE while in the kernel, swapped in on return to user mode
+    MSR_SLOT_COUNT
+};
+
+/// Write counters of one slot: hits are writes skipped because the register already held the value, or deferred
+/// values replaced before they were applied; misses are writes that reached the hardware.
+struct msr_slot_stats {
+    uint64_t hits;
+    uint64_t misses;
+};
+
+/// Per-CPU shadow state, private to its owner and used with interrupts disabled.
+struct msr_shadow_cpu {
+    uint32_t              valid;                        ///< slots whose value[] is known to match the register
+    uint32_t              pending;                      ///< slots with a deferred value waiting for msr_shadow_apply()
+    uint64_t              value[MSR_SLOT_COUNT];
+    uint64_t              deferred[MSR_SLOT_COUNT];
+    struct msr_slot_stats stats[MSR_SLOT_COUNT];
+} __cacheline_aligned;
+
+extern struct msr_shadow_cpu msr_shadow_cpus[CONFIG_MAX_CPUS];
+extern bool                  msr_fsgsbase;
+
+void msr_shadow_init_cpu(unsigned int cpu);
+void msr_write_through(struct msr_shadow_cpu *sc, enum msr_slot slot, uint64_t value);
+uint64_t msr_read_base(enum msr_slot slot);
+void msr_write_deferred(enum msr_slot slot, uint64_t value);
+void msr_shadow_sync(enum msr_slot slot, uint64_t value);
+void msr_shadow_apply(void);
+
+/// @fn      static inline void msr_write(enum msr_slot slot, uint64_t value)
+/// @brief   Writes a shadowed register now, unless it already holds the value.
+///
+/// @details A write that matches the shadow costs a compare instead of a serializing WRMSR, or a VM exit under a
+/// hypervisor. It also cancels a deferred value for the slot. Called with interrupts disabled.
+///
+/// @param   slot  the register
+/// @param   value the value
+/// @returns None (void)
+static __always_inline void msr_write(enum msr_slot slot, uint64_t value)
+{
+    struct msr_shadow_cpu *sc  = &msr_shadow_cpus[this_cpu_read(cpu)];
+    uint32_t               bit = 1u << slot;
+
+    sc->pending &= ~bit;
+    if ((sc->valid & bit) && sc->value[slot] == value) {
+        sc->stats[slot].hits++;
+        return;
+    }
+    msr_write_through(sc, slot, value);
+}
+
+#endif /* _ARCH_MSR_SHADOW_H */
\ No newline at end of file
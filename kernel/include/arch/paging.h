@@ -0,0 +1,57 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/paging.h                                                                      |
+// | Name          : x86 Paging Structure Definitions                                                                  |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Contains definitions of the page-table entry bits and the INVPCID invalidation types.             |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_PAGING_H
+#define _ARCH_PAGING_H
+
+#define PTE_P                        (1ULL << 0)
+#define PTE_W                        (1ULL << 1)
+#define PTE_U                        (1ULL << 2)
+#define PTE_PWT                      (1ULL << 3)
+#define PTE_PCD                      (1ULL << 4)
+#define PTE_A                        (1ULL << 5)
+#define PTE_D                        (1ULL << 6)
+#define PTE_PS                       (1ULL << 7)    /* in a PDPTE or PDE: maps a 1 GiB or 2 MiB page */
+#define PTE_G                        (1ULL << 8)
+#define PTE_NX                       (1ULL << 63)
+#define PTE_ADDR                     0x000FFFFFFFFFF000ULL
+
+// Entries per table and the levels of the hierarchy, numbered from the leaf. Level 5 exists only with CR4.LA57.
+#define PT_ENTRIES                   512
+#define PT_LEVEL_PT                  1
+#define PT_LEVEL_PD                  2
+#define PT_LEVEL_PDPT                3
+#define PT_LEVEL_PML4                4
+#define PT_LEVEL_PML5                5
+#define PT_SHIFT(level)              (12 + 9 * ((level) - 1))
+#define PT_INDEX(va, level)          (((va) >> PT_SHIFT(level)) & (PT_ENTRIES - 1))
+
+#define INVPCID_ADDRESS              0              /* one address in one PCID */
+#define INVPCID_SINGLE               1              /* all non-global entries of one PCID */
+#define INVPCID_ALL_GLOBAL           2              /* everything, global entries included */
+#define INVPCID_ALL                  3              /* all non-global entries of every PCID */
+
+#endif /* _ARCH_PAGING_H */
\ No newline at end of file
@@ -0,0 +1,104 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/percpu.h                                                                      |
+// | Name          : x86 Per-CPU Data Block (Header)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the per-CPU data block addressed through the GS segment base.                            |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_PERCPU_H
+#define _ARCH_PERCPU_H
+
+// Offsets of the fields used by assembly entry code. Checked against the structure layout below.
+#define PERCPU_SELF                  0
+#define PERCPU_KERNEL_RSP            8
+#define PERCPU_USER_RSP              16
+#define PERCPU_CPU                   24
+#define PERCPU_INTERRUPTS            56
+#define PERCPU_SIZE_SHIFT            8              /* sizeof(struct percpu) == 1 << PERCPU_SIZE_SHIFT */
+
+#ifndef __ASSEMBLER__
+
+#include "arch/segment.h"
+#include "arch/struct.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+/// Per-CPU data. While in the kernel, GS base points at the executing processor's instance (user GS base is parked
+/// in IA32_KERNEL_GS_BASE by SWAPGS), so any field is one gs-relative load away and no code needs to derive the CPU
+/// index from the APIC ID. Each instance starts on its own cache line, and the descriptor tables, which are written
+/// only at bring-up, are kept off the line holding the frequently written fields.
+struct percpu {
+    struct percpu   *self;
+    uint64_t         kernel_rsp;        ///< stack loaded on SYSCALL entry (mirrored in tss.stack_ptr_0)
+    uint64_t         user_rsp;          ///< user RSP saved by the SYSCALL entry stub
+    uint32_t         cpu;               ///< logical CPU index
+    uint32_t         apic_id;
+    void            *current;           ///< thread running on this CPU
+    void            *runqueue;          ///< this CPU's run queue
+    uint64_t         syscalls;
+    uint64_t         interrupts;
+
+    uint64_t         gdt[GDT_ENTRIES] __cacheline_aligned;
+    struct tss_entry tss __cacheline_aligned;
+} __cacheline_aligned;
+
+_Static_assert(offsetof(struct percpu, self)       == PERCPU_SELF,       "PERCPU_SELF");
+_Static_assert(offsetof(struct percpu, kernel_rsp) == PERCPU_KERNEL_RSP, "PERCPU_KERNEL_RSP");
+_Static_assert(offsetof(struct percpu, user_rsp)   == PERCPU_USER_RSP,   "PERCPU_USER_RSP");
+_Static_assert(offsetof(struct percpu, cpu)        == PERCPU_CPU,        "PERCPU_CPU");
+_Static_assert(offsetof(struct percpu, interrupts) == PERCPU_INTERRUPTS, "PERCPU_INTERRUPTS");
+_Static_assert(sizeof(struct percpu)               == 1 << PERCPU_SIZE_SHIFT, "PERCPU_SIZE_SHIFT");
+
+extern struct percpu percpu[CONFIG_MAX_CPUS];
+
+void percpu_init(unsigned int cpu);
+
+// Accessors for fields of the executing processor's block. They compile to a single gs-relative MOV/ADD, with no
+// address computation and no dependency on the self pointer.
+#define __percpu_field(field)        (*(__seg_gs __typeof__(((struct percpu *) 0)->field) *) \
+                                      offsetof(struct percpu, field))
+#define this_cpu_read(field)         (__percpu_field(field))
+#define this_cpu_write(field, val)   (__percpu_field(field) = (val))
+#define this_cpu_add(field, val)     (__percpu_field(field) += (val))
+
+/// @fn      static inline struct percpu *this_cpu(void)
+/// @brief   Returns the executing processor's per-CPU block.
+///
+/// @returns a pointer to the per-CPU block of the executing processor
+static __always_inline struct percpu *this_cpu(void)
+{
+    return this_cpu_read(self);
+}
+
+/// @fn      static inline unsigned int cpu_id(void)
+/// @brief   Returns the logical index of the executing processor.
+///
+/// @returns the logical CPU index
+static __always_inline unsigned int cpu_id(void)
+{
+    return this_cpu_read(cpu);
+}
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _ARCH_PERCPU_H */
\ No newline at end of file
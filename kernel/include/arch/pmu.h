@@ -0,0 +1,142 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/pmu.h                                                                         |
+// | Name          : x86 Performance-Monitoring Counter Driver (Header)                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the per-CPU and per-thread hardware performance counter interface.                       |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_PMU_H
+#define _ARCH_PMU_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+struct syscall_frame;
+struct thread;
+
+/// Architectural events, numbered as their bits in CPUID.0AH:EBX.
+enum pmu_event {
+    PMU_EVENT_CYCLES = 0,
+    PMU_EVENT_INSTRUCTIONS,
+    PMU_EVENT_REF_CYCLES,
+    PMU_EVENT_LLC_REFERENCES,
+    PMU_EVENT_LLC_MISSES,
+    PMU_EVENT_BRANCHES,
+    PMU_EVENT_BRANCH_MISSES,
+    PMU_EVENT_COUNT
+};
+
+#define PMU_COUNT_KERNEL             0x01
+#define PMU_COUNT_USER               0x02
+#define PMU_COUNT_INTERRUPT          0x04       /* raise a PMI on overflow */
+#define PMU_OPEN_CPU                 0x40       /* SYS_PMU_OPEN: count on the executing CPU, whoever runs there */
+#define PMU_OPEN_RDPMC               0x80       /* SYS_PMU_OPEN: let the thread read its counters with RDPMC */
+
+/// Handles returned by SYS_PMU_OPEN: a thread counter's index, or for a per-CPU counter PMU_HANDLE_CPU with the CPU's
+/// logical index from bit PMU_HANDLE_CPU_SHIFT and the counter's index below it.
+#define PMU_HANDLE_CPU               (1ULL << 30)
+#define PMU_HANDLE_CPU_SHIFT         8
+#define PMU_HANDLE_INDEX_MASK        0xFFULL
+
+#define PMU_MAX_GP                   8
+#define PMU_MAX_FIXED                4
+#define PMU_SLOT_NONE                (-1)
+#define PMU_SLOT_FIXED               32         /* slots >= this value name fixed-function counters */
+#define PMU_CPU_COUNTERS             4          /* per-CPU counters privileged servers may open on each CPU */
+
+/// One logical counter. While resident on a CPU it occupies a hardware slot there and its value is the accumulated
+/// count plus the hardware delta since it was loaded; while not resident it is just the accumulated count.
+struct pmu_counter {
+    uint64_t count;
+    uint64_t start;
+    uint8_t  event;
+    uint8_t  flags;
+    int8_t   slot;
+    uint16_t cpu;
+};
+
+/// Counters that follow a thread. struct thread points to one of these and the scheduler hands it to
+/// pmu_context_switch(). Kernel clients attach their own counters with pmu_context_add(); counters opened by the
+/// thread itself through SYS_PMU_OPEN live in owned[].
+#define PMU_CONTEXT_COUNTERS         4
+
+struct pmu_context {
+    struct pmu_counter *counters[PMU_CONTEXT_COUNTERS];
+    uint8_t             nr_counters;
+    uint8_t             nr_owned;
+    bool                user_rdpmc;     ///< CR4.PCE is set while the thread runs
+    struct pmu_counter  owned[PMU_CONTEXT_COUNTERS];
+};
+
+/// Hardware slot ownership on one CPU. Only that CPU modifies it.
+struct pmu_cpu {
+    struct pmu_counter *gp[PMU_MAX_GP];
+    struct pmu_counter *fixed[PMU_MAX_FIXED];
+    uint64_t            global_ctrl;        ///< requested IA32_PERF_GLOBAL_CTRL value
+    uint64_t            fixed_ctrl;         ///< requested IA32_FIXED_CTR_CTRL value
+    uint64_t            gp_value_mask;      ///< 2^width - 1 for the general-purpose counters
+    uint64_t            fixed_value_mask;   ///< 2^width - 1 for the fixed-function counters
+    uint8_t             nr_gp;
+    uint8_t             nr_fixed;
+    bool                user_rdpmc;         ///< RDPMC allowed for every thread, set by pmu_set_user_rdpmc()
+    bool                pce;                ///< current CR4.PCE
+    uint8_t             nr_owned;
+    struct pmu_counter  owned[PMU_CPU_COUNTERS];    ///< per-CPU counters opened through SYS_PMU_OPEN
+} __cacheline_aligned;
+
+extern struct pmu_cpu pmu_cpus[CONFIG_MAX_CPUS];
+
+int      pmu_init(unsigned int cpu);
+void     pmu_counter_init(struct pmu_counter *ctr, enum pmu_event event, uint8_t flags);
+int      pmu_counter_start(unsigned int cpu, struct pmu_counter *ctr);
+void     pmu_counter_stop(unsigned int cpu, struct pmu_counter *ctr);
+uint64_t pmu_counter_read(const struct pmu_counter *ctr);
+int      pmu_context_add(struct pmu_context *ctx, struct pmu_counter *ctr);
+void     pmu_context_switch(unsigned int cpu, struct pmu_context *prev, struct pmu_context *next);
+void     pmu_set_user_rdpmc(bool allow);
+void     pmu_counter_rearm(struct pmu_counter *ctr, uint64_t period);
+void     pmu_release(struct thread *t);
+int64_t  pmu_sys_open(struct syscall_frame *frame);
+int64_t  pmu_sys_read(struct syscall_frame *frame);
+
+/// @fn      static inline uint64_t pmu_overflow_bit(const struct pmu_counter *ctr)
+/// @brief   Returns the IA32_PERF_GLOBAL_STATUS/IA32_PERF_OVF_CTRL bit belonging to a resident counter.
+///
+/// @param   ctr a counter resident on the executing processor
+/// @returns the counter's overflow bit
+static __always_inline uint64_t pmu_overflow_bit(const struct pmu_counter *ctr)
+{
+    return ctr->slot >= PMU_SLOT_FIXED ? 1ULL << (32 + ctr->slot - PMU_SLOT_FIXED) : 1ULL << ctr->slot;
+}
+
+/// @fn      static inline uint32_t pmu_rdpmc_index(int slot)
+/// @brief   Converts a hardware slot number into the ECX selector expected by RDPMC.
+///
+/// @param   slot a general-purpose (0..7) or fixed (PMU_SLOT_FIXED + n) slot
+/// @returns the RDPMC counter selector
+static __always_inline uint32_t pmu_rdpmc_index(int slot)
+{
+    return slot >= PMU_SLOT_FIXED ? (1u << 30) | (uint32_t) (slot - PMU_SLOT_FIXED) : (uint32_t) slot;
+}
+
+#endif /* _ARCH_PMU_H */
\ No newline at end of file
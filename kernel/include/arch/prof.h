@@ -0,0 +1,72 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/prof.h                                                                        |
+// | Name          : x86 NMI Sampling Profiler (Header)                                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the PMC-overflow statistical profiler and its per-CPU sample buffers.                    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_PROF_H
+#define _ARCH_PROF_H
+
+#include "arch/pmu.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+struct syscall_frame;
+
+/// Number of samples buffered per CPU; must be a power of two. At 1 kHz this holds about one second of samples.
+#define PROF_RING_SIZE               1024
+
+struct prof_sample {
+    uint64_t rip;
+    uint64_t tsc;
+    uint32_t cpu;
+    uint32_t thread;                    ///< id of the interrupted thread, 0 in an idle thread
+};
+
+/// Single-producer/single-consumer sample ring. The NMI handler on the owning CPU is the only writer of head and the
+/// consumer, prof_drain() or SYS_PROF_DRAIN under a common lock, the only writer of tail; the two indices live on
+/// separate cache lines so that neither side's stores invalidate the other's line on every sample.
+struct prof_ring {
+    uint64_t           head __cacheline_aligned;
+    uint64_t           dropped;
+    uint64_t           tail __cacheline_aligned;
+    struct prof_sample samples[PROF_RING_SIZE] __cacheline_aligned;
+};
+
+struct prof_cpu {
+    struct pmu_counter counter;
+    uint64_t           period;
+    bool               active;
+    struct prof_ring   ring;
+} __cacheline_aligned;
+
+extern struct prof_cpu prof_cpus[CONFIG_MAX_CPUS];
+
+int     prof_start(unsigned int cpu, uint32_t sample_hz);
+void    prof_stop(unsigned int cpu);
+bool    prof_nmi(unsigned int cpu, uint64_t rip, uint32_t thread);
+size_t  prof_drain(unsigned int cpu, struct prof_sample *out, size_t max);
+int64_t prof_sys_drain(struct syscall_frame *frame);
+
+#endif /* _ARCH_PROF_H */
\ No newline at end of file
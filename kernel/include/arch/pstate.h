@@ -0,0 +1,113 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/pstate.h                                                                      |
+// | Name          : x86 Performance Policy (Header)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares per-CPU, per-domain and per-thread P-state policies applied through HWP or PERF_CTL.     |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_PSTATE_H
+#define _ARCH_PSTATE_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+struct thread;
+
+#define PSTATE_MAX_DOMAINS           16
+
+/// Performance policy. Values are ordered by performance so that the stronger of two policies is the larger; a CPU
+/// runs at the stronger of its own policy and that of the thread it is executing.
+enum pstate_policy {
+    PSTATE_DEFAULT,                     ///< no preference: a thread follows its CPU, a CPU follows its domain
+    PSTATE_EFFICIENCY,                  ///< turbo disengaged and an energy-saving bias, for batch work
+    PSTATE_BALANCED,                    ///< the full frequency range with a neutral bias
+    PSTATE_PERFORMANCE,                 ///< pinned at the highest frequency, for latency-critical work
+    PSTATE_POLICIES
+};
+
+/// Mechanism used to request performance levels from the processor.
+enum pstate_mode {
+    PSTATE_MODE_NONE,                   ///< neither HWP nor Enhanced SpeedStep; policies are recorded but inert
+    PSTATE_MODE_PERF_CTL,               ///< software-selected ratio through IA32_PERF_CTL
+    PSTATE_MODE_HWP,                    ///< hardware-managed P-states bounded through IA32_HWP_REQUEST
+};
+
+/// System-wide configuration, fixed by pstate_init(0) apart from the domain policies.
+struct pstate_config {
+    enum pstate_mode mode;
+    bool             epp;               ///< HWP requests carry an energy/performance preference
+    bool             epb;               ///< IA32_ENERGY_PERF_BIAS is available
+    uint32_t         nr_domains;
+    uint8_t          domain_policy[PSTATE_MAX_DOMAINS];
+    struct spinlock  lock;              ///< serializes policy changes; never taken on the switch path
+};
+
+/// Per-CPU policy state. The policy byte is written by whichever CPU changes a setting and read by the owner on every
+/// switch; everything else belongs to the owner.
+struct pstate_cpu {
+    uint8_t  policy;                    ///< CPU-level policy in force: the override if set, else the domain's
+    uint8_t  override;                  ///< per-CPU pin, or PSTATE_DEFAULT to follow the domain
+    uint8_t  domain;
+    uint8_t  applied;                   ///< policy last programmed into this CPU's MSRs
+    uint8_t  highest;                   ///< highest performance level (maximum turbo)
+    uint8_t  guaranteed;                ///< guaranteed performance level (base frequency)
+    uint8_t  efficient;                 ///< most efficient performance level
+    uint8_t  lowest;                    ///< lowest performance level
+    uint64_t writes;                    ///< policy MSR writes requested, including those the MSR shadow skipped
+    uint64_t switches[PSTATE_POLICIES]; ///< times each policy was applied
+} __cacheline_aligned;
+
+extern struct pstate_config pstate_config;
+extern struct pstate_cpu    pstate_cpus[CONFIG_MAX_CPUS];
+
+void pstate_init(unsigned int cpu);
+void pstate_apply(unsigned int cpu, uint8_t policy);
+int  pstate_set_cpu_policy(unsigned int cpu, enum pstate_policy policy);
+int  pstate_domain_create(const struct cpumask *cpus, enum pstate_policy policy);
+int  pstate_set_domain_policy(unsigned int domain, enum pstate_policy policy);
+int  pstate_set_thread_policy(struct thread *t, enum pstate_policy policy);
+
+/// @fn      static inline void pstate_update(unsigned int cpu, uint8_t thread_policy)
+/// @brief   Brings the executing processor's performance request in line with the thread about to run.
+///
+/// @details Called by the scheduler for every thread it dispatches. The MSRs are rewritten only when the effective
+/// policy differs from the one last programmed, so a CPU running threads of one policy pays a byte compare per switch,
+/// and a thread that migrates carries its policy to whichever CPU picks it up.
+///
+/// @param   cpu           the logical index of the executing processor
+/// @param   thread_policy the dispatched thread's enum pstate_policy
+/// @returns None (void)
+static __always_inline void pstate_update(unsigned int cpu, uint8_t thread_policy)
+{
+    struct pstate_cpu *pc   = &pstate_cpus[cpu];
+    uint8_t            want = __atomic_load_n(&pc->policy, __ATOMIC_RELAXED);
+
+    if (thread_policy > want)
+        want = thread_policy;
+    if (unlikely(want != pc->applied))
+        pstate_apply(cpu, want);
+}
+
+#endif /* _ARCH_PSTATE_H */
\ No newline at end of file
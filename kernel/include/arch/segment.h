@@ -0,0 +1,50 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/segment.h                                                                     |
+// | Name          : x86 Segment Selector Assignments                                                                  |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Contains the fixed GDT layout and the segment selectors derived from it.                          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_SEGMENT_H
+#define _ARCH_SEGMENT_H
+
+// The order of the kernel and user descriptors is dictated by SYSCALL/SYSRET: SYSCALL loads CS from STAR[47:32] and
+// SS from STAR[47:32] + 8, while 64-bit SYSRET loads CS from STAR[63:48] + 16 and SS from STAR[63:48] + 8.
+#define GDT_NULL                     0
+#define GDT_KERNEL_CODE              1
+#define GDT_KERNEL_DATA              2
+#define GDT_USER_CODE32              3
+#define GDT_USER_DATA                4
+#define GDT_USER_CODE                5
+#define GDT_TSS                      6      /* 16-byte system descriptor, occupies slots 6 and 7 */
+#define GDT_ENTRIES                  8
+
+#define SEG_RPL_USER                 3
+
+#define SEL_KERNEL_CODE              (GDT_KERNEL_CODE << 3)
+#define SEL_KERNEL_DATA              (GDT_KERNEL_DATA << 3)
+#define SEL_USER_CODE32              ((GDT_USER_CODE32 << 3) | SEG_RPL_USER)
+#define SEL_USER_DATA                ((GDT_USER_DATA << 3) | SEG_RPL_USER)
+#define SEL_USER_CODE                ((GDT_USER_CODE << 3) | SEG_RPL_USER)
+#define SEL_TSS                      (GDT_TSS << 3)
+
+#endif /* _ARCH_SEGMENT_H */
\ No newline at end of file
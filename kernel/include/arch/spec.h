@@ -0,0 +1,79 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/spec.h                                                                        |
+// | Name          : Speculation Barriers (Header)                                                                     |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares per-label speculative-execution mitigation policy for protection domains.                |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_SPEC_H
+#define _ARCH_SPEC_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+struct vm_space;
+
+#define SPEC_MAX_LABELS              16
+#define SPEC_LABEL_NONE              0xFF           /* no user domain has run on the CPU yet */
+
+// Mitigations a label's policy can ask for. The barriers are issued when a processor moves between user domains of
+// different labels and either side's policy asks for them; the SPEC_CTRL controls are in force while the label runs.
+#define SPEC_IBPB                    0x01           /* indirect branch prediction barrier through IA32_PRED_CMD */
+#define SPEC_L1D_FLUSH               0x02           /* L1 data cache writeback and invalidate through IA32_FLUSH_CMD */
+#define SPEC_STIBP                   0x04           /* no indirect branch prediction shared with the sibling thread */
+#define SPEC_SSBD                    0x08           /* speculative store bypass disabled */
+#define SPEC_POLICY_MASK             0x0F
+
+/// Barriers counted individually.
+enum spec_barrier {
+    SPEC_BARRIER_IBPB,
+    SPEC_BARRIER_L1D_FLUSH,
+    SPEC_BARRIERS
+};
+
+/// System-wide configuration, fixed by spec_init(0) apart from the label policies.
+struct spec_config {
+    uint8_t  available;                 ///< SPEC_* mechanisms the processor implements
+    uint8_t  needed;                    ///< available SPEC_* mechanisms whose attacks the processor is not immune to
+    bool     spec_ctrl;                 ///< IA32_SPEC_CTRL is implemented
+    uint64_t spec_ctrl_base;            ///< IA32_SPEC_CTRL bits kept set in every domain
+    uint8_t  label_policy[SPEC_MAX_LABELS];
+};
+
+/// Per-CPU state, owned by the processor and updated on address-space switches with interrupts disabled.
+struct spec_cpu {
+    uint8_t  label;                     ///< label of the user domain last loaded, or SPEC_LABEL_NONE
+    uint64_t crossings;                 ///< switches between user domains of different labels
+    uint64_t issued[SPEC_BARRIERS];
+    uint64_t skipped[SPEC_BARRIERS];    ///< requested by policy but elided: same label, or the processor is immune
+} __cacheline_aligned;
+
+extern struct spec_config spec_config;
+extern struct spec_cpu    spec_cpus[CONFIG_MAX_CPUS];
+
+void spec_init(unsigned int cpu);
+void spec_switch(unsigned int cpu, const struct vm_space *next);
+int  spec_set_label_policy(unsigned int label, unsigned int policy);
+int  spec_set_domain_label(struct vm_space *space, unsigned int label);
+
+#endif /* _ARCH_SPEC_H */
\ No newline at end of file
@@ -7,7 +7,7 @@
 // | Version       : 0.0.0                                                                                             |
 // | License       : GNU General Public License (GPL), version 3.0                                                     |
 // | Date Created  : June 21, 2024                                                                                     |
-// | Date Modified : June 21, 2024                                                                                     |
+// | Date Modified : October 18, 2026                                                                                  |
 // | Description   : Provides C structure definitions of integral x86 and x86-64 descriptor table structures.          |
 // +-------------------------------------------------------------------------------------------------------------------+
 // | Copyright (C) 2024 Elijah Creed Fedele                                                                            |
@@ -29,6 +29,11 @@
 
 #include "sys/freestd.h"
 
+struct desc_ptr {
+    uint16_t limit;
+    uint64_t base;
+} __attribute__((packed));
+
 struct gdt_gate {
     uint16_t limit_low;
     uint16_t base_low;
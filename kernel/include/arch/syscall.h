@@ -0,0 +1,105 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/syscall.h                                                                     |
+// | Name          : x86 System Call Entry (Header)                                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the SYSCALL/SYSRET fast path, the legacy INT gate and the dispatch table.                |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_SYSCALL_H
+#define _ARCH_SYSCALL_H
+
+/// Vector of the legacy software-interrupt system call gate, kept only for compatibility.
+#define SYSCALL_VECTOR               0x80
+
+// Layout of struct syscall_frame, in bytes, for the entry stubs.
+#define SYSCALL_FRAME_RAX            0
+#define SYSCALL_FRAME_RIP            56
+#define SYSCALL_FRAME_SIZE           96
+
+// The null system call, issued by the ring-3 benchmark code in kern/bench_user.S.
+#define SYSCALL_NULL                 0
+
+// The two IPC system calls, taken by the SYSCALL stub straight to the IPC entry. They must stay adjacent.
+#define SYSCALL_IPC_CALL             2
+#define SYSCALL_IPC_REPLY_WAIT       3
+
+#ifndef __ASSEMBLER__
+
+#include "sys/freestd.h"
+
+/// System call numbers. Arguments are passed in RDI, RSI, RDX, R10, R8 and R9 and the result is returned in RAX.
+enum syscall_number {
+    SYS_NULL           = SYSCALL_NULL,
+    SYS_UMWAIT_POLICY,
+    SYS_IPC_CALL       = SYSCALL_IPC_CALL,
+    SYS_IPC_REPLY_WAIT = SYSCALL_IPC_REPLY_WAIT,
+    SYS_IPC_BUFFER,
+    SYS_CHAN_CREATE,
+    SYS_CHAN_MAP,
+    SYS_CHAN_WAIT,
+    SYS_CHAN_NOTIFY,
+    SYS_INTR_CREATE,
+    SYS_INTR_BIND,
+    SYS_INTR_AFFINITY,
+    SYS_INTR_WAIT,
+    SYS_TLS_BASE,
+    SYS_PMU_OPEN,
+    SYS_PMU_READ,
+    SYS_PROF_DRAIN,
+    SYS_TELEMETRY_MAP,
+    SYS_COUNT
+};
+
+/// Register state saved on kernel entry by either system call path. The last five fields form a hardware interrupt
+/// frame, which the SYSCALL stub builds by hand, so both paths share one layout and handlers need not know which
+/// instruction entered the kernel. Only RCX and R11 (and RAX, which carries the result) are clobbered for the caller.
+struct syscall_frame {
+    uint64_t rax;
+    uint64_t rdi;
+    uint64_t rsi;
+    uint64_t rdx;
+    uint64_t r10;
+    uint64_t r8;
+    uint64_t r9;
+    uint64_t rip;
+    uint64_t cs;
+    uint64_t rflags;
+    uint64_t rsp;
+    uint64_t ss;
+};
+
+_Static_assert(offsetof(struct syscall_frame, rax) == SYSCALL_FRAME_RAX, "SYSCALL_FRAME_RAX");
+_Static_assert(offsetof(struct syscall_frame, rip) == SYSCALL_FRAME_RIP, "SYSCALL_FRAME_RIP");
+_Static_assert(sizeof(struct syscall_frame) == SYSCALL_FRAME_SIZE, "SYSCALL_FRAME_SIZE");
+
+typedef int64_t (*syscall_fn)(struct syscall_frame *frame);
+
+void    syscall_init(void);
+int64_t syscall_dispatch(struct syscall_frame *frame);
+
+void    syscall_entry(void);
+void    syscall_return(void);
+void    syscall_legacy_entry(void);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _ARCH_SYSCALL_H */
\ No newline at end of file
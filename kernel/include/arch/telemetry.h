@@ -0,0 +1,112 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/telemetry.h                                                                   |
+// | Name          : x86 Frequency and Thermal Telemetry (Header)                                                      |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the per-CPU APERF/MPERF/thermal records published read-only to user space.               |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_TELEMETRY_H
+#define _ARCH_TELEMETRY_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+struct syscall_frame;
+
+#define TELEMETRY_VERSION            1
+#define TELEMETRY_PAGE_SIZE          4096
+
+// telemetry_cpu.flags: conditions in force at the last sample.
+#define TELEMETRY_THERMAL_THROTTLE   0x00000001     /* core thermal monitor is throttling */
+#define TELEMETRY_PROCHOT            0x00000002     /* PROCHOT# asserted by another agent */
+#define TELEMETRY_POWER_LIMIT        0x00000004     /* frequency capped by a power or current limit */
+#define TELEMETRY_CLOCK_MODULATION   0x00000008     /* on-demand clock modulation is enabled */
+#define TELEMETRY_THROTTLED          (TELEMETRY_THERMAL_THROTTLE | TELEMETRY_PROCHOT | TELEMETRY_POWER_LIMIT | \
+                                      TELEMETRY_CLOCK_MODULATION)
+
+/// One CPU's latest sample. Written only by that CPU under a sequence counter: readers retry while seq is odd or
+/// changes across their read (see telemetry_read()), so they never observe a torn record and never make a syscall.
+struct telemetry_cpu {
+    uint32_t seq;
+    uint32_t flags;                     ///< TELEMETRY_* conditions at the last sample
+    uint64_t timestamp_ns;              ///< ktime_ns() of the last sample
+    uint32_t effective_mhz;             ///< average frequency while not halted over the last interval
+    uint32_t busy_permille;             ///< share of the last interval spent in C0
+    uint32_t perf_status_ratio;         ///< current core ratio from IA32_PERF_STATUS
+    uint32_t thermal_margin_c;          ///< degrees below the throttle temperature, if the sensor is valid
+    uint32_t thermal_events;            ///< thermal throttle and PROCHOT episodes observed
+    uint32_t power_limit_events;        ///< power or current limit episodes observed
+    uint64_t aperf;                     ///< accumulated APERF deltas, for readers computing their own windows
+    uint64_t mperf;                     ///< accumulated MPERF deltas
+} __cacheline_aligned;
+
+/// System-wide fields, on their own cache line.
+struct telemetry_header {
+    uint32_t version;
+    uint32_t nr_cpus;                   ///< records in use
+    uint64_t tsc_hz;                    ///< MPERF and TSC rate
+    uint32_t interval_us;               ///< minimum sampling interval
+    uint32_t package_thermal_events;
+    uint32_t package_power_limit_events;
+    uint32_t features;                  ///< TELEMETRY_HAS_* capabilities of this processor
+} __cacheline_aligned;
+
+#define TELEMETRY_HAS_APERFMPERF     0x00000001
+#define TELEMETRY_HAS_THERMAL        0x00000002
+#define TELEMETRY_HAS_PACKAGE        0x00000004
+
+/// The published region: page aligned and page sized so that it can be mapped read-only into user address spaces
+/// without exposing neighbouring kernel data.
+struct telemetry_page {
+    struct telemetry_header header;
+    struct telemetry_cpu    cpus[CONFIG_MAX_CPUS];
+} __aligned(TELEMETRY_PAGE_SIZE);
+
+#define TELEMETRY_PAGES              ((sizeof(struct telemetry_page) + TELEMETRY_PAGE_SIZE - 1) / TELEMETRY_PAGE_SIZE)
+
+extern struct telemetry_page telemetry_page;
+
+void    telemetry_init(unsigned int cpu);
+void    telemetry_sample(unsigned int cpu);
+void    telemetry_tick(unsigned int cpu);
+int64_t telemetry_sys_map(struct syscall_frame *frame);
+
+/// @fn      static inline void telemetry_read(const struct telemetry_cpu *src, struct telemetry_cpu *dst)
+/// @brief   Takes a consistent snapshot of one CPU's record; usable from user space on the mapped page.
+///
+/// @param   src the published record
+/// @param   dst receives the snapshot
+/// @returns None (void)
+static __always_inline void telemetry_read(const struct telemetry_cpu *src, struct telemetry_cpu *dst)
+{
+    uint32_t seq;
+
+    do {
+        while ((seq = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE)) & 1)
+            __builtin_ia32_pause();
+        *dst = *src;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&src->seq, __ATOMIC_RELAXED) != seq);
+}
+
+#endif /* _ARCH_TELEMETRY_H */
\ No newline at end of file
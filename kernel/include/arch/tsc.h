@@ -0,0 +1,108 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/tsc.h                                                                         |
+// | Name          : x86 TSC Clocksource (Header)                                                                      |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the calibrated time-stamp-counter clocksource and the monotonic ktime_ns() clock.        |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_TSC_H
+#define _ARCH_TSC_H
+
+#include "arch/inst.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+/// Conversion parameters between TSC cycles and nanoseconds. Written once by tsc_init() and read-only afterwards, so
+/// the structure sits alone on its cache line and is never invalidated by unrelated stores.
+struct tsc_clock {
+    uint64_t base;          ///< TSC value corresponding to ktime_ns() == 0
+    uint64_t mult;          ///< nanoseconds per cycle, scaled by 2^shift
+    uint64_t inv_mult;      ///< cycles per nanosecond, scaled by 2^shift
+    uint64_t hz;
+    uint32_t shift;
+    bool     invariant;     ///< CPUID reports a constant-rate TSC that keeps running in deep C-states
+    bool     calibrated;    ///< frequency was measured against the PIT rather than enumerated by CPUID
+    bool     synchronized;  ///< every CPU brought up so far passed tsc_sync_ap() within tolerance
+} __cacheline_aligned;
+
+/// Outcome of synchronizing one application processor's TSC against the bootstrap processor.
+struct tsc_sync_result {
+    int64_t  adjust;        ///< total correction written to IA32_TSC_ADJUST beyond the BSP's own value, in cycles
+    int64_t  residual;      ///< skew (BSP minus AP) remaining after the last correction, in cycles
+    uint64_t round_trip;    ///< best observed cache-line round trip, which bounds the measurement error
+    bool     synchronized;
+};
+
+extern struct tsc_clock       tsc_clock;
+extern struct tsc_sync_result tsc_sync_results[CONFIG_MAX_CPUS];
+
+void tsc_init(void);
+void tsc_spin_ns(uint64_t ns);
+void tsc_sync_ap(unsigned int cpu);
+void tsc_sync_bsp(unsigned int cpu);
+
+/// @fn      static inline uint64_t tsc_read_ordered(void)
+/// @brief   Reads the TSC after all preceding instructions have completed.
+///
+/// @returns the current value of the time-stamp counter
+static __always_inline uint64_t tsc_read_ordered(void)
+{
+    _lfence();
+    return _rdtsc();
+}
+
+/// @fn      static inline uint64_t tsc_cycles_to_ns(uint64_t cycles)
+/// @brief   Converts a TSC cycle count to nanoseconds.
+///
+/// @details The conversion is a single 64x64->128-bit multiply and a shift; no division is performed.
+///
+/// @param   cycles the number of TSC cycles
+/// @returns the equivalent duration in nanoseconds
+static __always_inline uint64_t tsc_cycles_to_ns(uint64_t cycles)
+{
+    return (uint64_t) (((unsigned __int128) cycles * tsc_clock.mult) >> tsc_clock.shift);
+}
+
+/// @fn      static inline uint64_t tsc_ns_to_cycles(uint64_t ns)
+/// @brief   Converts a duration in nanoseconds to TSC cycles.
+///
+/// @param   ns the duration in nanoseconds
+/// @returns the equivalent number of TSC cycles
+static __always_inline uint64_t tsc_ns_to_cycles(uint64_t ns)
+{
+    return (uint64_t) (((unsigned __int128) ns * tsc_clock.inv_mult) >> tsc_clock.shift);
+}
+
+/// @fn      static inline uint64_t ktime_ns(void)
+/// @brief   Returns monotonic kernel time in nanoseconds since tsc_init().
+///
+/// @details This is one RDTSC, a subtraction, and a fixed-point multiply/shift, and is cheap enough for scheduler
+/// accounting, IPC timeouts and tracing. Readings are monotonic across CPUs only while tsc_clock.synchronized holds.
+///
+/// @returns nanoseconds elapsed since the clocksource was initialized
+static __always_inline uint64_t ktime_ns(void)
+{
+    return tsc_cycles_to_ns(_rdtsc() - tsc_clock.base);
+}
+
+#endif /* _ARCH_TSC_H */
\ No newline at end of file
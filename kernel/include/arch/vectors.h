@@ -0,0 +1,69 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/arch/vectors.h                                                                     |
+// | Name          : x86 Interrupt Vector Assignments                                                                  |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Contains the fixed assignment of IDT vectors to exceptions, IPIs and local APIC sources.          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _ARCH_VECTORS_H
+#define _ARCH_VECTORS_H
+
+// Architectural exceptions occupy vectors 0-31. Device interrupts are allocated dynamically from
+// VECTOR_DEVICE_FIRST upward; the top of the table is reserved for local APIC sources and IPIs, which have the highest
+// priority classes and so are never held off by device interrupts.
+#define VECTOR_DIVIDE_ERROR          0x00
+#define VECTOR_DEBUG                 0x01
+#define VECTOR_NMI                   0x02
+#define VECTOR_BREAKPOINT            0x03
+#define VECTOR_OVERFLOW              0x04
+#define VECTOR_BOUND_RANGE           0x05
+#define VECTOR_INVALID_OPCODE        0x06
+#define VECTOR_DEVICE_NOT_AVAILABLE  0x07
+#define VECTOR_DOUBLE_FAULT          0x08
+#define VECTOR_INVALID_TSS           0x0A
+#define VECTOR_SEGMENT_NOT_PRESENT   0x0B
+#define VECTOR_STACK_FAULT           0x0C
+#define VECTOR_GENERAL_PROTECTION    0x0D
+#define VECTOR_PAGE_FAULT            0x0E
+#define VECTOR_X87_FPU_ERROR         0x10
+#define VECTOR_ALIGNMENT_CHECK       0x11
+#define VECTOR_MACHINE_CHECK         0x12
+#define VECTOR_SIMD_FP_EXCEPTION     0x13
+#define VECTOR_VIRTUALIZATION        0x14
+#define VECTOR_CONTROL_PROTECTION    0x15
+#define VECTOR_EXCEPTION_COUNT       0x20
+
+// Raised only by INT n, never by the APIC, so its handler returns without an EOI. Used by the benchmarks.
+#define VECTOR_SOFTWARE              0x20
+
+#define VECTOR_DEVICE_FIRST          0x30
+#define VECTOR_DEVICE_LAST           0xDF
+
+#define VECTOR_APIC_TIMER            0xEC
+#define VECTOR_APIC_THERMAL          0xED
+#define VECTOR_APIC_ERROR            0xEE
+#define VECTOR_IPI_RESCHEDULE        0xF0
+#define VECTOR_IPI_TLB_SHOOTDOWN     0xF1
+#define VECTOR_IPI_CALL              0xF2
+#define VECTOR_APIC_SPURIOUS         0xFF
+
+#endif /* _ARCH_VECTORS_H */
\ No newline at end of file
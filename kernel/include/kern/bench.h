@@ -0,0 +1,87 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/bench.h                                                                       |
+// | Name          : Benchmarks (Header)                                                                               |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares in-kernel microbenchmark entry points, built with make BENCH=1.                          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_BENCH_H
+#define _KERN_BENCH_H
+
+#include "arch/tsc.h"
+#include "sys/cdefs.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+
+struct vm_space;
+
+#define BENCH_BATCH                  64             /* operations timed between two TSC reads */
+
+/// Outcome of one measured loop. Cycles are TSC cycles; divide by ops for the cost of one operation.
+struct bench_result {
+    const char *name;
+    uint64_t    ops;                    ///< operations timed
+    uint64_t    cycles;                 ///< total cycles spent on them
+    uint64_t    best;                   ///< fewest cycles taken by any batch of BENCH_BATCH operations
+};
+
+/// Times `batches` batches of BENCH_BATCH executions of stmt into *result. The ordered TSC reads bracket each batch,
+/// so the cost of reading the clock is spread over the batch rather than charged to every operation.
+#define BENCH_TIME(result, label, batches, stmt)                                                                    \
+    do {                                                                                                            \
+        struct bench_result *__r = (result);                                                                        \
+        __r->name   = (label);                                                                                      \
+        __r->ops    = (uint64_t) (batches) * BENCH_BATCH;                                                           \
+        __r->cycles = 0;                                                                                            \
+        __r->best   = UINT64_MAX;                                                                                   \
+        for (uint64_t __b = 0; __b < (uint64_t) (batches); __b++) {                                                 \
+            uint64_t __t0 = tsc_read_ordered();                                                                     \
+            for (unsigned int __i = 0; __i < BENCH_BATCH; __i++) {                                                  \
+                stmt;                                                                                               \
+            }                                                                                                       \
+            uint64_t __dt = tsc_read_ordered() - __t0;                                                              \
+            __r->cycles += __dt;                                                                                    \
+            if (__dt < __r->best)                                                                                   \
+                __r->best = __dt;                                                                                   \
+        }                                                                                                           \
+    } while (0)
+
+/// Number of results each benchmark fills in.
+#define BENCH_INTRINSICS_RESULTS     2
+#define BENCH_INT_RESULTS            2
+#define BENCH_SYSCALL_RESULTS        4
+#define BENCH_IPI_RESULTS            3
+#define BENCH_SCHED_RESULTS          2
+#define BENCH_FRAME_RESULTS          2
+#define BENCH_UNMAP_RESULTS          2
+#define BENCH_CHAN_RESULTS           4
+
+void bench_intrinsics(struct bench_result *results, uint64_t batches);
+void bench_int(struct bench_result *results, uint64_t batches);
+int  bench_syscall(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va);
+void bench_ipi(struct bench_result *results, uint64_t batches, const struct cpumask *targets);
+int  bench_sched(struct bench_result *results, uint64_t batches, unsigned int peer_cpu);
+void bench_frame(struct bench_result *results, uint64_t batches);
+int  bench_unmap(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va);
+int  bench_chan(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va);
+
+#endif /* _KERN_BENCH_H */
\ No newline at end of file
@@ -0,0 +1,64 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/chan.h                                                                        |
+// | Name          : Channels (Header)                                                                                 |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares kernel-brokered shared-memory channels and their doorbell system calls.                  |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_CHAN_H
+#define _KERN_CHAN_H
+
+#include "arch/syscall.h"
+#include "kern/chan_ring.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+#define CHAN_MAX_SLOT_SIZE           65536
+
+struct thread;
+
+/// A channel: one ring, in physically contiguous frames, that every attached address space maps at an address of its
+/// choosing. Payloads are written and read in place, so the kernel moves no data; it only parks and wakes threads
+/// whose side of the ring cannot make progress.
+struct chan {
+    struct spinlock   lock;
+    bool              valid;
+    uint8_t           order;            ///< the ring spans PAGE_SIZE << order bytes
+    uint64_t          phys;
+    struct chan_ring *ring;             ///< kernel alias of the ring
+    struct thread    *sleepers[2];      ///< per CHAN_SIDE_*, threads parked in SYS_CHAN_WAIT
+    uint64_t          waits;            ///< SYS_CHAN_WAIT calls that parked
+    uint64_t          notifies;         ///< SYS_CHAN_NOTIFY calls
+    uint64_t          wakeups;          ///< threads woken by them
+} __cacheline_aligned;
+
+extern struct chan chan_table[CONFIG_CHANNELS];
+
+int     chan_create(uint32_t slot_size, uint32_t nr_slots, uint32_t flags);
+int64_t chan_sys_create(struct syscall_frame *frame);
+int64_t chan_sys_map(struct syscall_frame *frame);
+int64_t chan_sys_wait(struct syscall_frame *frame);
+int64_t chan_sys_notify(struct syscall_frame *frame);
+
+#endif /* _KERN_CHAN_H */
\ No newline at end of file
@@ -0,0 +1,178 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/chan_ring.h                                                                   |
+// | Name          : Channel Rings                                                                                     |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Defines the shared ring layout of channels and its lock-free producer and consumer operations.    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_CHAN_RING_H
+#define _KERN_CHAN_RING_H
+
+#include "sys/cdefs.h"
+#include "sys/freestd.h"
+
+#define CHAN_RING_MAGIC              0x474E495241484353ULL  /* "SCHARING" */
+#define CHAN_RING_HEADER_SIZE        (4 * CACHE_LINE_SIZE)
+#define CHAN_MIN_SLOT_SIZE           64
+#define CHAN_MPSC                    0x1            /* several producers claim slots with compare-and-swap */
+
+#define CHAN_SIDE_CONSUMER           0              /* waits for data */
+#define CHAN_SIDE_PRODUCER           1              /* waits for free slots */
+
+/// Header of a channel ring, mapped into every address space attached to the channel and followed by nr_slots slots
+/// of slot_size bytes. Each line has one kind of writer: the kernel (geometry, at creation only), the producers
+/// (tail), the consumer (head), and sleepers announcing themselves (waiting flags), so steady-state traffic moves no
+/// line back and forth except the slots themselves.
+struct chan_ring {
+    uint64_t magic;
+    uint32_t nr_slots;                  ///< a power of two
+    uint32_t slot_size;                 ///< bytes per slot, a power of two including the sequence word
+    uint32_t flags;                     ///< CHAN_* flags
+
+    uint64_t tail __cacheline_aligned;  ///< next position to claim
+    uint64_t head __cacheline_aligned;  ///< next position to consume
+    uint32_t waiting[2] __cacheline_aligned;    ///< per CHAN_SIDE_*: a thread is in or entering SYS_CHAN_WAIT
+};
+
+_Static_assert(sizeof(struct chan_ring) == CHAN_RING_HEADER_SIZE, "CHAN_RING_HEADER_SIZE");
+
+/// One slot. seq equals the slot's position while it is free for that position, position + 1 once filled, and
+/// advances by nr_slots when consumed, so producers and the consumer synchronize on the slot alone.
+struct chan_slot {
+    uint64_t seq;
+    uint8_t  data[];
+};
+
+/// @fn      static inline struct chan_slot *chan_slot_at(struct chan_ring *ring, uint64_t pos)
+/// @brief   Returns the slot that holds a position.
+///
+/// @param   ring the ring
+/// @param   pos  the position
+/// @returns the slot
+static __always_inline struct chan_slot *chan_slot_at(struct chan_ring *ring, uint64_t pos)
+{
+    return (struct chan_slot *) ((uint8_t *) ring + CHAN_RING_HEADER_SIZE +
+                                 (pos & (ring->nr_slots - 1)) * ring->slot_size);
+}
+
+/// @fn      static inline struct chan_slot *chan_reserve(struct chan_ring *ring, uint64_t *pos)
+/// @brief   Claims the next free slot for writing in place.
+///
+/// @details With CHAN_MPSC the claim is a compare-and-swap on tail; a single producer just advances it. The payload
+/// is written directly into the returned slot, which the consumer sees only after chan_commit().
+///
+/// @param   ring the ring
+/// @param   pos  receives the claimed position, to pass to chan_commit()
+/// @returns the slot, or NULL if the ring is full
+static __always_inline struct chan_slot *chan_reserve(struct chan_ring *ring, uint64_t *pos)
+{
+    uint64_t p = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+    for (;;) {
+        struct chan_slot *slot = chan_slot_at(ring, p);
+        int64_t           diff = (int64_t) (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - p);
+        if (diff < 0)
+            return NULL;
+        if (diff > 0) {
+            p = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+        } else if (!(ring->flags & CHAN_MPSC)) {
+            __atomic_store_n(&ring->tail, p + 1, __ATOMIC_RELAXED);
+            *pos = p;
+            return slot;
+        } else if (__atomic_compare_exchange_n(&ring->tail, &p, p + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *pos = p;
+            return slot;
+        }
+    }
+}
+
+/// @fn      static inline void chan_commit(struct chan_ring *ring, struct chan_slot *slot, uint64_t pos)
+/// @brief   Publishes a slot filled after chan_reserve().
+///
+/// @param   ring the ring
+/// @param   slot the slot
+/// @param   pos  the position returned by chan_reserve()
+/// @returns None (void)
+static __always_inline void chan_commit(struct chan_ring *ring, struct chan_slot *slot, uint64_t pos)
+{
+    (void) ring;
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+/// @fn      static inline struct chan_slot *chan_peek(struct chan_ring *ring)
+/// @brief   Returns the oldest filled slot, to be read in place by the consumer.
+///
+/// @param   ring the ring
+/// @returns the slot, or NULL if the ring is empty
+static __always_inline struct chan_slot *chan_peek(struct chan_ring *ring)
+{
+    uint64_t          pos  = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    struct chan_slot *slot = chan_slot_at(ring, pos);
+
+    return __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == pos + 1 ? slot : NULL;
+}
+
+/// @fn      static inline void chan_release(struct chan_ring *ring, struct chan_slot *slot)
+/// @brief   Returns the slot obtained from chan_peek() to the producers.
+///
+/// @param   ring the ring
+/// @param   slot the slot
+/// @returns None (void)
+static __always_inline void chan_release(struct chan_ring *ring, struct chan_slot *slot)
+{
+    uint64_t pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&slot->seq, pos + ring->nr_slots, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, pos + 1, __ATOMIC_RELAXED);
+}
+
+/// @fn      static inline void chan_prepare_wait(struct chan_ring *ring, unsigned int side)
+/// @brief   Announces that the caller is about to sleep on one side of the ring.
+///
+/// @details Must be followed by a fresh chan_peek() or chan_reserve() and, if that still fails, SYS_CHAN_WAIT. The
+/// full barrier pairs with the one in chan_doorbell(), so a peer either sees the flag or its work is seen here.
+///
+/// @param   ring the ring
+/// @param   side CHAN_SIDE_CONSUMER to wait for data, CHAN_SIDE_PRODUCER to wait for free slots
+/// @returns None (void)
+static __always_inline void chan_prepare_wait(struct chan_ring *ring, unsigned int side)
+{
+    __atomic_store_n(&ring->waiting[side], 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/// @fn      static inline bool chan_doorbell(struct chan_ring *ring, unsigned int side)
+/// @brief   Tells whether a batch just committed (or released) must be followed by SYS_CHAN_NOTIFY.
+///
+/// @details Call once per batch, not per slot. The common case is a fence and a read of a line that only changes when
+/// a peer goes to sleep; the kernel is entered only when one has.
+///
+/// @param   ring the ring
+/// @param   side the side to wake: CHAN_SIDE_CONSUMER after producing, CHAN_SIDE_PRODUCER after consuming
+/// @returns true if a thread on that side is asleep or about to be
+static __always_inline bool chan_doorbell(struct chan_ring *ring, unsigned int side)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return __atomic_load_n(&ring->waiting[side], __ATOMIC_RELAXED) != 0;
+}
+
+#endif /* _KERN_CHAN_RING_H */
\ No newline at end of file
@@ -0,0 +1,96 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/intr.h                                                                        |
+// | Name          : Interrupt Notification (Header)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares device interrupt dispatch to user-mode drivers' notification words.                      |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_INTR_H
+#define _KERN_INTR_H
+
+#include "arch/syscall.h"
+#include "arch/vectors.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+#define INTR_VECTORS                 256
+#define INTR_NOTIFY_BITS             63             /* bit 63 stays clear, so a word never reads as an error */
+#define INTR_MSI_ADDRESS             0xFEE00000ULL  /* destination APIC ID in bits 19:12 */
+#define INTR_CPU_SELF                UINT64_MAX     /* SYS_INTR_BIND: target the calling thread's processor */
+
+struct thread;
+struct vm_space;
+
+/// A notification word. Each bit stands for one device interrupt line bound by the driver; the kernel ORs bits in and
+/// the driver collects them all at once with SYS_INTR_WAIT, so any number of interrupts on any number of lines cost it
+/// at most one wake-up. Only threads of the address space that created a word may use it.
+struct intr_notify {
+    struct spinlock  lock;
+    bool             valid;
+    uint64_t         word;              ///< lines delivered and not yet collected
+    uint64_t         bound;             ///< bits with a line bound to them
+    struct thread   *waiter;            ///< the driver thread blocked in SYS_INTR_WAIT; there is at most one
+    struct vm_space *owner;             ///< address space of the driver that created the word, NULL for the kernel
+    uint8_t          vectors[INTR_NOTIFY_BITS];  ///< vector bound to each bit
+} __cacheline_aligned;
+
+/// A device interrupt line, one per vector. Interrupts are counted and delivered in batches: when batch of them have
+/// arrived, or delay cycles after the first of an incomplete batch. A delivered line is masked until the driver
+/// acknowledges its bit; interrupts taken meanwhile are counted toward the next batch.
+struct intr_line {
+    struct spinlock     lock;
+    bool                masked;
+    bool                armed;          ///< an incomplete batch is waiting on armed_cpu's timer
+    uint16_t            armed_cpu;
+    uint32_t            cpu;            ///< processor the device is told to interrupt
+    struct intr_notify *notify;         ///< NULL while the vector is free
+    uint64_t            bit;
+    uint32_t            batch;
+    uint32_t            count;          ///< interrupts not yet delivered
+    uint64_t            delay;          ///< in TSC cycles
+    uint64_t            first_tsc;      ///< arrival of the first interrupt counted in count
+    uint64_t            interrupts;
+    uint64_t            deliveries;
+    uint64_t            spurious;       ///< interrupts on an unbound vector
+} __cacheline_aligned;
+
+/// Per-CPU coalescing state, private to its owner.
+struct intr_cpu {
+    uint64_t armed[INTR_VECTORS / 64];  ///< lines whose incomplete batch this processor's timer flushes
+    uint64_t deadline;                  ///< earliest flush requested from the scheduler, or 0
+} __cacheline_aligned;
+
+extern struct intr_notify intr_notifies[CONFIG_INTR_NOTIFIES];
+extern struct intr_line   intr_lines[INTR_VECTORS];
+extern struct intr_cpu    intr_cpus[CONFIG_MAX_CPUS];
+
+int     intr_notify_create(struct vm_space *owner);
+void    intr_interrupt(unsigned int vector);
+void    intr_timer_expired(uint64_t now);
+int64_t intr_sys_create(struct syscall_frame *frame);
+int64_t intr_sys_bind(struct syscall_frame *frame);
+int64_t intr_sys_affinity(struct syscall_frame *frame);
+int64_t intr_sys_wait(struct syscall_frame *frame);
+
+#endif /* _KERN_INTR_H */
\ No newline at end of file
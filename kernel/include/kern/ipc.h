@@ -0,0 +1,116 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/ipc.h                                                                         |
+// | Name          : Synchronous IPC (Header)                                                                          |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares endpoints, the register message format and the call/reply-wait fast path.                |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_IPC_H
+#define _KERN_IPC_H
+
+// Layout of struct ipc_frame, in bytes, for the entry stub.
+#define IPC_FRAME_SYS                64
+#define IPC_FRAME_SIZE               160
+
+#ifndef __ASSEMBLER__
+
+#include "arch/syscall.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+struct thread;
+
+/// Message tag, passed in RSI: bits 5:0 give the length in words, bit 6 requests capability transfer and bits 63:16
+/// carry a label the protocol defines. Words 0-3 travel in RDX, R10, R8 and R9; longer messages continue in the
+/// sender's IPC buffer from word IPC_FAST_WORDS on.
+#define IPC_TAG_LENGTH(tag)          ((uint32_t) ((tag) & 0x3F))
+#define IPC_TAG_CAP                  (1ULL << 6)
+#define IPC_TAG_LABEL(tag)           ((tag) >> 16)
+#define IPC_TAG(label, length)       (((uint64_t) (label) << 16) | ((length) & 0x3F))
+
+#define IPC_FAST_WORDS               4
+#define IPC_MAX_WORDS                64
+
+/// Per-thread message buffer for long messages, registered with SYS_IPC_BUFFER. It must not cross a page boundary.
+struct ipc_buffer {
+    uint64_t words[IPC_MAX_WORDS];
+};
+
+/// A rendezvous point. Servers wait in reply_wait on the receiver stack; callers that find no server wait in FIFO
+/// order on the sender queue.
+struct ipc_endpoint {
+    struct spinlock lock;
+    bool            valid;
+    struct thread  *receivers;          ///< servers waiting for a call, most recent first
+    struct thread  *senders;            ///< callers waiting for a server, oldest first
+    struct thread  *senders_tail;
+} __cacheline_aligned;
+
+/// Register state saved by the IPC entry stub: the callee-saved user registers, then the address of ipc_resume, then
+/// the ordinary system call frame. The first seven words are exactly what context_switch() pops, so the frame of a
+/// thread blocked in the fast path is also its saved scheduler context, and either path can resume it.
+struct ipc_frame {
+    uint64_t             r15;
+    uint64_t             r14;
+    uint64_t             r13;
+    uint64_t             r12;
+    uint64_t             rbx;
+    uint64_t             rbp;
+    uint64_t             resume;
+    uint64_t             pad;            ///< keeps sys, and calls made from the stub, 16-byte aligned
+    struct syscall_frame sys;
+};
+
+_Static_assert(offsetof(struct ipc_frame, sys) == IPC_FRAME_SYS, "IPC_FRAME_SYS");
+_Static_assert(sizeof(struct ipc_frame) == IPC_FRAME_SIZE, "IPC_FRAME_SIZE");
+
+/// Result of the fast path: the frame to resume and the thread it replaced, or next == NULL to take the slow path.
+struct ipc_switch {
+    struct ipc_frame *next;
+    struct thread    *prev;
+};
+
+/// IPC counters, kept per CPU and written only by their owner.
+struct ipc_stats {
+    uint64_t fast_calls;
+    uint64_t fast_replies;
+    uint64_t slow_calls;
+    uint64_t slow_replies;
+} __cacheline_aligned;
+
+extern struct ipc_endpoint ipc_endpoints[CONFIG_IPC_ENDPOINTS];
+extern struct ipc_stats    ipc_stats[CONFIG_MAX_CPUS];
+
+int               ipc_endpoint_create(void);
+struct ipc_switch ipc_fastpath(struct ipc_frame *frame);
+int64_t           ipc_sys_call(struct syscall_frame *frame);
+int64_t           ipc_sys_reply_wait(struct syscall_frame *frame);
+int64_t           ipc_sys_buffer(struct syscall_frame *frame);
+
+void              ipc_entry(void);
+void              ipc_resume(void);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _KERN_IPC_H */
\ No newline at end of file
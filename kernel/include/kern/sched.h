@@ -0,0 +1,115 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/sched.h                                                                       |
+// | Name          : Tickless SMP Scheduler (Header)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares per-CPU priority run queues, work stealing and deadline-driven preemption.               |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_SCHED_H
+#define _KERN_SCHED_H
+
+#include "arch/idle.h"
+#include "kern/thread.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+
+_Static_assert((CONFIG_SCHED_QUEUE_SLOTS & (CONFIG_SCHED_QUEUE_SLOTS - 1)) == 0, "queue slots must be a power of two");
+_Static_assert(CONFIG_SCHED_PRIORITIES <= 32, "priority bitmap is 32 bits wide");
+
+/// Bounded single-producer, multi-consumer FIFO of runnable threads. Only the owning CPU appends at tail; the owner and
+/// thieves alike remove from head with a compare-and-swap, so stealing takes no lock and never blocks the owner. The
+/// indices grow without wrapping, which rules out ABA on head. The two indices live on separate cache lines so that
+/// a thief claiming work does not invalidate the line the owner appends to.
+struct sched_ring {
+    uint64_t        head __cacheline_aligned;
+    uint64_t        tail __cacheline_aligned;
+    struct thread  *slots[CONFIG_SCHED_QUEUE_SLOTS];
+};
+
+/// CPU-private FIFO for threads that may not be stolen (pinned threads, and overflow when the ring is full).
+struct sched_list {
+    struct thread  *head;
+    struct thread  *tail;
+};
+
+/// Scheduler event counters, kept per CPU and written only by their owner.
+struct sched_stats {
+    uint64_t        switches;
+    uint64_t        steals;             ///< threads taken from other CPUs' rings
+    uint64_t        remote_wakeups;     ///< threads posted to another CPU's inbox
+    uint64_t        ipis;               ///< reschedule IPIs sent
+    uint64_t        line_wakeups;       ///< CPUs woken from MWAIT by a store, without an IPI
+    uint64_t        timer_arms;         ///< slice timers armed (an idle or uncontended CPU arms none)
+    uint64_t        latency_count;
+    uint64_t        latency_sum;        ///< wake-up to dispatch, in TSC cycles
+    uint64_t        latency_max;
+};
+
+/// Per-CPU run queue. Fields are grouped by writer: the first line is private to the owner, the second is written
+/// by other CPUs (inbox) or published by the owner for them (ready_mask, cur_prio), and each ring pads itself.
+struct runqueue {
+    uint32_t           bitmap;          ///< priorities that may have runnable threads (owner's view)
+    uint32_t           cpu;
+    bool               need_resched;
+    bool               slice_armed;
+    uint64_t           seq;
+    uint64_t           dispatch_tsc;    ///< TSC at which the current thread was dispatched
+    struct thread     *idle;
+    uint64_t           slice_deadline;  ///< TSC at which the armed slice ends
+    uint64_t           event_deadline;  ///< TSC requested with sched_timer_event(), or 0
+    uint64_t           timer_deadline;  ///< TSC the local timer is programmed for, or 0
+
+    struct thread     *inbox __cacheline_aligned;   ///< LIFO stack of threads woken by other CPUs
+    uint32_t           ready_mask;      ///< priorities whose ring may hold stealable threads
+    uint32_t           cur_prio;        ///< priority of the running thread (CONFIG_SCHED_PRIORITIES when idle)
+    struct idle_line   idle_line;       ///< monitored by the owner while idle; wakers write it after the inbox
+
+    struct sched_list  local[CONFIG_SCHED_PRIORITIES] __cacheline_aligned;
+    struct sched_stats stats __cacheline_aligned;
+    struct sched_ring  rings[CONFIG_SCHED_PRIORITIES];
+} __cacheline_aligned;
+
+extern struct runqueue runqueues[CONFIG_MAX_CPUS];
+extern struct cpumask  sched_idle_cpus;
+
+void sched_init_cpu(unsigned int cpu, struct thread *idle);
+int  sched_thread_init(struct thread *t, void (*entry)(void *), void *arg, void *stack_top, uint8_t priority,
+                       uint8_t flags);
+void sched_add(struct thread *t, unsigned int cpu);
+bool sched_wake(struct thread *t);
+void sched_prepare_block(void);
+void sched_block(void);
+void sched_yield(void);
+void schedule(void);
+void sched_preempt(void);
+noreturn void sched_idle(void);
+noreturn void sched_exit(void);
+void sched_finish_switch(struct thread *prev);
+bool sched_can_handoff(const struct thread *next);
+void sched_handoff(struct thread *prev, struct thread *next);
+void sched_timer_event(uint64_t deadline);
+void sched_timer_interrupt(void);
+void sched_ipi_interrupt(void);
+
+#endif /* _KERN_SCHED_H */
\ No newline at end of file
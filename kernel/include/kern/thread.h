@@ -0,0 +1,82 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/kern/thread.h                                                                      |
+// | Name          : Kernel Thread Control Block                                                                       |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Defines the per-thread state shared by the scheduler and the architecture layer.                  |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _KERN_THREAD_H
+#define _KERN_THREAD_H
+
+#include "sys/cdefs.h"
+#include "sys/freestd.h"
+
+struct fpu_state;
+struct ipc_endpoint;
+struct ipc_frame;
+struct pmu_context;
+struct syscall_frame;
+struct vm_space;
+
+enum thread_state {
+    THREAD_RUNNABLE,                    ///< queued on some CPU's run queue, or in transit to one
+    THREAD_RUNNING,
+    THREAD_BLOCKED,
+    THREAD_DEAD,
+};
+
+#define THREAD_PINNED                0x01       /* never migrated by work stealing */
+#define THREAD_PRIVILEGED            0x02       /* a trusted server: may open performance counters and drain samples */
+
+/// Thread control block. The fields read on every switch share the first cache line; storage is owned by the creator
+/// and must stay valid until the thread has exited and been switched away from (on_cpu == 0).
+struct thread {
+    uint64_t        rsp;                ///< saved kernel stack pointer while switched out
+    uint64_t        kstack_top;         ///< kernel stack loaded on entry from user mode, or 0 for kernel-only threads
+    struct thread  *next;               ///< link in a wake-up inbox or a CPU-local run list
+    uint64_t        seq;                ///< enqueue stamp, used to keep FIFO order across a CPU's run lists
+    uint32_t        state;              ///< enum thread_state, updated atomically by wakers
+    uint32_t        on_cpu;             ///< set while a processor is executing on this thread's stack
+    uint16_t        cpu;                ///< CPU that last ran or queued the thread
+    uint8_t         priority;           ///< 0 is the most urgent
+    uint8_t         flags;              ///< THREAD_* flags
+    uint8_t         perf_policy;        ///< enum pstate_policy the thread asks for wherever it runs
+    uint8_t         reserved[3];
+    uint64_t        wake_tsc;           ///< TSC at the last wake-up, for dispatch-latency accounting
+    uint64_t        runtime;            ///< accumulated execution time, in TSC cycles
+
+    struct fpu_state   *fpu;            ///< extended (x87/SIMD) state, or NULL until the thread first uses it
+    struct vm_space    *vm;             ///< address space, or NULL for kernel-only threads (they borrow the loaded one)
+    uint64_t            fs_base;        ///< user FS base, as of the last switch away from the thread
+    uint64_t            gs_base;        ///< user GS base, as of the last switch away from the thread
+    struct pmu_context *pmu;            ///< performance counters that follow the thread, or NULL
+    uint32_t            id;             ///< unique identifier assigned by sched_thread_init(), 0 for idle threads
+
+    struct thread        *ipc_next;     ///< link in an endpoint or channel wait queue
+    struct thread        *ipc_partner;  ///< caller owed a reply by this thread
+    struct syscall_frame *ipc_regs;     ///< registers of the IPC system call this thread is blocked in
+    struct ipc_frame     *ipc_frame;    ///< set while blocked through the fast path, which may then resume it directly
+    uint64_t              ipc_buffer;   ///< user address of the registered message buffer, or 0
+    uint64_t              ipc_badge;    ///< identifies this thread to the servers it calls
+} __cacheline_aligned;
+
+#endif /* _KERN_THREAD_H */
\ No newline at end of file
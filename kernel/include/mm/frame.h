@@ -0,0 +1,128 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/frame.h                                                                         |
+// | Name          : Physical Frame Allocator (Header)                                                                 |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the NUMA-aware buddy allocator for physical frames and its per-CPU magazines.            |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_FRAME_H
+#define _MM_FRAME_H
+
+#include "mm/layout.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+#define FRAME_NONE                   UINT32_MAX     /* null frame index in free lists */
+#define FRAME_NODE_LOCAL             UINT32_MAX     /* allocate from the calling CPU's node */
+
+#define FRAME_FREE                   0x01           /* first frame of a free buddy block */
+#define FRAME_RESERVED               0x02           /* firmware, hole or allocator metadata; never allocated */
+#define FRAME_CACHED                 0x04           /* free, but held in a per-CPU magazine */
+
+/// Frame descriptor, one per 4 KiB frame between the lowest and highest usable addresses. Free lists are threaded
+/// through these 16-byte descriptors by 32-bit index, four to a cache line, rather than through the free pages
+/// themselves, so allocating and coalescing never touch cold page contents.
+struct frame {
+    uint32_t next;                      ///< next block of the same order in the free list
+    uint32_t prev;                      ///< previous block of the same order in the free list
+    uint8_t  order;                     ///< block order while FRAME_FREE; allocation order otherwise
+    uint8_t  flags;                     ///< FRAME_* flags
+    uint16_t node;
+    uint32_t owner;                     ///< available to the frame's owner, e.g. a slab cache index
+};
+
+_Static_assert(sizeof(struct frame) == 16, "struct frame must stay 16 bytes");
+
+/// Buddy free lists of one NUMA node.
+struct frame_zone {
+    struct spinlock lock;
+    uint32_t        free_head[CONFIG_FRAME_ORDERS];
+    uint64_t        nr_free[CONFIG_FRAME_ORDERS];   ///< free blocks of each order
+    uint64_t        free_frames;                    ///< frames on the free lists, excluding magazines
+    uint64_t        total_frames;
+    uint64_t        allocs;                         ///< blocks taken from the free lists
+    uint64_t        frees;                          ///< blocks returned to the free lists
+} __cacheline_aligned;
+
+/// A stack of free frame indices owned by one CPU.
+struct frame_magazine {
+    uint32_t rounds;
+    uint32_t frames[CONFIG_FRAME_MAGAZINE_SIZE];
+};
+
+/// Per-CPU front end. Single-frame allocations and frees are served from the loaded magazine, falling back to the
+/// previous one; only when both are exhausted (or both full) is the node's lock taken, for a whole magazine at once.
+struct frame_cpu {
+    struct frame_magazine *loaded;
+    struct frame_magazine *previous;
+    uint32_t               node;
+    uint64_t               allocs;
+    uint64_t               frees;
+    uint64_t               refills;         ///< magazines filled from the buddy lists
+    uint64_t               drains;          ///< magazines emptied into the buddy lists
+    uint64_t               remote_frees;    ///< frames of another node returned straight to their own node
+    struct frame_magazine  mags[2];
+} __cacheline_aligned;
+
+/// Location and extent of the frame descriptor array.
+struct frame_map {
+    struct frame *frames;
+    uint64_t      base_pfn;             ///< page frame number of frames[0], aligned to the largest block
+    uint64_t      nr_frames;
+    uint64_t      meta_phys;            ///< physical address of the descriptor array
+    uint64_t      meta_pages;
+};
+
+extern struct frame_map  frame_map;
+extern struct frame_zone frame_zones[CONFIG_MAX_NODES];
+extern struct frame_cpu  frame_cpus[CONFIG_MAX_CPUS];
+
+int      frame_init(const void *map, size_t map_size, size_t desc_size);
+void     frame_init_cpu(unsigned int cpu);
+uint64_t frame_alloc(void);
+uint64_t frame_alloc_order(unsigned int order, uint32_t node);
+void     frame_free(uint64_t phys);
+void     frame_free_order(uint64_t phys, unsigned int order);
+
+/// @fn      static inline struct frame *frame_of(uint64_t phys)
+/// @brief   Returns the descriptor of the frame containing a physical address.
+///
+/// @param   phys a physical address inside managed memory
+/// @returns the frame descriptor
+static __always_inline struct frame *frame_of(uint64_t phys)
+{
+    return &frame_map.frames[(phys >> PAGE_SHIFT) - frame_map.base_pfn];
+}
+
+/// @fn      static inline uint64_t frame_phys(const struct frame *f)
+/// @brief   Returns the physical address of the frame a descriptor describes.
+///
+/// @param   f the frame descriptor
+/// @returns the frame's physical address
+static __always_inline uint64_t frame_phys(const struct frame *f)
+{
+    return ((uint64_t) (f - frame_map.frames) + frame_map.base_pfn) << PAGE_SHIFT;
+}
+
+#endif /* _MM_FRAME_H */
\ No newline at end of file
@@ -0,0 +1,62 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/layout.h                                                                        |
+// | Name          : Virtual Memory Layout                                                                             |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Defines the page size and the direct map through which the kernel addresses physical memory.      |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_LAYOUT_H
+#define _MM_LAYOUT_H
+
+#include "sys/cdefs.h"
+#include "sys/freestd.h"
+
+#define PAGE_SHIFT                   12
+#define PAGE_SIZE                    (1ULL << PAGE_SHIFT)
+#define PAGE_MASK                    (~(PAGE_SIZE - 1))
+
+/// Base of the direct map, a linear mapping of all physical memory at the start of the upper canonical half (PML4
+/// slot 256). The boot loader's mapping is used until vm_init() rebuilds it with huge pages; it is kept in every
+/// address space.
+#define DIRECT_MAP_BASE              0xFFFF800000000000ULL
+
+/// @fn      static inline void *phys_to_virt(uint64_t phys)
+/// @brief   Returns the direct-map address of a physical address.
+///
+/// @param   phys the physical address
+/// @returns the kernel virtual address through which phys is accessible
+static __always_inline void *phys_to_virt(uint64_t phys)
+{
+    return (void *) (phys + DIRECT_MAP_BASE);
+}
+
+/// @fn      static inline uint64_t virt_to_phys(const void *virt)
+/// @brief   Returns the physical address behind a direct-map address.
+///
+/// @param   virt a kernel virtual address inside the direct map
+/// @returns the corresponding physical address
+static __always_inline uint64_t virt_to_phys(const void *virt)
+{
+    return (uint64_t) virt - DIRECT_MAP_BASE;
+}
+
+#endif /* _MM_LAYOUT_H */
\ No newline at end of file
@@ -0,0 +1,65 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/numa.h                                                                          |
+// | Name          : NUMA Topology (Header)                                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the memory and processor affinity parsed from the ACPI System Resource Affinity Table.   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_NUMA_H
+#define _MM_NUMA_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+#define NUMA_MAX_RANGES              64
+
+/// A physical address range local to one node.
+struct numa_range {
+    uint64_t base;
+    uint64_t end;
+    uint32_t node;
+};
+
+/// A processor's node, keyed by APIC ID because the SRAT is parsed before the processors are numbered.
+struct numa_cpu {
+    uint32_t apic_id;
+    uint32_t node;
+};
+
+/// System topology. Without an SRAT there is one node holding all memory and all processors.
+struct numa_info {
+    uint32_t          nr_nodes;
+    uint32_t          nr_ranges;
+    uint32_t          nr_cpus;
+    uint32_t          domain[CONFIG_MAX_NODES];     ///< ACPI proximity domain of each node
+    struct numa_range ranges[NUMA_MAX_RANGES];
+    struct numa_cpu   cpus[CONFIG_MAX_CPUS];
+};
+
+extern struct numa_info numa_info;
+
+int      numa_init(const void *srat);
+uint32_t numa_node_of_apic(uint32_t apic_id);
+uint32_t numa_node_of_phys(uint64_t phys, uint64_t *end);
+
+#endif /* _MM_NUMA_H */
\ No newline at end of file
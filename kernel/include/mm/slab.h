@@ -0,0 +1,127 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/slab.h                                                                          |
+// | Name          : Slab Allocator (Header)                                                                           |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares object caches with per-CPU object stacks, slab coloring and constructed objects.         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_SLAB_H
+#define _MM_SLAB_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+#define SLAB_MIN_ALIGN               8
+#define SLAB_MAX_ORDER               3              /* slabs span at most 8 pages */
+#define SLAB_CPU_OBJECTS             29             /* fills struct slab_cpu to four cache lines */
+#define SLAB_BATCH                   16             /* objects moved per refill or flush */
+
+/// Alignment and padded size of the objects of a type, as compile-time constants.
+#define SLAB_ALIGN(type)             (_Alignof(type) > SLAB_MIN_ALIGN ? _Alignof(type) : SLAB_MIN_ALIGN)
+#define SLAB_SIZE(type)              ((sizeof(type) + SLAB_ALIGN(type) - 1) & ~(SLAB_ALIGN(type) - 1))
+
+/// Declares a typed cache and its cache##_alloc() and cache##_free() accessors. Use in a header.
+#define SLAB_CACHE_DECLARE(cache, obj_type)                                                                         \
+    extern struct slab_cache cache##_cache;                                                                         \
+    static __always_inline obj_type *cache##_alloc(void) { return (obj_type *) slab_alloc(&cache##_cache); }        \
+    static __always_inline void cache##_free(obj_type *obj) { slab_free(&cache##_cache, obj); }
+
+/// Defines a typed cache. obj_ctor, if not NULL, is a void (*)(void *) run once on each object when its slab is made.
+#define SLAB_CACHE_DEFINE(cache, obj_type, obj_ctor)                                                                \
+    struct slab_cache cache##_cache = {                                                                             \
+        .name  = #cache,                                                                                            \
+        .size  = SLAB_SIZE(obj_type),                                                                               \
+        .align = SLAB_ALIGN(obj_type),                                                                              \
+        .ctor  = (obj_ctor),                                                                                        \
+        .lock  = SPINLOCK_INIT,                                                                                     \
+    }
+
+/// Slab header, at the start of the naturally aligned block of pages that holds the slab's objects. The free
+/// object indices live in the header rather than in the objects, so a freed object keeps its constructed state.
+struct slab {
+    struct slab        *next;
+    struct slab        *prev;
+    struct slab_cache  *cache;
+    uint16_t            inuse;
+    uint16_t            nr_free;
+    uint16_t            color;          ///< byte offset added to the first object
+    uint16_t            reserved;
+    uint16_t            free[];         ///< stack of free object indices
+};
+
+/// Per-CPU object stack. Allocations and frees are served here with interrupts disabled and without the cache lock.
+struct slab_cpu {
+    uint32_t avail;
+    uint32_t reserved;
+    uint64_t allocs;
+    uint64_t frees;
+    void    *objs[SLAB_CPU_OBJECTS];
+} __cacheline_aligned;
+
+/// An object cache. The first line is read-only after slab_cache_init(); the second is written under the lock.
+struct slab_cache {
+    const char         *name;
+    uint32_t            size;           ///< object size, padded to the alignment
+    uint32_t            align;
+    void              (*ctor)(void *);
+    struct slab_cpu    *cpus;           ///< CONFIG_MAX_CPUS object stacks
+    uint16_t            order;          ///< slab size is PAGE_SIZE << order
+    uint16_t            objects;        ///< objects per slab
+    uint16_t            offset;         ///< offset of the first object before coloring
+    uint16_t            colors;         ///< number of distinct color offsets
+    struct slab_cache  *next;           ///< link in slab_caches
+
+    struct spinlock     lock __cacheline_aligned;
+    uint16_t            color_next;
+    struct slab        *partial;        ///< slabs with both free and allocated objects
+    struct slab        *empty;          ///< at most one fully free slab, kept to absorb alloc/free churn
+    uint64_t            slabs;
+    uint64_t            slabs_created;
+    uint64_t            slabs_destroyed;
+    uint64_t            refills;
+    uint64_t            flushes;
+};
+
+/// Snapshot of a cache's counters, for sizing caches and spotting leaks.
+struct slab_stats {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t in_use;                    ///< objects handed out and not yet freed
+    uint64_t cached;                    ///< free objects held in per-CPU stacks
+    uint64_t slabs;
+    uint64_t bytes;                     ///< memory held by the cache's slabs
+    uint64_t slabs_created;
+    uint64_t slabs_destroyed;
+    uint64_t refills;
+    uint64_t flushes;
+};
+
+extern struct slab_cache *slab_caches;
+
+int   slab_cache_init(struct slab_cache *cache);
+void *slab_alloc(struct slab_cache *cache);
+void  slab_free(struct slab_cache *cache, void *obj);
+void  slab_cache_stats(const struct slab_cache *cache, struct slab_stats *stats);
+
+#endif /* _MM_SLAB_H */
\ No newline at end of file
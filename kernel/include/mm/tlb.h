@@ -0,0 +1,95 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/tlb.h                                                                           |
+// | Name          : TLB Shootdown (Header)                                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares batched TLB invalidation across the processors running an address space.                 |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_TLB_H
+#define _MM_TLB_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+
+struct vm_space;
+
+#define TLB_BATCH_RANGES             8
+#define TLB_FLUSH_MAX_PAGES          32             /* larger batches drop the whole PCID instead of page by page */
+
+/// A virtual address range, end exclusive.
+struct tlb_range {
+    uint64_t start;
+    uint64_t end;
+};
+
+/// Invalidations collected while unmapping, sent to other processors in one round by tlb_flush(). Adjacent ranges are
+/// merged; a batch that outgrows its ranges or TLB_FLUSH_MAX_PAGES degrades to a full flush of the space.
+struct tlb_batch {
+    struct vm_space  *space;
+    uint64_t          gen;              ///< the space's generation once the batch is flushed
+    uint32_t          nr;
+    uint32_t          pages;
+    bool              full;
+    struct tlb_range  ranges[TLB_BATCH_RANGES];
+};
+
+/// Per-CPU shootdown state. Each line has a single writer: the request is written by this CPU as initiator, the
+/// pending set by initiators targeting this CPU, and the acknowledgements by this CPU as target, one word per
+/// initiator, so waiting initiators poll lines nobody else writes.
+struct tlb_cpu {
+    struct tlb_batch req;               ///< this CPU's outstanding request, stable until every target has acked
+    uint32_t         seq;               ///< number of requests this CPU has sent
+    uint64_t         shootdowns;        ///< flushes that needed other processors
+    uint64_t         targets;           ///< processors interrupted by those shootdowns
+    uint64_t         local_flushes;     ///< batches invalidated on this CPU, as initiator or target
+    uint64_t         full_flushes;      ///< of those, how many dropped the whole space
+    uint64_t         handled;           ///< requests from other processors served
+
+    struct cpumask   pending __cacheline_aligned;           ///< initiators whose request awaits this CPU
+    uint32_t         acks[CONFIG_MAX_CPUS] __cacheline_aligned;  ///< seq of the last request served, per initiator
+} __cacheline_aligned;
+
+extern struct tlb_cpu tlb_cpus[CONFIG_MAX_CPUS];
+
+void tlb_init_cpu(unsigned int cpu);
+void tlb_batch_add(struct tlb_batch *batch, uint64_t va, uint64_t size);
+void tlb_flush(struct tlb_batch *batch);
+void tlb_shootdown_interrupt(void);
+
+/// @fn      static inline void tlb_batch_init(struct tlb_batch *batch, struct vm_space *space)
+/// @brief   Starts an empty batch of invalidations for an address space.
+///
+/// @param   batch the batch
+/// @param   space the address space being changed
+/// @returns None (void)
+static __always_inline void tlb_batch_init(struct tlb_batch *batch, struct vm_space *space)
+{
+    batch->space = space;
+    batch->gen   = 0;
+    batch->nr    = 0;
+    batch->pages = 0;
+    batch->full  = false;
+}
+
+#endif /* _MM_TLB_H */
\ No newline at end of file
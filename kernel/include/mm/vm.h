@@ -0,0 +1,106 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/mm/vm.h                                                                            |
+// | Name          : Address Spaces (Header)                                                                           |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the page-table manager, PCID-tagged address spaces and the huge-page direct map.         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _MM_VM_H
+#define _MM_VM_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/cpumask.h"
+#include "sys/freestd.h"
+#include "sys/spinlock.h"
+
+struct tlb_batch;
+
+/// An address space. The upper half is shared with vm_kernel: its top-level entries are copied at creation and the
+/// tables below them are never freed, so kernel mappings made later are visible everywhere without synchronization.
+struct vm_space {
+    uint64_t        root;               ///< physical address of the top-level table (PML4, or PML5 with LA57)
+    uint64_t        id;                 ///< unique for the kernel's lifetime, unlike the address of this structure
+    uint64_t        tlb_gen;            ///< bumped after every change that requires a TLB invalidation
+    struct cpumask  active;             ///< CPUs with this space loaded in CR3, the targets of its shootdowns
+    struct spinlock lock;               ///< serializes changes to the page tables
+    uint8_t         spec_label;         ///< trust label selecting the speculation policy, see arch/spec.h
+};
+
+/// A processor's view of one of its PCIDs: which space last used it and the generation its TLB entries reflect.
+struct vm_pcid {
+    uint64_t id;
+    uint64_t gen;
+};
+
+/// Per-CPU address-space state.
+struct vm_cpu {
+    struct vm_space *current;           ///< space loaded in CR3
+    uint32_t         slot;              ///< index in pcids[] of current (unused for vm_kernel)
+    uint32_t         next_slot;         ///< round-robin victim for the next space without a PCID here
+    struct vm_pcid   pcids[CONFIG_VM_PCID_SLOTS];
+    uint64_t         switches;
+    uint64_t         pcid_hits;         ///< switches that kept the TLB entries of the incoming space
+} __cacheline_aligned;
+
+/// Paging features, fixed by vm_init().
+struct vm_config {
+    uint32_t levels;                    ///< 4, or 5 when the boot loader enabled LA57
+    bool     pcid;
+    bool     invpcid;
+    bool     gbpages;                   ///< 1 GiB pages may be used
+    uint64_t nx;                        ///< PTE_NX when EFER.NXE is available, otherwise 0
+    uint64_t user_end;                  ///< first address above the lower canonical half
+};
+
+extern struct vm_config vm_config;
+extern struct vm_space  vm_kernel;
+extern struct vm_cpu    vm_cpus[CONFIG_MAX_CPUS];
+
+int  vm_init(const void *map, size_t map_size, size_t desc_size);
+void vm_init_cpu(unsigned int cpu);
+int  vm_space_init(struct vm_space *space);
+void vm_space_destroy(struct vm_space *space);
+int  vm_map(struct vm_space *space, uint64_t va, uint64_t pa, uint64_t size, uint64_t flags);
+int  vm_unmap(struct vm_space *space, uint64_t va, uint64_t size);
+int  vm_unmap_batch(struct vm_space *space, uint64_t va, uint64_t size, struct tlb_batch *batch);
+int  vm_translate(struct vm_space *space, uint64_t va, uint64_t *pa, uint64_t *flags);
+int  vm_copy_out(struct vm_space *space, uint64_t va, const void *src, size_t size);
+int  vm_copy_in(struct vm_space *space, uint64_t va, void *dst, size_t size);
+void vm_switch(unsigned int cpu, struct vm_space *next);
+
+/// @fn      static inline void vm_switch_to(unsigned int cpu, struct vm_space *space)
+/// @brief   Loads a thread's address space on the executing processor unless it is already loaded.
+///
+/// @details Kernel-only threads (space == NULL) run on whatever space is loaded, so switching through them to a thread
+/// of the same space costs no CR3 write at all.
+///
+/// @param   cpu   the executing processor's logical CPU index
+/// @param   space the incoming thread's address space, or NULL
+/// @returns None (void)
+static __always_inline void vm_switch_to(unsigned int cpu, struct vm_space *space)
+{
+    if (space && space != vm_cpus[cpu].current)
+        vm_switch(cpu, space);
+}
+
+#endif /* _MM_VM_H */
\ No newline at end of file
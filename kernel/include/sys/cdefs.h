@@ -0,0 +1,45 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/cdefs.h                                                                        |
+// | Name          : Compiler Attribute & Layout Definitions                                                           |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides shorthand macros for GCC/Clang attributes used throughout the kernel.                    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_CDEFS_H
+#define _SYS_CDEFS_H
+
+/// Size, in bytes, of a cache line on every x86-64 implementation the kernel targets. Used to separate data written by
+/// different CPUs so that independent stores never contend for the same line.
+#define CACHE_LINE_SIZE      64
+
+#define __always_inline      inline __attribute__((always_inline))
+#define __noinline           __attribute__((noinline))
+#define __aligned(x)         __attribute__((aligned(x)))
+#define __cacheline_aligned  __attribute__((aligned(CACHE_LINE_SIZE)))
+#define __packed             __attribute__((packed))
+#define __section(s)         __attribute__((section(s)))
+#define __unused             __attribute__((unused))
+
+#define likely(x)            __builtin_expect(!!(x), 1)
+#define unlikely(x)          __builtin_expect(!!(x), 0)
+
+#endif /* _SYS_CDEFS_H */
\ No newline at end of file
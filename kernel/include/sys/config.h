@@ -0,0 +1,73 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/config.h                                                                       |
+// | Name          : Kernel Build Configuration                                                                        |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides compile-time limits and tunables shared across kernel subsystems.                        |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_CONFIG_H
+#define _SYS_CONFIG_H
+
+/// Maximum number of logical processors the kernel will bring up. Per-CPU arrays are statically sized by this value.
+#define CONFIG_MAX_CPUS              256
+
+/// Size, in bytes, of each per-CPU interrupt stack selected through the TSS IST mechanism (NMI, #DF, #MC).
+#define CONFIG_IST_STACK_SIZE        8192
+
+/// Size, in bytes, of each per-CPU kernel stack used on entry from user mode.
+#define CONFIG_KERNEL_STACK_SIZE     16384
+
+/// Number of scheduling priorities. Priority 0 is the most urgent; the idle thread runs below the lowest.
+#define CONFIG_SCHED_PRIORITIES      16
+
+/// Capacity of each per-CPU, per-priority stealable run-queue ring. Must be a power of two.
+#define CONFIG_SCHED_QUEUE_SLOTS     64
+
+/// Round-robin time slice, in nanoseconds, among runnable threads of equal priority.
+#define CONFIG_SCHED_SLICE_NS        4000000
+
+/// Minimum interval, in nanoseconds, between two frequency/thermal telemetry samples on the same CPU.
+#define CONFIG_TELEMETRY_INTERVAL_NS 10000000
+
+/// Maximum number of NUMA nodes. Proximity domains reported by the ACPI SRAT are numbered densely from 0.
+#define CONFIG_MAX_NODES             8
+
+/// Number of buddy orders. The largest physical block the frame allocator manages is 2^(CONFIG_FRAME_ORDERS - 1) pages.
+#define CONFIG_FRAME_ORDERS          11
+
+/// Frames held by each per-CPU magazine. Must be a power of two no larger than the largest buddy block.
+#define CONFIG_FRAME_MAGAZINE_SIZE   32
+
+/// Number of PCIDs each processor rotates among user address spaces. A CPU alternating between up to this many spaces
+/// switches without flushing their TLB entries.
+#define CONFIG_VM_PCID_SLOTS         8
+
+/// Number of IPC endpoints. Endpoint handles are indices into a static table.
+#define CONFIG_IPC_ENDPOINTS         256
+
+/// Number of shared-memory channels. Channel handles are indices into a static table.
+#define CONFIG_CHANNELS              256
+
+/// Number of interrupt notification words. Handles are indices into a static table.
+#define CONFIG_INTR_NOTIFIES         64
+
+#endif /* _SYS_CONFIG_H */
\ No newline at end of file
@@ -0,0 +1,148 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/cpumask.h                                                                      |
+// | Name          : CPU Set Bitmaps                                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides fixed-size bitmaps of logical CPUs with plain and atomic update operations.              |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_CPUMASK_H
+#define _SYS_CPUMASK_H
+
+#include "sys/cdefs.h"
+#include "sys/config.h"
+#include "sys/freestd.h"
+
+#define CPUMASK_WORDS                ((CONFIG_MAX_CPUS + 63) / 64)
+
+struct cpumask {
+    uint64_t bits[CPUMASK_WORDS];
+};
+
+/// @fn      static inline void cpumask_clear_all(struct cpumask *mask)
+/// @brief   Empties a CPU set.
+///
+/// @param   mask the set to empty
+/// @returns None (void)
+static __always_inline void cpumask_clear_all(struct cpumask *mask)
+{
+    for (unsigned int i = 0; i < CPUMASK_WORDS; i++)
+        mask->bits[i] = 0;
+}
+
+/// @fn      static inline bool cpumask_test(const struct cpumask *mask, unsigned int cpu)
+/// @brief   Tests whether a CPU is a member of a set.
+///
+/// @param   mask the set to test
+/// @param   cpu  the logical CPU index
+/// @returns true if cpu is in the set, otherwise false
+static __always_inline bool cpumask_test(const struct cpumask *mask, unsigned int cpu)
+{
+    return (__atomic_load_n(&mask->bits[cpu / 64], __ATOMIC_RELAXED) >> (cpu % 64)) & 1;
+}
+
+/// @fn      static inline void cpumask_set(struct cpumask *mask, unsigned int cpu)
+/// @brief   Adds a CPU to a set. Not atomic with respect to concurrent updates of the same word.
+///
+/// @param   mask the set to update
+/// @param   cpu  the logical CPU index
+/// @returns None (void)
+static __always_inline void cpumask_set(struct cpumask *mask, unsigned int cpu)
+{
+    mask->bits[cpu / 64] |= 1ULL << (cpu % 64);
+}
+
+/// @fn      static inline void cpumask_clear(struct cpumask *mask, unsigned int cpu)
+/// @brief   Removes a CPU from a set. Not atomic with respect to concurrent updates of the same word.
+///
+/// @param   mask the set to update
+/// @param   cpu  the logical CPU index
+/// @returns None (void)
+static __always_inline void cpumask_clear(struct cpumask *mask, unsigned int cpu)
+{
+    mask->bits[cpu / 64] &= ~(1ULL << (cpu % 64));
+}
+
+/// @fn      static inline void cpumask_set_atomic(struct cpumask *mask, unsigned int cpu)
+/// @brief   Adds a CPU to a set shared with other processors.
+///
+/// @details The word is read first and the locked RMW skipped when the bit is already set, so a CPU repeatedly marking
+/// itself (as on every address-space switch) does not keep pulling the line into exclusive state.
+///
+/// @param   mask the set to update
+/// @param   cpu  the logical CPU index
+/// @returns None (void)
+static __always_inline void cpumask_set_atomic(struct cpumask *mask, unsigned int cpu)
+{
+    if (!cpumask_test(mask, cpu))
+        __atomic_fetch_or(&mask->bits[cpu / 64], 1ULL << (cpu % 64), __ATOMIC_RELAXED);
+}
+
+/// @fn      static inline void cpumask_clear_atomic(struct cpumask *mask, unsigned int cpu)
+/// @brief   Removes a CPU from a set shared with other processors.
+///
+/// @param   mask the set to update
+/// @param   cpu  the logical CPU index
+/// @returns None (void)
+static __always_inline void cpumask_clear_atomic(struct cpumask *mask, unsigned int cpu)
+{
+    if (cpumask_test(mask, cpu))
+        __atomic_fetch_and(&mask->bits[cpu / 64], ~(1ULL << (cpu % 64)), __ATOMIC_RELAXED);
+}
+
+/// @fn      static inline bool cpumask_test_and_clear_atomic(struct cpumask *mask, unsigned int cpu)
+/// @brief   Removes a CPU from a shared set and reports whether this caller was the one to remove it.
+///
+/// @param   mask the set to update
+/// @param   cpu  the logical CPU index
+/// @returns true if cpu was in the set and this call cleared it, otherwise false
+static __always_inline bool cpumask_test_and_clear_atomic(struct cpumask *mask, unsigned int cpu)
+{
+    uint64_t bit = 1ULL << (cpu % 64);
+
+    if (!cpumask_test(mask, cpu))
+        return false;
+    return __atomic_fetch_and(&mask->bits[cpu / 64], ~bit, __ATOMIC_SEQ_CST) & bit;
+}
+
+/// @fn      static inline int cpumask_next(const struct cpumask *mask, int cpu)
+/// @brief   Finds the next member of a set after a given CPU.
+///
+/// @param   mask the set to search
+/// @param   cpu  the CPU to start after, or -1 to start from the beginning
+/// @returns the next member's index, or CONFIG_MAX_CPUS if there is none
+static __always_inline int cpumask_next(const struct cpumask *mask, int cpu)
+{
+    unsigned int next = (unsigned int) (cpu + 1);
+
+    while (next < CONFIG_MAX_CPUS) {
+        uint64_t word = __atomic_load_n(&mask->bits[next / 64], __ATOMIC_RELAXED) >> (next % 64);
+        if (word)
+            return (int) (next + __builtin_ctzll(word));
+        next = (next | 63) + 1;
+    }
+    return CONFIG_MAX_CPUS;
+}
+
+#define for_each_cpu(cpu, mask) \
+    for ((cpu) = cpumask_next((mask), -1); (cpu) < CONFIG_MAX_CPUS; (cpu) = cpumask_next((mask), (cpu)))
+
+#endif /* _SYS_CPUMASK_H */
\ No newline at end of file
@@ -0,0 +1,69 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/efi.h                                                                          |
+// | Name          : UEFI Definitions                                                                                  |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Declares the UEFI structures and constants the kernel consumes after ExitBootServices().          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_EFI_H
+#define _SYS_EFI_H
+
+#include "sys/freestd.h"
+
+/* Table 7-10, UEFI Specification 2.10 */
+#define EFI_RESERVED_MEMORY_TYPE     0
+#define EFI_LOADER_CODE              1
+#define EFI_LOADER_DATA              2
+#define EFI_BOOT_SERVICES_CODE       3
+#define EFI_BOOT_SERVICES_DATA       4
+#define EFI_RUNTIME_SERVICES_CODE    5
+#define EFI_RUNTIME_SERVICES_DATA    6
+#define EFI_CONVENTIONAL_MEMORY      7
+#define EFI_UNUSABLE_MEMORY          8
+#define EFI_ACPI_RECLAIM_MEMORY      9
+#define EFI_ACPI_MEMORY_NVS          10
+#define EFI_MEMORY_MAPPED_IO         11
+#define EFI_MEMORY_MAPPED_IO_PORT    12
+#define EFI_PAL_CODE                 13
+#define EFI_PERSISTENT_MEMORY        14
+#define EFI_UNACCEPTED_MEMORY        15
+
+#define EFI_MEMORY_UC                0x0000000000000001ULL
+#define EFI_MEMORY_WC                0x0000000000000002ULL
+#define EFI_MEMORY_WT                0x0000000000000004ULL
+#define EFI_MEMORY_WB                0x0000000000000008ULL
+#define EFI_MEMORY_RUNTIME           0x8000000000000000ULL
+
+#define EFI_PAGE_SHIFT               12
+
+/// One entry of the map returned by GetMemoryMap(). Entries are DescriptorSize bytes apart, which may exceed the size
+/// of this structure, so a map must be walked with the size the firmware reported.
+struct efi_memory_descriptor {
+    uint32_t type;
+    uint32_t padding;
+    uint64_t physical_start;
+    uint64_t virtual_start;
+    uint64_t number_of_pages;
+    uint64_t attribute;
+};
+
+#endif /* _SYS_EFI_H */
\ No newline at end of file
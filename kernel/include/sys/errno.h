@@ -0,0 +1,46 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/errno.h                                                                        |
+// | Name          : Kernel Error Codes                                                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Contains the error numbers returned, negated, by fallible kernel functions.                       |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_ERRNO_H
+#define _SYS_ERRNO_H
+
+// Fallible kernel functions return 0 (or a non-negative result) on success and a negated error number on failure.
+#define EPERM                        1
+#define ENOENT                       2
+#define EAGAIN                       11
+#define ENOMEM                       12
+#define EFAULT                       14
+#define EBUSY                        16
+#define EEXIST                       17
+#define ENODEV                       19
+#define EINVAL                       22
+#define ENOSPC                       28
+#define ERANGE                       34
+#define ENOSYS                       38
+#define EOPNOTSUPP                   95
+#define ETIMEDOUT                    110
+
+#endif /* _SYS_ERRNO_H */
\ No newline at end of file
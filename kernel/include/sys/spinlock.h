@@ -0,0 +1,64 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/include/sys/spinlock.h                                                                     |
+// | Name          : Spinlock                                                                                          |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides a minimal test-and-test-and-set spinlock for short, non-sleeping critical sections.      |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _SYS_SPINLOCK_H
+#define _SYS_SPINLOCK_H
+
+#include "sys/cdefs.h"
+#include "sys/freestd.h"
+
+/// Test-and-test-and-set lock. Waiters spin on a plain load, so a held lock costs its waiters only shared-line reads
+/// rather than a stream of locked writes. Holders must not block and should disable interrupts if the lock can also be
+/// taken from an interrupt handler.
+struct spinlock {
+    uint32_t locked;
+};
+
+#define SPINLOCK_INIT                { 0 }
+
+/// @fn      static inline void spin_lock(struct spinlock *lock)
+/// @brief   Acquires a spinlock, waiting as long as necessary.
+///
+/// @param   lock the lock to acquire
+/// @returns None (void)
+static __always_inline void spin_lock(struct spinlock *lock)
+{
+    while (__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE))
+        while (__atomic_load_n(&lock->locked, __ATOMIC_RELAXED))
+            __builtin_ia32_pause();
+}
+
+/// @fn      static inline void spin_unlock(struct spinlock *lock)
+/// @brief   Releases a spinlock held by the caller.
+///
+/// @param   lock the lock to release
+/// @returns None (void)
+static __always_inline void spin_unlock(struct spinlock *lock)
+{
+    __atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+}
+
+#endif /* _SYS_SPINLOCK_H */
\ No newline at end of file
@@ -0,0 +1,293 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/apic.c                                                                            |
+// | Name          : x86 Local APIC Driver (Source)                                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Enables the x2APIC (or xAPIC fallback), sends batched IPIs and arms the one-shot timer.           |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cpu.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "arch/tsc.h"
+#include "arch/vectors.h"
+#include "mm/layout.h"
+#include "mm/vm.h"
+
+struct apic_state apic;
+
+#define APIC_TIMER_DIVIDE_1          0x0B
+#define APIC_TIMER_CALIBRATE_NS      10000000ULL    /* 10 ms */
+
+#define X2APIC_CLUSTER(ldr)          ((ldr) >> 16)
+#define X2APIC_CLUSTER_NONE          UINT32_MAX
+
+/// @fn      static void apic_timer_calibrate(void)
+/// @brief   Measures the APIC timer rate against the TSC for one-shot mode.
+///
+/// @details Only needed on processors without TSC-deadline mode. The resulting multiplier converts a TSC delta into
+/// timer ticks with a multiply and a shift, so arming the timer never divides.
+///
+/// @returns None (void)
+static void apic_timer_calibrate(void)
+{
+    apic_write(APIC_REG_LVT_TIMER, APIC_LVT_MASKED | VECTOR_APIC_TIMER);
+    apic_write(APIC_REG_TIMER_DIVIDE, APIC_TIMER_DIVIDE_1);
+
+    uint64_t start = tsc_read_ordered();
+    apic_write(APIC_REG_TIMER_INIT, UINT32_MAX);
+    tsc_spin_ns(APIC_TIMER_CALIBRATE_NS);
+    uint32_t remaining = apic_read(APIC_REG_TIMER_CURRENT);
+    uint64_t cycles = tsc_read_ordered() - start;
+
+    apic_write(APIC_REG_TIMER_INIT, 0);
+    apic.timer_mult = ((uint64_t) (UINT32_MAX - remaining) << 32) / cycles;
+}
+
+/// @fn      void apic_init(unsigned int cpu)
+/// @brief   Enables and configures the local APIC of the executing processor.
+///
+/// @details Must run on the processor being initialized, with interrupts disabled, after percpu_init() and, on the
+/// bootstrap processor, after tsc_init(). The BSP selects x2APIC or xAPIC mode for the whole system; x2APIC is used
+/// whenever CPUID enumerates it, since its registers are plain MSRs and its ICR is written in a single WRMSR with no
+/// delivery-status polling. Legacy LINT pins and the thermal LVT are masked. The timer is put in TSC-deadline mode when
+/// available and in one-shot mode otherwise. In xAPIC mode the BSP first reaches the registers through the boot
+/// loader's identity mapping; once apic_map() has moved them into vm_kernel, application processors must have loaded
+/// it with vm_init_cpu() before calling this.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void apic_init(unsigned int cpu)
+{
+    uint64_t base = _rdmsr(IA32_APIC_BASE);
+
+    if (cpu == 0) {
+        apic.x2apic       = cpu_has(CPU_FEATURE_X2APIC);
+        apic.tsc_deadline = cpu_has(CPU_FEATURE_TSC_DEADLINE);
+        apic.mmio         = (volatile uint32_t *) (uintptr_t) (base & APIC_BASE_ADDR_MASK);
+    }
+
+    // EXTD may only be set together with EN, and xAPIC mode cannot be re-entered without a full disable; a firmware
+    // that already handed over x2APIC mode is therefore left alone.
+    base |= APIC_BASE_ENABLE;
+    if (apic.x2apic)
+        base |= APIC_BASE_EXTD;
+    _wrmsr(IA32_APIC_BASE, base);
+
+    if (apic.x2apic) {
+        apic.apic_id[cpu]    = apic_read(APIC_REG_ID);
+        apic.logical_id[cpu] = apic_read(APIC_REG_LDR);
+    } else {
+        apic.apic_id[cpu]    = apic_read(APIC_REG_ID) >> 24;
+        apic.logical_id[cpu] = 0;
+    }
+    percpu[cpu].apic_id = apic.apic_id[cpu];
+
+    apic_write(APIC_REG_TPR, 0);
+    apic_write(APIC_REG_LVT_LINT0, APIC_LVT_MASKED);
+    apic_write(APIC_REG_LVT_LINT1, APIC_LVT_MASKED);
+    apic_write(APIC_REG_LVT_THERMAL, APIC_LVT_MASKED | VECTOR_APIC_THERMAL);
+    apic_write(APIC_REG_LVT_ERROR, VECTOR_APIC_ERROR);
+    apic_write(APIC_REG_ESR, 0);
+    apic_write(APIC_REG_ESR, 0);
+    apic_write(APIC_REG_SIVR, APIC_SIVR_ENABLE | VECTOR_APIC_SPURIOUS);
+
+    if (apic.tsc_deadline) {
+        apic_write(APIC_REG_LVT_TIMER, APIC_LVT_TIMER_TSC_DEADLINE | VECTOR_APIC_TIMER);
+        // The LVT write must be ordered before the first IA32_TSC_DEADLINE write or the deadline may be ignored.
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    } else {
+        if (cpu == 0)
+            apic_timer_calibrate();
+        apic_write(APIC_REG_TIMER_DIVIDE, APIC_TIMER_DIVIDE_1);
+        apic_write(APIC_REG_LVT_TIMER, APIC_LVT_TIMER_ONESHOT | VECTOR_APIC_TIMER);
+    }
+}
+
+/// @fn      int apic_map(void)
+/// @brief   Maps the xAPIC register page into the kernel address space and points apic.mmio at the new mapping.
+///
+/// @details Called by vm_init(), after apic_init() on the bootstrap processor. MMIO is left out of the direct map, so
+/// the page is mapped at its direct-map address explicitly: uncached (PCD and PWT), global and never executable.
+/// Nothing is mapped in x2APIC mode, where the registers are MSRs.
+///
+/// @returns 0 on success, or a vm_map() error
+int apic_map(void)
+{
+    if (apic.x2apic)
+        return 0;
+
+    uint64_t phys = _rdmsr(IA32_APIC_BASE) & APIC_BASE_ADDR_MASK;
+    int      err  = vm_map(&vm_kernel, (uint64_t) (uintptr_t) phys_to_virt(phys), phys, PAGE_SIZE,
+                           PTE_W | PTE_G | PTE_PCD | PTE_PWT | vm_config.nx);
+    if (!err)
+        apic.mmio = phys_to_virt(phys);
+    return err;
+}
+
+/// @fn      static void apic_icr_write(uint32_t dest, uint32_t low)
+/// @brief   Writes the interrupt command register.
+///
+/// @details In x2APIC mode the destination occupies ICR bits 63:32 and the whole register is written by one WRMSR,
+/// which the processor queues without a delivery-status bit to poll. In xAPIC mode the destination is an 8-bit ID in
+/// the high dword and the previous IPI must have been accepted before the register is reused.
+///
+/// @param   dest the destination field (x2APIC ID, logical x2APIC ID, or 8-bit xAPIC ID)
+/// @param   low  the low dword: vector, delivery mode, destination mode and shorthand
+/// @returns None (void)
+static void apic_icr_write(uint32_t dest, uint32_t low)
+{
+    if (likely(apic.x2apic)) {
+        _wrmsr(IA32_X2APIC_ICR, ((uint64_t) dest << 32) | low);
+        return;
+    }
+
+    while (apic.mmio[APIC_REG_ICR * 4] & APIC_ICR_BUSY)
+        _pause();
+    apic.mmio[APIC_REG_ICR_HIGH * 4] = dest << 24;
+    apic.mmio[APIC_REG_ICR * 4]      = low;
+}
+
+/// @fn      void apic_send_ipi(unsigned int cpu, uint8_t vector)
+/// @brief   Sends a fixed interrupt to one processor.
+///
+/// @details WRMSR to the x2APIC ICR is not serializing, so a full fence orders the caller's stores (for instance a
+/// request queued for the target) before the interrupt can be observed.
+///
+/// @param   cpu    the logical index of the target processor
+/// @param   vector the interrupt vector to deliver
+/// @returns None (void)
+void apic_send_ipi(unsigned int cpu, uint8_t vector)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    apic_icr_write(apic.apic_id[cpu], APIC_ICR_DM_FIXED | APIC_ICR_ASSERT | vector);
+}
+
+/// @fn      void apic_send_ipi_mask(const struct cpumask *mask, uint8_t vector)
+/// @brief   Sends a fixed interrupt to every processor in a set.
+///
+/// @details In x2APIC mode processors are addressed in logical (cluster) mode: each cluster holds up to 16 processors
+/// and one ICR write reaches any subset of a cluster. Consecutive members of the same cluster are merged into a single
+/// write, so a set enumerated in APIC-ID order costs one WRMSR per cluster rather than one per CPU. A single fence
+/// covers the whole batch. In xAPIC mode each member is sent a unicast IPI.
+///
+/// @param   mask   the set of target processors; the caller excludes itself if it should not be interrupted
+/// @param   vector the interrupt vector to deliver
+/// @returns None (void)
+void apic_send_ipi_mask(const struct cpumask *mask, uint8_t vector)
+{
+    const uint32_t low = APIC_ICR_DM_FIXED | APIC_ICR_ASSERT | vector;
+    uint32_t cluster = X2APIC_CLUSTER_NONE, members = 0;
+    int cpu;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (!apic.x2apic) {
+        for_each_cpu(cpu, mask)
+            apic_icr_write(apic.apic_id[cpu], low);
+        return;
+    }
+
+    for_each_cpu(cpu, mask) {
+        uint32_t ldr = apic.logical_id[cpu];
+
+        if (X2APIC_CLUSTER(ldr) != cluster) {
+            if (members)
+                _wrmsr(IA32_X2APIC_ICR, ((uint64_t) (cluster << 16 | members) << 32) | low | APIC_ICR_LOGICAL);
+            cluster = X2APIC_CLUSTER(ldr);
+            members = 0;
+        }
+        members |= ldr & 0xFFFF;
+    }
+    if (members)
+        _wrmsr(IA32_X2APIC_ICR, ((uint64_t) (cluster << 16 | members) << 32) | low | APIC_ICR_LOGICAL);
+}
+
+/// @fn      void apic_send_ipi_all_but_self(uint8_t vector)
+/// @brief   Sends a fixed interrupt to every other processor using the destination shorthand.
+///
+/// @param   vector the interrupt vector to deliver
+/// @returns None (void)
+void apic_send_ipi_all_but_self(uint8_t vector)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    apic_icr_write(0, APIC_ICR_ALL_BUT_SELF | APIC_ICR_DM_FIXED | APIC_ICR_ASSERT | vector);
+}
+
+/// @fn      void apic_send_init(unsigned int cpu)
+/// @brief   Sends an INIT IPI to a processor, as the first step of bringing up an application processor.
+///
+/// @param   cpu the logical index of the target processor
+/// @returns None (void)
+void apic_send_init(unsigned int cpu)
+{
+    apic_icr_write(apic.apic_id[cpu], APIC_ICR_DM_INIT | APIC_ICR_ASSERT);
+}
+
+/// @fn      void apic_send_startup(unsigned int cpu, uint8_t page)
+/// @brief   Sends a STARTUP IPI, starting the target in real mode at physical address page * 4096.
+///
+/// @param   cpu  the logical index of the target processor
+/// @param   page the 4 KiB page number of the real-mode trampoline
+/// @returns None (void)
+void apic_send_startup(unsigned int cpu, uint8_t page)
+{
+    apic_icr_write(apic.apic_id[cpu], APIC_ICR_DM_STARTUP | APIC_ICR_ASSERT | page);
+}
+
+/// @fn      void apic_timer_arm(uint64_t deadline_tsc)
+/// @brief   Arms the local timer of the executing processor to fire once at an absolute TSC value.
+///
+/// @details In TSC-deadline mode this is a single WRMSR, and a deadline already in the past fires immediately. In
+/// one-shot mode the remaining TSC delta is scaled to timer ticks with the calibrated multiplier.
+///
+/// @param   deadline_tsc the TSC value at which VECTOR_APIC_TIMER should be raised
+/// @returns None (void)
+void apic_timer_arm(uint64_t deadline_tsc)
+{
+    if (likely(apic.tsc_deadline)) {
+        _wrmsr(IA32_TSC_DEADLINE, deadline_tsc);
+        return;
+    }
+
+    uint64_t now = _rdtsc();
+    uint64_t ticks = 1;
+    if (deadline_tsc > now)
+        ticks = (uint64_t) (((unsigned __int128) (deadline_tsc - now) * apic.timer_mult) >> 32);
+    if (ticks == 0)
+        ticks = 1;
+    else if (ticks > UINT32_MAX)
+        ticks = UINT32_MAX;
+    apic_write(APIC_REG_TIMER_INIT, (uint32_t) ticks);
+}
+
+/// @fn      void apic_timer_cancel(void)
+/// @brief   Disarms the local timer of the executing processor.
+///
+/// @returns None (void)
+void apic_timer_cancel(void)
+{
+    if (likely(apic.tsc_deadline))
+        _wrmsr(IA32_TSC_DEADLINE, 0);
+    else
+        apic_write(APIC_REG_TIMER_INIT, 0);
+}
\ No newline at end of file
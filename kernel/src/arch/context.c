@@ -0,0 +1,60 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/context.c                                                                         |
+// | Name          : x86 Kernel Context Switch (Support)                                                               |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Lays out the initial switch frame of a new kernel thread.                                         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/context.h"
+
+void context_start(void);
+
+/// Saved-register layout pushed by context_switch(), lowest address first.
+struct context_frame {
+    uint64_t r15;
+    uint64_t r14;
+    uint64_t r13;
+    uint64_t r12;
+    uint64_t rbx;
+    uint64_t rbp;
+    uint64_t rip;
+};
+
+/// @fn      uint64_t context_init(void *stack_top, void (*entry)(void *), void *arg)
+/// @brief   Builds an initial switch frame so that the first context_switch() to it starts entry(arg).
+///
+/// @param   stack_top the top (highest address) of the new thread's kernel stack
+/// @param   entry     the thread function
+/// @param   arg       the argument passed to entry
+/// @returns the stack pointer to store as the thread's saved RSP
+uint64_t context_init(void *stack_top, void (*entry)(void *), void *arg)
+{
+    uintptr_t             top   = (uintptr_t) stack_top & ~(uintptr_t) 15;
+    struct context_frame *frame = (struct context_frame *) (top - sizeof(struct context_frame) - 8);
+
+    *frame = (struct context_frame) {
+        .r13 = (uint64_t) (uintptr_t) entry,
+        .r12 = (uint64_t) (uintptr_t) arg,
+        .rip = (uint64_t) (uintptr_t) context_start,
+    };
+    return (uint64_t) (uintptr_t) frame;
+}
\ No newline at end of file
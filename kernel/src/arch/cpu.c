@@ -0,0 +1,313 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/cpu.c                                                                             |
+// | Name          : x86 CPU Feature Cache & Capability Queries (Source)                                               |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Enumerates CPUID leaves and capability MSRs exactly once per processor at boot.                   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+
+struct cpu_info cpu_info[CONFIG_MAX_CPUS];
+uint32_t        cpu_caps[CPU_CAP_WORDS];
+
+// Topology level types reported in ECX[15:8] of CPUID leaves 0xB and 0x1F.
+#define CPUID_TOPO_LEVEL_INVALID 0
+#define CPUID_TOPO_LEVEL_SMT     1
+
+// ECX bits of CPUID leaf 0xD, subleaves 2 and up.
+#define CPUID_XSAVE_ALIGN64      (1u << 1)
+#define CPUID_XSAVE_XFD          (1u << 4)
+
+/// @fn      static void cpuid_count(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+/// @brief   Issues CPUID for a leaf/subleaf pair and returns EAX, EBX, ECX and EDX in order.
+///
+/// @param   leaf    the value placed in EAX
+/// @param   subleaf the value placed in ECX
+/// @param   regs    receives EAX, EBX, ECX and EDX
+/// @returns None (void)
+static void cpuid_count(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+    regs[0] = leaf; regs[1] = 0; regs[2] = subleaf; regs[3] = 0;
+    _cpuid(&regs[0], &regs[1], &regs[2], &regs[3]);
+}
+
+/// @fn      static void cpu_identify(struct cpu_info *info)
+/// @brief   Reads the vendor string and the family/model/stepping signature.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_identify(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    cpuid_count(0x00000000, 0, r);
+    info->max_leaf = r[0];
+    if (r[1] == 0x756E6547 && r[3] == 0x49656E69 && r[2] == 0x6C65746E)         /* "GenuineIntel" */
+        info->vendor = CPU_VENDOR_INTEL;
+    else if (r[1] == 0x68747541 && r[3] == 0x69746E65 && r[2] == 0x444D4163)    /* "AuthenticAMD" */
+        info->vendor = CPU_VENDOR_AMD;
+    else
+        info->vendor = CPU_VENDOR_UNKNOWN;
+
+    cpuid_count(0x80000000, 0, r);
+    info->max_ext_leaf = (r[0] & 0xFFFF0000) == 0x80000000 ? r[0] : 0;
+
+    cpuid_count(0x00000001, 0, r);
+    info->stepping = r[0] & 0xF;
+    info->model    = (r[0] >> 4) & 0xF;
+    info->family   = (r[0] >> 8) & 0xF;
+    if (info->family == 0xF)
+        info->family += (r[0] >> 20) & 0xFF;
+    if (info->family == 0x6 || info->family >= 0xF)
+        info->model  |= ((r[0] >> 16) & 0xF) << 4;
+    info->caps[CPU_CAP_1_ECX] = r[2];
+    info->caps[CPU_CAP_1_EDX] = r[3];
+    info->x2apic_id = r[1] >> 24;
+}
+
+/// @fn      static void cpu_read_features(struct cpu_info *info)
+/// @brief   Collects the feature-flag registers of the basic and extended leaves into the capability words.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_features(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    if (info->max_leaf >= 0x6) {
+        cpuid_count(0x00000006, 0, r);
+        info->caps[CPU_CAP_6_EAX] = r[0];
+        info->caps[CPU_CAP_6_ECX] = r[2];
+    }
+    if (info->max_leaf >= 0x7) {
+        cpuid_count(0x00000007, 0, r);
+        info->caps[CPU_CAP_7_0_EBX] = r[1];
+        info->caps[CPU_CAP_7_0_ECX] = r[2];
+        info->caps[CPU_CAP_7_0_EDX] = r[3];
+    }
+    if (info->max_ext_leaf >= 0x80000001) {
+        cpuid_count(0x80000001, 0, r);
+        info->caps[CPU_CAP_80000001_ECX] = r[2];
+        info->caps[CPU_CAP_80000001_EDX] = r[3];
+    }
+    if (info->max_ext_leaf >= 0x80000007) {
+        cpuid_count(0x80000007, 0, r);
+        info->caps[CPU_CAP_80000007_EDX] = r[3];
+    }
+    if (info->max_ext_leaf >= 0x80000008) {
+        cpuid_count(0x80000008, 0, r);
+        info->phys_addr_bits = r[0] & 0xFF;
+        info->virt_addr_bits = (r[0] >> 8) & 0xFF;
+    }
+}
+
+/// @fn      static void cpu_read_xsave(struct cpu_info *info)
+/// @brief   Records the supported XSAVE components, the save-area sizes and the user components' layout from leaf 0xD.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_xsave(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    if (info->max_leaf < 0xD || !cpu_info_has(info, CPU_FEATURE_XSAVE))
+        return;
+
+    cpuid_count(0x0000000D, 0, r);
+    info->xcr0_mask      = ((uint64_t) r[3] << 32) | r[0];
+    info->xsave_size     = r[1];
+    info->xsave_size_max = r[2];
+
+    cpuid_count(0x0000000D, 1, r);
+    info->caps[CPU_CAP_D_1_EAX] = r[0];
+    info->xsaves_size    = r[1];
+    info->xss_mask       = ((uint64_t) r[3] << 32) | r[2];
+
+    for (unsigned int i = 2; i < CPU_XSAVE_COMPONENTS; i++) {
+        if (!(info->xcr0_mask & (1ULL << i)))
+            continue;
+        cpuid_count(0x0000000D, i, r);
+        info->xsave_comp_size[i]   = (uint16_t) r[0];
+        info->xsave_comp_offset[i] = (uint16_t) r[1];
+        if (r[2] & CPUID_XSAVE_ALIGN64)
+            info->xsave_align64 |= 1u << i;
+        if (r[2] & CPUID_XSAVE_XFD)
+            info->xsave_xfd |= 1u << i;
+    }
+}
+
+/// @fn      static void cpu_read_mwait(struct cpu_info *info)
+/// @brief   Records the monitor-line size, MWAIT extensions and C-state sub-state counts from leaf 5.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_mwait(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    if (info->max_leaf < 5 || !cpu_info_has(info, CPU_FEATURE_MONITOR))
+        return;
+
+    cpuid_count(0x00000005, 0, r);
+    info->monitor_line    = r[1] & 0xFFFF;
+    info->mwait_ext       = r[2] & 0xFFFF;
+    info->mwait_substates = r[3];
+}
+
+/// @fn      static void cpu_read_frequency(struct cpu_info *info)
+/// @brief   Records the TSC/crystal ratio (leaf 0x15) and the nominal processor frequencies (leaf 0x16).
+///
+/// @details Leaf 0x15 may enumerate the ratio without the crystal frequency; in that case crystal_hz is left zero and
+/// the TSC frequency must be calibrated instead. Values are recorded as reported and are not validated here.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_frequency(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    if (info->max_leaf >= 0x15) {
+        cpuid_count(0x00000015, 0, r);
+        info->tsc_denominator = r[0];
+        info->tsc_numerator   = r[1];
+        info->crystal_hz      = r[2];
+    }
+    if (info->max_leaf >= 0x16) {
+        cpuid_count(0x00000016, 0, r);
+        info->base_mhz = r[0] & 0xFFFF;
+        info->max_mhz  = r[1] & 0xFFFF;
+        info->bus_mhz  = r[2] & 0xFFFF;
+    }
+}
+
+/// @fn      static void cpu_read_pmu(struct cpu_info *info)
+/// @brief   Records the architectural performance-monitoring capabilities from leaf 0xA.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_pmu(struct cpu_info *info)
+{
+    uint32_t r[4];
+
+    if (info->max_leaf < 0xA)
+        return;
+
+    cpuid_count(0x0000000A, 0, r);
+    info->pmu_version            = r[0] & 0xFF;
+    info->pmu_gp_counters        = (r[0] >> 8) & 0xFF;
+    info->pmu_gp_width           = (r[0] >> 16) & 0xFF;
+
+    // EBX flags unavailable events, but only its low EAX[31:24] bits are meaningful; events beyond that are absent.
+    uint32_t len = r[0] >> 24;
+    uint32_t enumerated = len >= 32 ? UINT32_MAX : (1u << len) - 1;
+    info->pmu_events_unavailable = (uint8_t) ((r[1] | ~enumerated) & 0x7F);
+
+    if (info->pmu_version >= 2) {
+        info->pmu_fixed_counters = r[3] & 0x1F;
+        info->pmu_fixed_width    = (r[3] >> 5) & 0xFF;
+    }
+}
+
+/// @fn      static void cpu_read_topology(struct cpu_info *info)
+/// @brief   Walks the extended topology leaf (0x1F if present, otherwise 0xB) to obtain the x2APIC ID and ID shifts.
+///
+/// @details Each subleaf reports, in EAX[4:0], how far the x2APIC ID must be shifted right to reach the next level.
+/// The SMT level gives the core shift; the last valid level gives the package shift regardless of how many module,
+/// tile or die levels sit in between.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_topology(struct cpu_info *info)
+{
+    uint32_t r[4], leaf;
+
+    if (info->max_leaf >= 0x1F)
+        leaf = 0x1F;
+    else if (info->max_leaf >= 0xB)
+        leaf = 0xB;
+    else
+        return;
+
+    for (uint32_t sub = 0; sub < 8; sub++) {
+        cpuid_count(leaf, sub, r);
+        uint32_t type = (r[2] >> 8) & 0xFF;
+        if (type == CPUID_TOPO_LEVEL_INVALID || r[1] == 0)
+            break;
+        if (type == CPUID_TOPO_LEVEL_SMT)
+            info->smt_shift = r[0] & 0x1F;
+        info->pkg_shift = r[0] & 0x1F;
+        info->x2apic_id = r[3];
+    }
+}
+
+/// @fn      static void cpu_read_capability_msrs(struct cpu_info *info)
+/// @brief   Reads IA32_ARCH_CAPABILITIES and IA32_CORE_CAPABILITIES when CPUID enumerates them.
+///
+/// @details The low halves are folded into the capability words so that immunity bits (RDCL_NO, MDS_NO, ...) can be
+/// queried through cpu_has() like any CPUID flag, and mitigation decisions never need an RDMSR after boot.
+///
+/// @param   info the structure to populate
+/// @returns None (void)
+static void cpu_read_capability_msrs(struct cpu_info *info)
+{
+    if (cpu_info_has(info, CPU_FEATURE_ARCH_CAPABILITIES)) {
+        info->arch_capabilities = _rdmsr(IA32_ARCH_CAPABILITIES);
+        info->caps[CPU_CAP_ARCH_CAPABILITIES] = (uint32_t) info->arch_capabilities;
+    }
+    if (cpu_info_has(info, CPU_FEATURE_CORE_CAPABILITIES)) {
+        info->core_capabilities = _rdmsr(IA32_CORE_CAPABILITIES);
+        info->caps[CPU_CAP_CORE_CAPABILITIES] = (uint32_t) info->core_capabilities;
+    }
+}
+
+/// @fn      void cpu_features_init(unsigned int cpu)
+/// @brief   Enumerates the executing processor and records it as logical CPU cpu.
+///
+/// @details Must be called exactly once on each processor, on that processor, before any code on it calls cpu_has().
+/// The bootstrap processor (cpu 0) seeds the system-wide capability set; each application processor then clears any
+/// feature it lacks. This is the only place in the kernel that issues CPUID or reads the capability MSRs, which matters
+/// under a hypervisor, where each CPUID is a VM exit.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void cpu_features_init(unsigned int cpu)
+{
+    struct cpu_info *info = &cpu_info[cpu];
+
+    cpu_identify(info);
+    cpu_read_features(info);
+    cpu_read_xsave(info);
+    cpu_read_mwait(info);
+    cpu_read_frequency(info);
+    cpu_read_pmu(info);
+    cpu_read_topology(info);
+    cpu_read_capability_msrs(info);
+
+    for (unsigned int w = 0; w < CPU_CAP_WORDS; w++) {
+        if (cpu == 0)
+            __atomic_store_n(&cpu_caps[w], info->caps[w], __ATOMIC_RELAXED);
+        else
+            __atomic_fetch_and(&cpu_caps[w], info->caps[w], __ATOMIC_RELAXED);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/fpu.c                                                                             |
+// | Name          : x86 Extended State Management (Source)                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Allocates XSAVE areas on first use and switches them with XSAVES/XSAVEOPT.                        |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/cr.h"
+#include "arch/fpu.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+#include "arch/percpu.h"
+#include "mm/slab.h"
+#include "sys/errno.h"
+#include "sys/spinlock.h"
+
+struct fpu_config fpu_config;
+struct fpu_cpu    fpu_cpus[CONFIG_MAX_CPUS];
+
+// User state components the kernel knows how to manage. PKRU is left out until protection keys are enabled.
+#define FPU_XCR0_SUPPORTED           (XFEATURE_MASK_X87 | XFEATURE_MASK_SSE | XFEATURE_MASK_AVX | \
+                                      XFEATURE_MASK_AVX512 | XFEATURE_MASK_AMX)
+
+#define FPU_FCW_DEFAULT              0x037F
+#define FPU_MXCSR_DEFAULT            0x1F80
+#define XSAVE_FCW_OFFSET             0
+#define XSAVE_MXCSR_OFFSET           24
+#define XSAVE_XSTATE_BV_OFFSET       512
+#define XSAVE_XCOMP_BV_OFFSET        520
+
+_Static_assert(XFEATURE_MAX <= CPU_XSAVE_COMPONENTS, "cpu_info must record the layout of every known component");
+
+/// Save-area caches: base areas and full (all components enabled) areas. Their object sizes are known only once CPUID
+/// has been read, so they are sized by fpu_init(0) rather than with SLAB_CACHE_DEFINE().
+static struct slab_cache fpu_caches[2] = {
+    { .name = "fpu_base", .align = 64, .lock = SPINLOCK_INIT },
+    { .name = "fpu_full", .align = 64, .lock = SPINLOCK_INIT },
+};
+
+/// @fn      static uint32_t fpu_area_size(uint64_t mask)
+/// @brief   Computes the save-area size needed for a set of components in the active format.
+///
+/// @param   mask the components to be saved
+/// @returns the area size in bytes
+static uint32_t fpu_area_size(uint64_t mask)
+{
+    const struct cpu_info *info = &cpu_info[0];
+    uint32_t               size = XSAVE_AREA_MIN;
+
+    for (unsigned int i = XFEATURE_AVX; i < XFEATURE_MAX; i++) {
+        if (!(mask & (1ULL << i)))
+            continue;
+        uint32_t end = (uint32_t) info->xsave_comp_offset[i] + info->xsave_comp_size[i];
+        if (fpu_config.mode == FPU_MODE_XSAVES) {
+            if (info->xsave_align64 & (1u << i))
+                size = (size + 63) & ~63u;
+            size += info->xsave_comp_size[i];
+        } else if (end > size) {
+            size = end;
+        }
+    }
+    return size;
+}
+
+/// @fn      static void fpu_configure(void)
+/// @brief   Chooses the save instructions, the XCR0 and XFD component sets and the two area sizes.
+///
+/// @details Components that must be enabled together (AVX-512's three, AMX's two) are dropped as a group if any
+/// member is missing. Any enabled component that CPUID marks XFD-capable is armed for first-use trapping, so a thread
+/// gets space for it only after executing an instruction that needs it.
+///
+/// @returns None (void)
+static void fpu_configure(void)
+{
+    const struct cpu_info *info = &cpu_info[0];
+
+    if (!cpu_has(CPU_FEATURE_XSAVE)) {
+        fpu_config.mode      = FPU_MODE_FXSAVE;
+        fpu_config.xcr0      = XFEATURE_MASK_X87 | XFEATURE_MASK_SSE;
+        fpu_config.base_size = XSAVE_LEGACY_SIZE;
+        fpu_config.full_size = XSAVE_LEGACY_SIZE;
+        return;
+    }
+
+    uint64_t xcr0 = info->xcr0_mask & FPU_XCR0_SUPPORTED;
+    if ((xcr0 & XFEATURE_MASK_AVX512) != XFEATURE_MASK_AVX512)
+        xcr0 &= ~XFEATURE_MASK_AVX512;
+    if ((xcr0 & XFEATURE_MASK_AMX) != XFEATURE_MASK_AMX)
+        xcr0 &= ~XFEATURE_MASK_AMX;
+
+    if (cpu_has(CPU_FEATURE_XSAVES))
+        fpu_config.mode = FPU_MODE_XSAVES;
+    else if (cpu_has(CPU_FEATURE_XSAVEOPT))
+        fpu_config.mode = FPU_MODE_XSAVEOPT;
+    else
+        fpu_config.mode = FPU_MODE_XSAVE;
+
+    fpu_config.xcr0      = xcr0;
+    fpu_config.xfd_mask  = cpu_has(CPU_FEATURE_XFD) ? xcr0 & info->xsave_xfd : 0;
+    fpu_config.base_size = fpu_area_size(xcr0 & ~fpu_config.xfd_mask);
+    fpu_config.full_size = fpu_area_size(xcr0);
+}
+
+/// @fn      static void fpu_caches_init(void)
+/// @brief   Sizes and initializes the save-area caches.
+///
+/// @details A full-area cache exists only if XFD leaves some components out of the base area. If a cache cannot be
+/// initialized, allocations from it fail and the affected threads are refused SIMD state, as when memory runs out.
+///
+/// @returns None (void)
+static void fpu_caches_init(void)
+{
+    fpu_caches[0].size = (uint32_t) ((sizeof(struct fpu_state) + fpu_config.base_size + 63) & ~(size_t) 63);
+    slab_cache_init(&fpu_caches[0]);
+
+    if (fpu_config.full_size != fpu_config.base_size) {
+        fpu_caches[1].size = (uint32_t) ((sizeof(struct fpu_state) + fpu_config.full_size + 63) & ~(size_t) 63);
+        slab_cache_init(&fpu_caches[1]);
+    }
+}
+
+/// @fn      void fpu_init(unsigned int cpu)
+/// @brief   Enables x87/SSE/XSAVE on the executing processor and leaves CR0.TS set so the first SIMD use traps.
+///
+/// @details Must run on every processor, with interrupts disabled, after cpu_features_init(); the bootstrap
+/// processor's call also fixes the system-wide configuration and sets up the save-area caches, so it must follow
+/// frame_init().
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void fpu_init(unsigned int cpu)
+{
+    struct fpu_cpu *fc = &fpu_cpus[cpu];
+
+    if (cpu == 0) {
+        fpu_configure();
+        fpu_caches_init();
+    }
+
+    uint64_t cr4 = _rdcr4() | CR4_OSFXSR | CR4_OSXMMEXCPT;
+    if (fpu_config.mode != FPU_MODE_FXSAVE)
+        cr4 |= CR4_OSXSAVE;
+    _wrcr4(cr4);
+
+    if (fpu_config.mode != FPU_MODE_FXSAVE)
+        _xsetbv(0, fpu_config.xcr0);
+    if (fpu_config.mode == FPU_MODE_XSAVES)
+        _wrmsr(IA32_XSS, 0);
+    if (fpu_config.xfd_mask)
+        _wrmsr(IA32_XFD, fpu_config.xfd_mask);
+
+    _wrcr0((_rdcr0() & ~CR0_EM) | CR0_MP | CR0_NE | CR0_TS);
+
+    fc->owner = NULL;
+    fc->ts    = true;
+}
+
+/// @fn      static struct fpu_state *fpu_alloc(uint32_t area_size, uint64_t xfd)
+/// @brief   Allocates a save area and fills it with the architectural initial state.
+///
+/// @details Only the legacy region and header are written: with XSTATE_BV zero, XRSTOR initializes every other
+/// component itself, so a new area costs 576 bytes of stores whatever its size.
+///
+/// @param   area_size fpu_config.base_size or fpu_config.full_size
+/// @param   xfd       the components that remain armed for this area
+/// @returns the new area, or NULL if memory is exhausted
+static struct fpu_state *fpu_alloc(uint32_t area_size, uint64_t xfd)
+{
+    struct slab_cache *cache = &fpu_caches[(area_size == fpu_config.base_size) ? 0 : 1];
+    struct fpu_state  *fpu   = cache->cpus ? slab_alloc(cache) : NULL;
+
+    if (!fpu)
+        return NULL;
+
+    fpu->xfd      = xfd;
+    fpu->size     = area_size;
+    fpu->last_cpu = FPU_CPU_NONE;
+
+    uint64_t *words = (uint64_t *) fpu->area;
+    for (unsigned int i = 0; i < XSAVE_AREA_MIN / sizeof(uint64_t); i++)
+        words[i] = 0;
+    *(uint16_t *) &fpu->area[XSAVE_FCW_OFFSET]   = FPU_FCW_DEFAULT;
+    *(uint32_t *) &fpu->area[XSAVE_MXCSR_OFFSET] = FPU_MXCSR_DEFAULT;
+    if (fpu_config.mode == FPU_MODE_XSAVES)
+        *(uint64_t *) &fpu->area[XSAVE_XCOMP_BV_OFFSET] = XSAVE_XCOMP_COMPACTED | (fpu_config.xcr0 & ~xfd);
+    return fpu;
+}
+
+/// @fn      static void fpu_free(struct fpu_state *fpu)
+/// @brief   Returns a save area to the cache of its size.
+///
+/// @param   fpu the area to free
+/// @returns None (void)
+static void fpu_free(struct fpu_state *fpu)
+{
+    slab_free(&fpu_caches[(fpu->size == fpu_config.base_size) ? 0 : 1], fpu);
+}
+
+/// @fn      static void fpu_save(struct fpu_state *fpu)
+/// @brief   Saves the live register state into an area, skipping components the area has no room for.
+///
+/// @param   fpu the destination area
+/// @returns None (void)
+static void fpu_save(struct fpu_state *fpu)
+{
+    uint64_t mask = fpu_config.xcr0 & ~fpu->xfd;
+
+    switch (fpu_config.mode) {
+    case FPU_MODE_XSAVES:   _xsaves(fpu->area, mask);   break;
+    case FPU_MODE_XSAVEOPT: _xsaveopt(fpu->area, mask); break;
+    case FPU_MODE_XSAVE:    _xsave(fpu->area, mask);    break;
+    case FPU_MODE_FXSAVE:   _fxsave(fpu->area);         break;
+    }
+}
+
+/// @fn      static void fpu_restore(struct fpu_state *fpu)
+/// @brief   Loads an area into the registers. CR0.TS must be clear and IA32_XFD must match fpu->xfd.
+///
+/// @param   fpu the source area
+/// @returns None (void)
+static void fpu_restore(struct fpu_state *fpu)
+{
+    uint64_t mask = fpu_config.xcr0 & ~fpu->xfd;
+
+    switch (fpu_config.mode) {
+    case FPU_MODE_XSAVES:   _xrstors(fpu->area, mask); break;
+    case FPU_MODE_XSAVEOPT:
+    case FPU_MODE_XSAVE:    _xrstor(fpu->area, mask);  break;
+    case FPU_MODE_FXSAVE:   _fxrstor(fpu->area);       break;
+    }
+}
+
+/// @fn      static void fpu_load(struct fpu_cpu *fc, unsigned int cpu, struct thread *t)
+/// @brief   Makes t's state live on the executing processor, reloading registers only if they do not already hold it.
+///
+/// @param   fc  the executing processor's FPU bookkeeping
+/// @param   cpu the logical index of the executing processor
+/// @param   t   a thread with an allocated area
+/// @returns None (void)
+static void fpu_load(struct fpu_cpu *fc, unsigned int cpu, struct thread *t)
+{
+    struct fpu_state *fpu = t->fpu;
+
+    if (fc->ts) {
+        _clts();
+        fc->ts = false;
+    }
+    if (fpu_config.xfd_mask)
+        msr_write(MSR_SLOT_XFD, fpu->xfd);
+    if (fc->owner != t || fpu->last_cpu != cpu) {
+        fpu_restore(fpu);
+        fc->restores++;
+    } else {
+        fc->restores_skipped++;
+    }
+    fc->owner     = t;
+    fpu->last_cpu = cpu;
+}
+
+/// @fn      void fpu_switch(struct thread *prev, struct thread *next)
+/// @brief   Switches extended state between two threads on the executing processor. Called with interrupts disabled.
+///
+/// @details Threads without an area (never used SIMD) cost only a CR0.TS update, and nothing at all when switching
+/// between two of them. The outgoing owner's state is saved with the optimized instruction, which writes only
+/// components that are in use and modified since they were last loaded. The registers are left untouched afterwards,
+/// so switching back to the same thread on the same CPU, with only scalar threads in between, skips the restore.
+///
+/// @param   prev the outgoing thread
+/// @param   next the incoming thread
+/// @returns None (void)
+void fpu_switch(struct thread *prev, struct thread *next)
+{
+    unsigned int    cpu = cpu_id();
+    struct fpu_cpu *fc  = &fpu_cpus[cpu];
+
+    if (fc->owner == prev && !fc->ts) {
+        if (__atomic_load_n(&prev->state, __ATOMIC_RELAXED) == THREAD_DEAD) {
+            fc->owner = NULL;
+        } else {
+            fpu_save(prev->fpu);
+            fc->saves++;
+        }
+    }
+
+    if (next->fpu) {
+        fpu_load(fc, cpu, next);
+    } else if (!fc->ts) {
+        _wrcr0(_rdcr0() | CR0_TS);
+        fc->ts = true;
+    }
+}
+
+/// @fn      int fpu_trap(struct thread *t)
+/// @brief   Handles a device-not-available (#NM) exception raised by the current thread.
+///
+/// @details Two causes are distinguished. A non-zero IA32_XFD_ERR means the thread touched an XFD-armed component:
+/// its area is replaced by a full-size one and the components are disarmed. The registers still hold the thread's
+/// live state, so nothing is copied; the next save writes the new layout. Otherwise CR0.TS was set because the thread
+/// has never used SIMD: it receives a base area in the initial state. Must be called with interrupts disabled, before
+/// anything else can overwrite IA32_XFD_ERR.
+///
+/// @param   t the current thread
+/// @returns 0 if the faulting instruction can be restarted, -ENOMEM if no area could be allocated, or -EFAULT if the
+///          trap has no known cause
+int fpu_trap(struct thread *t)
+{
+    unsigned int    cpu = cpu_id();
+    struct fpu_cpu *fc  = &fpu_cpus[cpu];
+
+    if (fpu_config.xfd_mask) {
+        uint64_t err = _rdmsr(IA32_XFD_ERR);
+        if (err) {
+            _wrmsr(IA32_XFD_ERR, 0);
+            struct fpu_state *old = t->fpu;
+            if (!old || !(old->xfd & err))
+                return -EFAULT;
+
+            struct fpu_state *fpu = fpu_alloc(fpu_config.full_size, 0);
+            if (!fpu)
+                return -ENOMEM;
+            fpu->last_cpu = old->last_cpu;
+            t->fpu        = fpu;
+            fpu_free(old);
+
+            msr_write(MSR_SLOT_XFD, 0);
+            fc->xfd_faults++;
+            return 0;
+        }
+    }
+
+    if (!fc->ts)
+        return -EFAULT;
+
+    if (!t->fpu) {
+        t->fpu = fpu_alloc(fpu_config.base_size, fpu_config.xfd_mask);
+        if (!t->fpu)
+            return -ENOMEM;
+        fc->first_use++;
+    }
+    fpu_load(fc, cpu, t);
+    return 0;
+}
+
+/// @fn      void fpu_release(struct thread *t)
+/// @brief   Frees a thread's save area. Called once the thread has exited and been switched away from.
+///
+/// @param   t the exited thread
+/// @returns None (void)
+void fpu_release(struct thread *t)
+{
+    if (t->fpu) {
+        fpu_free(t->fpu);
+        t->fpu = NULL;
+    }
+}
\ No newline at end of file
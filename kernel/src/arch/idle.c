@@ -0,0 +1,203 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/idle.c                                                                            |
+// | Name          : x86 Idle States (Source)                                                                          |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Enters MWAIT C-states chosen from measured residency and wakes idle CPUs by line writes.          |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cpu.h"
+#include "arch/idle.h"
+#include "arch/tsc.h"
+#include "sys/errno.h"
+
+struct idle_config idle_config;
+struct idle_cpu    idle_cpus[CONFIG_MAX_CPUS];
+
+#define CPUID_MWAIT_EMX              (1u << 0)
+#define CPUID_MWAIT_IBE              (1u << 1)
+
+#define UMWAIT_CONTROL_C02_DISABLE   0x00000001u
+#define UMWAIT_CONTROL_TIME_MASK     0xFFFFFFFCu
+
+#define IDLE_UMWAIT_DEFAULT_NS       100000ULL      /* 100 us */
+#define IDLE_PREDICT_SHIFT           3              /* moving average over ~8 idle periods */
+
+// Minimum residency at which each MWAIT C-state (C1 through C7, by EAX[7:4] + 1) pays for its entry and exit cost.
+// These are conservative defaults for current client and server cores; without ACPI _CST data the kernel cannot know
+// the platform's exact figures, and the residency predictor keeps shallow states in use while idle periods are short.
+static const uint32_t idle_residency_ns[IDLE_MAX_STATES - 1] = {
+    2000, 20000, 100000, 200000, 400000, 600000, 1000000,
+};
+
+/// @fn      static void idle_configure(void)
+/// @brief   Chooses the MWAIT C-states from the leaf 5 data in cpu_info, and sets up the user wait instructions.
+///
+/// @details MWAIT is used only if the processor enumerates the MONITOR/MWAIT extensions and treats interrupts as break
+/// events; otherwise an interrupt could be held off until an unrelated write to the monitored line. For each C-state
+/// with at least one sub-state, sub-state 0 is used.
+///
+/// @returns None (void)
+static void idle_configure(void)
+{
+    const struct cpu_info *info = &cpu_info[0];
+
+    if (cpu_has(CPU_FEATURE_MONITOR) && (info->mwait_ext & CPUID_MWAIT_EMX) && (info->mwait_ext & CPUID_MWAIT_IBE)) {
+        idle_config.monitor_line = info->monitor_line;
+        for (unsigned int n = 1; n < IDLE_MAX_STATES; n++) {
+            if (!((info->mwait_substates >> (4 * n)) & 0xF))
+                continue;
+            struct idle_state *st = &idle_config.states[idle_config.nr_states++];
+            st->hint          = (n - 1) << 4;
+            st->residency_ns  = idle_residency_ns[n - 1];
+            st->residency_tsc = tsc_ns_to_cycles(st->residency_ns);
+        }
+        idle_config.mwait = idle_config.nr_states > 0;
+    }
+
+    idle_config.waitpkg = cpu_has(CPU_FEATURE_WAITPKG);
+    if (idle_config.waitpkg)
+        idle_set_umwait_policy(IDLE_UMWAIT_DEFAULT_NS, true);
+}
+
+/// @fn      void idle_init(unsigned int cpu)
+/// @brief   Prepares the executing processor's idle state.
+///
+/// @details Must run on every processor after tsc_init(); the bootstrap processor's call also enumerates C-states and
+/// installs the default user wait policy (C0.2 allowed, waits capped at 100 us).
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void idle_init(unsigned int cpu)
+{
+    if (cpu == 0)
+        idle_configure();
+
+    idle_cpus[cpu].predicted_tsc = 0;
+    idle_sync_umwait(cpu);
+}
+
+/// @fn      static unsigned int idle_select(const struct idle_cpu *ic)
+/// @brief   Picks the deepest C-state whose target residency the predicted idle period covers.
+///
+/// @param   ic the executing processor's predictor
+/// @returns an index into idle_config.states
+static unsigned int idle_select(const struct idle_cpu *ic)
+{
+    unsigned int i = 0;
+
+    while (i + 1 < idle_config.nr_states && idle_config.states[i + 1].residency_tsc <= ic->predicted_tsc)
+        i++;
+    return i;
+}
+
+/// @fn      void idle_enter(unsigned int cpu, struct idle_line *line)
+/// @brief   Idles the executing processor until line->wake is written or an interrupt arrives.
+///
+/// @details Called with interrupts disabled after the caller has found no work; returns with interrupts enabled. With
+/// MWAIT, polling is published before MONITOR is armed and line->wake is rechecked after, so a waker either sees
+/// polling clear and sends an IPI, or writes the line and the write is seen by the recheck or breaks the MWAIT.
+/// Without MWAIT, polling stays clear and every wake-up arrives by IPI. The measured idle period feeds the predictor
+/// that chooses the next C-state.
+///
+/// @param   cpu  the logical index of the executing processor
+/// @param   line the wake-up word to monitor
+/// @returns None (void)
+void idle_enter(unsigned int cpu, struct idle_line *line)
+{
+    struct idle_cpu *ic = &idle_cpus[cpu];
+
+    idle_sync_umwait(cpu);
+
+    if (!idle_config.mwait) {
+        ic->halts++;
+        _sti_hlt();
+        return;
+    }
+
+    unsigned int state = idle_select(ic);
+
+    __atomic_exchange_n(&line->polling, 1, __ATOMIC_SEQ_CST);
+    _monitor(line, 0, 0);
+    if (__atomic_load_n(&line->wake, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&line->polling, 0, __ATOMIC_RELAXED);
+        _sti();
+        return;
+    }
+
+    uint64_t start = _rdtsc();
+    _sti_mwait(idle_config.states[state].hint, 0);
+    uint64_t slept = _rdtsc() - start;
+    __atomic_store_n(&line->polling, 0, __ATOMIC_RELAXED);
+
+    ic->entries[state]++;
+    ic->residency_tsc[state] += slept;
+    if (slept < idle_config.states[state].residency_tsc)
+        ic->too_deep[state]++;
+    ic->predicted_tsc += (slept >> IDLE_PREDICT_SHIFT) - (ic->predicted_tsc >> IDLE_PREDICT_SHIFT);
+}
+
+/// @fn      bool idle_wake(struct idle_line *line, unsigned int cpu, uint8_t vector)
+/// @brief   Wakes another processor, by a store to its monitored line if it is in MWAIT, or by IPI otherwise.
+///
+/// @details The caller must already have published whatever the target should find (for example a run-queue inbox
+/// push) with a sequentially consistent operation, which orders it before the read of polling.
+///
+/// @param   line   the target's wake-up word
+/// @param   cpu    the logical index of the target
+/// @param   vector the IPI vector to use if the target is not polling
+/// @returns true if an IPI was sent, false if a line write sufficed
+bool idle_wake(struct idle_line *line, unsigned int cpu, uint8_t vector)
+{
+    if (__atomic_load_n(&line->polling, __ATOMIC_SEQ_CST)) {
+        __atomic_store_n(&line->wake, 1, __ATOMIC_RELEASE);
+        return false;
+    }
+    apic_send_ipi(cpu, vector);
+    return true;
+}
+
+/// @fn      int idle_set_umwait_policy(uint64_t max_ns, bool allow_c02)
+/// @brief   Sets the limits the kernel imposes on user-mode UMWAIT and TPAUSE.
+///
+/// @details User servers that spin on shared-memory rings can park in C0.1 or C0.2 with UMONITOR/UMWAIT instead of
+/// burning the core; IA32_UMWAIT_CONTROL bounds how long any one wait may last and whether the deeper C0.2 state
+/// (slower to exit, friendlier to the SMT sibling) may be used. The new value reaches each CPU at its next context
+/// switch or idle entry.
+///
+/// @param   max_ns    the longest permitted single wait in nanoseconds, or 0 for no kernel-imposed limit
+/// @param   allow_c02 whether waits may enter C0.2
+/// @returns 0 on success, or -ENODEV if the processor lacks WAITPKG
+int idle_set_umwait_policy(uint64_t max_ns, bool allow_c02)
+{
+    if (!idle_config.waitpkg)
+        return -ENODEV;
+
+    uint64_t cycles = max_ns ? tsc_ns_to_cycles(max_ns) : 0;
+    if (cycles > UMWAIT_CONTROL_TIME_MASK)
+        cycles = UMWAIT_CONTROL_TIME_MASK;
+
+    idle_config.umwait_control = ((uint32_t) cycles & UMWAIT_CONTROL_TIME_MASK) |
+                                 (allow_c02 ? 0 : UMWAIT_CONTROL_C02_DISABLE);
+    __atomic_fetch_add(&idle_config.umwait_gen, 1, __ATOMIC_RELEASE);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/idt.c                                                                             |
+// | Name          : Interrupt Descriptor Table                                                                        |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Installs the prebuilt IDT and routes each vector to its handler through one table.                |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/fpu.h"
+#include "arch/idt.h"
+#include "arch/inst.h"
+#include "arch/percpu.h"
+#include "arch/prof.h"
+#include "arch/segment.h"
+#include "arch/syscall.h"
+#include "arch/vectors.h"
+#include "kern/intr.h"
+#include "kern/sched.h"
+#include "kern/thread.h"
+#include "mm/tlb.h"
+
+struct idt_frame idt_fault_frames[CONFIG_MAX_CPUS];
+
+/// @fn      static void idt_fault(struct idt_frame *frame)
+/// @brief   Handles an exception nothing else claims.
+///
+/// @details A fault in user mode ends the faulting thread. One in the kernel is unrecoverable: the frame is saved in
+/// idt_fault_frames and the processor stops with interrupts disabled.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_fault(struct idt_frame *frame)
+{
+    if (frame->cs & SEG_RPL_USER)
+        sched_exit();
+
+    idt_fault_frames[this_cpu_read(cpu)] = *frame;
+    for (;;) {
+        _cli();
+        _hlt();
+    }
+}
+
+/// @fn      static void idt_nmi(struct idt_frame *frame)
+/// @brief   Handles VECTOR_NMI. The only NMI source the kernel programs is the profiler's counter overflow.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_nmi(struct idt_frame *frame)
+{
+    const struct thread *t = this_cpu_read(current);
+
+    prof_nmi(this_cpu_read(cpu), frame->rip, t ? t->id : 0);
+}
+
+/// @fn      static void idt_device_not_available(struct idt_frame *frame)
+/// @brief   Handles VECTOR_DEVICE_NOT_AVAILABLE: a thread's first SIMD use, or use of an XFD-armed component.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_device_not_available(struct idt_frame *frame)
+{
+    if (fpu_trap(this_cpu_read(current)))
+        idt_fault(frame);
+}
+
+/// @fn      static void idt_device(struct idt_frame *frame)
+/// @brief   Handles a device vector by passing it to the user-mode driver bound to it.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_device(struct idt_frame *frame)
+{
+    intr_interrupt((unsigned int) frame->vector);
+}
+
+/// @fn      static void idt_apic_timer(struct idt_frame *frame)
+/// @brief   Handles VECTOR_APIC_TIMER.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_apic_timer(struct idt_frame *frame)
+{
+    (void) frame;
+    sched_timer_interrupt();
+}
+
+/// @fn      static void idt_reschedule(struct idt_frame *frame)
+/// @brief   Handles VECTOR_IPI_RESCHEDULE.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_reschedule(struct idt_frame *frame)
+{
+    (void) frame;
+    sched_ipi_interrupt();
+}
+
+/// @fn      static void idt_tlb_shootdown(struct idt_frame *frame)
+/// @brief   Handles VECTOR_IPI_TLB_SHOOTDOWN.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_tlb_shootdown(struct idt_frame *frame)
+{
+    (void) frame;
+    tlb_shootdown_interrupt();
+}
+
+/// @fn      static void idt_spurious(struct idt_frame *frame)
+/// @brief   Handles VECTOR_APIC_SPURIOUS, which must not be acknowledged.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_spurious(struct idt_frame *frame)
+{
+    (void) frame;
+}
+
+/// @fn      static void idt_software(struct idt_frame *frame)
+/// @brief   Handles VECTOR_SOFTWARE, which only INT raises: there is no APIC interrupt in service to acknowledge.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_software(struct idt_frame *frame)
+{
+    (void) frame;
+}
+
+/// @fn      static void idt_unexpected(struct idt_frame *frame)
+/// @brief   Handles an APIC-delivered vector with no handler, including the APIC error interrupt, by acknowledging it.
+///
+/// @param   frame the saved registers
+/// @returns None (void)
+static void idt_unexpected(struct idt_frame *frame)
+{
+    (void) frame;
+    apic_eoi();
+}
+
+/// Handler of each vector, indexed by the entry stubs. SYSCALL_VECTOR's stub never reaches it.
+const idt_handler_fn idt_handlers[IDT_ENTRIES] __cacheline_aligned = {
+    [VECTOR_DIVIDE_ERROR ... VECTOR_DEBUG]                          = idt_fault,
+    [VECTOR_NMI]                                                    = idt_nmi,
+    [VECTOR_BREAKPOINT ... VECTOR_INVALID_OPCODE]                   = idt_fault,
+    [VECTOR_DEVICE_NOT_AVAILABLE]                                   = idt_device_not_available,
+    [VECTOR_DOUBLE_FAULT ... VECTOR_EXCEPTION_COUNT - 1]            = idt_fault,
+    [VECTOR_SOFTWARE]                                               = idt_software,
+    [VECTOR_SOFTWARE + 1 ... VECTOR_DEVICE_FIRST - 1]               = idt_unexpected,
+    [VECTOR_DEVICE_FIRST ... SYSCALL_VECTOR - 1]                    = idt_device,
+    [SYSCALL_VECTOR]                                                = idt_unexpected,
+    [SYSCALL_VECTOR + 1 ... VECTOR_DEVICE_LAST]                     = idt_device,
+    [VECTOR_DEVICE_LAST + 1 ... VECTOR_APIC_TIMER - 1]              = idt_unexpected,
+    [VECTOR_APIC_TIMER]                                             = idt_apic_timer,
+    [VECTOR_APIC_TIMER + 1 ... VECTOR_IPI_RESCHEDULE - 1]           = idt_unexpected,
+    [VECTOR_IPI_RESCHEDULE]                                         = idt_reschedule,
+    [VECTOR_IPI_TLB_SHOOTDOWN]                                      = idt_tlb_shootdown,
+    [VECTOR_IPI_TLB_SHOOTDOWN + 1 ... VECTOR_APIC_SPURIOUS - 1]     = idt_unexpected,
+    [VECTOR_APIC_SPURIOUS]                                          = idt_spurious,
+};
+
+/// @fn      void idt_init(void)
+/// @brief   Fills the stub addresses into the prebuilt descriptor image.
+///
+/// @details Everything else in the image was fixed at assembly time, so this is one store per gate. Called once by
+/// the bootstrap processor before the first percpu_init(); every processor then shares the table.
+///
+/// @returns None (void)
+void idt_init(void)
+{
+    uint64_t base = (uint64_t) (uintptr_t) idt_stubs;
+
+    for (unsigned int i = 0; i < IDT_ENTRIES; i++) {
+        uint64_t offset = base + i * IDT_STUB_SIZE;
+
+        idt_table[i].offset_low  = (uint16_t) offset;
+        idt_table[i].offset_mid  = (uint16_t) (offset >> 16);
+        idt_table[i].offset_high = (uint32_t) (offset >> 32);
+    }
+}
+
+/// @fn      void idt_load(void)
+/// @brief   Loads the shared IDT on the executing processor. Called from percpu_init().
+///
+/// @returns None (void)
+void idt_load(void)
+{
+    struct desc_ptr idtr = {
+        .limit = sizeof(struct idt_gate) * IDT_ENTRIES - 1,
+        .base  = (uint64_t) (uintptr_t) idt_table,
+    };
+
+    _lidt(&idtr);
+}
\ No newline at end of file
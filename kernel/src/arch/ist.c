@@ -0,0 +1,46 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/ist.c                                                                             |
+// | Name          : x86 Interrupt Stack Table Assignments (Source)                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Provides the per-CPU NMI, double-fault and machine-check stacks referenced by the TSS.            |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/ist.h"
+#include "sys/cdefs.h"
+#include "sys/config.h"
+
+static uint8_t ist_stacks[CONFIG_MAX_CPUS][IST_COUNT][CONFIG_IST_STACK_SIZE] __aligned(16);
+
+#define IST_STACK_TOP(cpu, ist) ((uint64_t) (uintptr_t) &ist_stacks[(cpu)][(ist) - 1][CONFIG_IST_STACK_SIZE])
+
+/// @fn      void ist_install(struct tss_entry *tss, unsigned int cpu)
+/// @brief   Points a CPU's TSS interrupt-stack-table entries at that CPU's dedicated stacks.
+///
+/// @param   tss the task-state segment of the processor
+/// @param   cpu the logical index of the processor
+/// @returns None (void)
+void ist_install(struct tss_entry *tss, unsigned int cpu)
+{
+    tss->interrupt_stack_1 = IST_STACK_TOP(cpu, IST_NMI);
+    tss->interrupt_stack_2 = IST_STACK_TOP(cpu, IST_DOUBLE_FAULT);
+    tss->interrupt_stack_3 = IST_STACK_TOP(cpu, IST_MACHINE_CHECK);
+}
\ No newline at end of file
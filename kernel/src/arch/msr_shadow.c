@@ -0,0 +1,192 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/msr_shadow.c                                                                      |
+// | Name          : MSR Shadows                                                                                       |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Skips redundant MSR writes and applies deferred ones once per return to user mode.                |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+
+struct msr_shadow_cpu msr_shadow_cpus[CONFIG_MAX_CPUS];
+bool                  msr_fsgsbase;
+
+static const uint32_t msr_slot_index[MSR_SLOT_COUNT] = {
+    [MSR_SLOT_SPEC_CTRL]        = IA32_SPEC_CTRL,
+    [MSR_SLOT_XFD]              = IA32_XFD,
+    [MSR_SLOT_HWP_REQUEST]      = IA32_HWP_REQUEST,
+    [MSR_SLOT_PERF_CTL]         = IA32_PERF_CTL,
+    [MSR_SLOT_ENERGY_PERF_BIAS] = IA32_ENERGY_PERF_BIAS,
+    [MSR_SLOT_PERF_GLOBAL_CTRL] = IA32_PERF_GLOBAL_CTRL,
+    [MSR_SLOT_FIXED_CTR_CTRL]   = IA32_FIXED_CTR_CTRL,
+    [MSR_SLOT_FS_BASE]          = IA32_FS_BASE,
+    [MSR_SLOT_USER_GS_BASE]     = IA32_KERNEL_GS_BASE,
+};
+
+/// @fn      void msr_shadow_init_cpu(unsigned int cpu)
+/// @brief   Enables RDFSBASE/WRFSBASE and their GS forms when the processor has them, and forgets every shadow.
+///
+/// @details Must run on the processor being initialized, after cpu_features_init(). The shadows start invalid, so the
+/// first write of each register always reaches the hardware. With CR4.FSGSBASE set, user mode can also change its
+/// FS and GS bases directly, so the scheduler reads them back when it switches away from a thread, and a user GS base
+/// may point into the upper half. NMI entry then identifies the kernel's GS base by the CPU index kept in
+/// IA32_TSC_AUX rather than by its sign.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void msr_shadow_init_cpu(unsigned int cpu)
+{
+    struct msr_shadow_cpu *sc = &msr_shadow_cpus[cpu];
+
+    if (cpu == 0)
+        msr_fsgsbase = cpu_has(CPU_FEATURE_FSGSBASE) && cpu_has(CPU_FEATURE_RDTSCP);
+    if (msr_fsgsbase) {
+        _wrmsr(IA32_TSC_AUX, cpu);
+        _wrcr4(_rdcr4() | CR4_FSGSBASE);
+    }
+
+    sc->valid   = 0;
+    sc->pending = 0;
+}
+
+/// @fn      void msr_write_through(struct msr_shadow_cpu *sc, enum msr_slot slot, uint64_t value)
+/// @brief   Writes a register and records the value as its shadow. The miss path of msr_write().
+///
+/// @details The segment bases use WRFSBASE and WRGSBASE where available, which do not serialize. The user GS base is
+/// parked in IA32_KERNEL_GS_BASE while the kernel runs, so it is written between two SWAPGS instructions with nothing
+/// gs-relative in between.
+///
+/// @param   sc    the executing processor's shadows
+/// @param   slot  the register
+/// @param   value the value
+/// @returns None (void)
+void msr_write_through(struct msr_shadow_cpu *sc, enum msr_slot slot, uint64_t value)
+{
+    if (slot == MSR_SLOT_FS_BASE && msr_fsgsbase) {
+        _wrfsbase(value);
+    } else if (slot == MSR_SLOT_USER_GS_BASE && msr_fsgsbase) {
+        _swapgs();
+        _wrgsbase(value);
+        _swapgs();
+    } else {
+        _wrmsr(msr_slot_index[slot], value);
+    }
+
+    sc->value[slot]  = value;
+    sc->valid       |= 1u << slot;
+    sc->stats[slot].misses++;
+}
+
+/// @fn      uint64_t msr_read_base(enum msr_slot slot)
+/// @brief   Returns the user FS or GS base the current thread would run with, reading it back from the processor.
+///
+/// @details Only meaningful with msr_fsgsbase set, when user mode may have changed the base with WRFSBASE or
+/// WRGSBASE since it was last written. A deferred value not yet applied is the answer itself. Called with interrupts
+/// disabled.
+///
+/// @param   slot MSR_SLOT_FS_BASE or MSR_SLOT_USER_GS_BASE
+/// @returns the base
+uint64_t msr_read_base(enum msr_slot slot)
+{
+    struct msr_shadow_cpu *sc  = &msr_shadow_cpus[this_cpu_read(cpu)];
+    uint32_t               bit = 1u << slot;
+    uint64_t               value;
+
+    if (sc->pending & bit)
+        return sc->deferred[slot];
+
+    if (slot == MSR_SLOT_FS_BASE) {
+        value = _rdfsbase();
+    } else {
+        _swapgs();
+        value = _rdgsbase();
+        _swapgs();
+    }
+    sc->value[slot]  = value;
+    sc->valid       |= bit;
+    return value;
+}
+
+/// @fn      void msr_write_deferred(enum msr_slot slot, uint64_t value)
+/// @brief   Queues a value to be written at the next return to user mode.
+///
+/// @details For registers that only matter in user mode, such as the segment bases. Several switches within one
+/// kernel entry then cost at most one write per register, and none if the last value is the one already loaded.
+/// Called with interrupts disabled.
+///
+/// @param   slot  the register
+/// @param   value the value
+/// @returns None (void)
+void msr_write_deferred(enum msr_slot slot, uint64_t value)
+{
+    struct msr_shadow_cpu *sc  = &msr_shadow_cpus[this_cpu_read(cpu)];
+    uint32_t               bit = 1u << slot;
+
+    if (sc->pending & bit)
+        sc->stats[slot].hits++;
+    sc->deferred[slot]  = value;
+    sc->pending        |= bit;
+}
+
+/// @fn      void msr_shadow_sync(enum msr_slot slot, uint64_t value)
+/// @brief   Records a value the register is known to hold, after it changed without going through the shadow.
+///
+/// @param   slot  the register
+/// @param   value its current value
+/// @returns None (void)
+void msr_shadow_sync(enum msr_slot slot, uint64_t value)
+{
+    struct msr_shadow_cpu *sc = &msr_shadow_cpus[this_cpu_read(cpu)];
+
+    sc->value[slot]  = value;
+    sc->valid       |= 1u << slot;
+}
+
+/// @fn      void msr_shadow_apply(void)
+/// @brief   Writes the deferred values that differ from their registers. Called on every return to user mode.
+///
+/// @details The common case is a single load and test of the pending mask.
+///
+/// @returns None (void)
+void msr_shadow_apply(void)
+{
+    struct msr_shadow_cpu *sc      = &msr_shadow_cpus[this_cpu_read(cpu)];
+    uint32_t               pending = sc->pending;
+
+    if (likely(!pending))
+        return;
+
+    sc->pending = 0;
+    while (pending) {
+        enum msr_slot slot  = (enum msr_slot) __builtin_ctz(pending);
+        uint64_t      value = sc->deferred[slot];
+        pending &= pending - 1;
+
+        if ((sc->valid & (1u << slot)) && sc->value[slot] == value)
+            sc->stats[slot].hits++;
+        else
+            msr_write_through(sc, slot, value);
+    }
+}
\ No newline at end of file
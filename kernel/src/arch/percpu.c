@@ -0,0 +1,136 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/percpu.c                                                                          |
+// | Name          : x86 Per-CPU Data Block (Source)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Allocates per-CPU data blocks and kernel stacks and installs the GS base.                         |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/idt.h"
+#include "arch/inst.h"
+#include "arch/ist.h"
+#include "arch/msr.h"
+#include "arch/percpu.h"
+
+struct percpu percpu[CONFIG_MAX_CPUS];
+
+static uint8_t percpu_stacks[CONFIG_MAX_CPUS][CONFIG_KERNEL_STACK_SIZE] __aligned(16);
+
+// Flat 64-bit code and data descriptors. Base and limit are ignored in long mode except for the L, D, DPL and P bits.
+#define GDT_DESC_KERNEL_CODE         0x00AF9A000000FFFFULL
+#define GDT_DESC_KERNEL_DATA         0x00CF92000000FFFFULL
+#define GDT_DESC_USER_CODE32         0x00CFFA000000FFFFULL
+#define GDT_DESC_USER_DATA           0x00CFF2000000FFFFULL
+#define GDT_DESC_USER_CODE           0x00AFFA000000FFFFULL
+
+#define TSS_ACCESS_AVAILABLE         0x89
+
+/// @fn      static void percpu_build_gdt(struct percpu *pc)
+/// @brief   Fills a CPU's private GDT, including a TSS descriptor that points at that CPU's own TSS.
+///
+/// @param   pc the per-CPU block being initialized
+/// @returns None (void)
+static void percpu_build_gdt(struct percpu *pc)
+{
+    uint64_t base = (uint64_t) (uintptr_t) &pc->tss;
+    struct gdt_gate tss_desc = {
+        .limit_low     = sizeof(pc->tss) - 1,
+        .base_low      = base & 0xFFFF,
+        .base_mid_low  = (base >> 16) & 0xFF,
+        .access        = TSS_ACCESS_AVAILABLE,
+        .flags         = 0,
+        .base_mid_high = (base >> 24) & 0xFF,
+        .base_high     = (uint32_t) (base >> 32),
+        .padding       = 0,
+    };
+
+    pc->gdt[GDT_NULL]        = 0;
+    pc->gdt[GDT_KERNEL_CODE] = GDT_DESC_KERNEL_CODE;
+    pc->gdt[GDT_KERNEL_DATA] = GDT_DESC_KERNEL_DATA;
+    pc->gdt[GDT_USER_CODE32] = GDT_DESC_USER_CODE32;
+    pc->gdt[GDT_USER_DATA]   = GDT_DESC_USER_DATA;
+    pc->gdt[GDT_USER_CODE]   = GDT_DESC_USER_CODE;
+    __builtin_memcpy(&pc->gdt[GDT_TSS], &tss_desc, sizeof(tss_desc));
+}
+
+/// @fn      static void percpu_load_segments(void)
+/// @brief   Reloads CS through a far return and the data segment registers from the newly loaded GDT.
+///
+/// @details FS and GS are loaded with the null selector, which on some processors also clears their bases; the GS base
+/// is therefore written only after this runs.
+///
+/// @returns None (void)
+static void percpu_load_segments(void)
+{
+    asm volatile (
+        "pushq  %[cs]\n\t"
+        "leaq   1f(%%rip), %%rax\n\t"
+        "pushq  %%rax\n\t"
+        "lretq\n"
+        "1:\n\t"
+        "movl   %[ds], %%eax\n\t"
+        "movl   %%eax, %%ss\n\t"
+        "movl   %%eax, %%ds\n\t"
+        "movl   %%eax, %%es\n\t"
+        "xorl   %%eax, %%eax\n\t"
+        "movl   %%eax, %%fs\n\t"
+        "movl   %%eax, %%gs"
+        :
+        : [cs] "i" (SEL_KERNEL_CODE), [ds] "i" (SEL_KERNEL_DATA)
+        : "rax", "memory"
+    );
+}
+
+/// @fn      void percpu_init(unsigned int cpu)
+/// @brief   Gives the executing processor its own GDT, TSS, IST stacks and GS-addressed per-CPU block; loads the IDT.
+///
+/// @details Must run on the processor being initialized, with interrupts disabled, before anything calls this_cpu() or
+/// cpu_id() there. Because every CPU has a private GDT, the TSS descriptor's busy bit is never shared and each CPU can
+/// load the same selector. IA32_KERNEL_GS_BASE is cleared so that the first SWAPGS on return to user mode installs a
+/// null user GS base.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void percpu_init(unsigned int cpu)
+{
+    struct percpu  *pc = &percpu[cpu];
+    struct desc_ptr gdtr;
+
+    pc->self       = pc;
+    pc->cpu        = cpu;
+    pc->kernel_rsp = (uint64_t) (uintptr_t) &percpu_stacks[cpu][CONFIG_KERNEL_STACK_SIZE];
+    pc->user_rsp   = 0;
+
+    pc->tss.stack_ptr_0     = pc->kernel_rsp;
+    pc->tss.iopb_tss_offset = sizeof(pc->tss);
+    ist_install(&pc->tss, cpu);
+    percpu_build_gdt(pc);
+
+    gdtr.limit = sizeof(pc->gdt) - 1;
+    gdtr.base  = (uint64_t) (uintptr_t) pc->gdt;
+    _lgdt(&gdtr);
+    percpu_load_segments();
+    _ltr(SEL_TSS);
+    idt_load();
+
+    _wrmsr(IA32_GS_BASE, (uint64_t) (uintptr_t) pc);
+    _wrmsr(IA32_KERNEL_GS_BASE, 0);
+}
\ No newline at end of file
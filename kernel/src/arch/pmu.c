@@ -0,0 +1,530 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/pmu.c                                                                             |
+// | Name          : x86 Performance-Monitoring Counter Driver (Source)                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Programs the architectural PMU and virtualizes its counters across context switches.              |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+#include "arch/percpu.h"
+#include "arch/pmu.h"
+#include "arch/syscall.h"
+#include "kern/thread.h"
+#include "mm/slab.h"
+#include "sys/errno.h"
+
+struct pmu_cpu pmu_cpus[CONFIG_MAX_CPUS];
+
+/// Thread PMU contexts, allocated on a thread's first SYS_PMU_OPEN. Initialized by pmu_init(0), so without a usable
+/// PMU on the bootstrap processor its per-CPU stacks stay NULL and nothing is allocated from it.
+SLAB_CACHE_DEFINE(pmu_context, struct pmu_context, NULL);
+
+#define PERFEVTSEL_USR               (1ULL << 16)
+#define PERFEVTSEL_OS                (1ULL << 17)
+#define PERFEVTSEL_INT               (1ULL << 20)
+#define PERFEVTSEL_EN                (1ULL << 22)
+
+#define FIXED_CTRL_OS                0x1ULL
+#define FIXED_CTRL_USR               0x2ULL
+#define FIXED_CTRL_PMI               0x8ULL
+#define FIXED_CTRL_BITS              4
+
+// Architectural event encodings (umask << 8 | event select), Intel SDM Vol. 3B, Table 20-1.
+static const uint16_t pmu_event_codes[PMU_EVENT_COUNT] = {
+    [PMU_EVENT_CYCLES]         = 0x003C,
+    [PMU_EVENT_INSTRUCTIONS]   = 0x00C0,
+    [PMU_EVENT_REF_CYCLES]     = 0x013C,
+    [PMU_EVENT_LLC_REFERENCES] = 0x4F2E,
+    [PMU_EVENT_LLC_MISSES]     = 0x412E,
+    [PMU_EVENT_BRANCHES]       = 0x00C4,
+    [PMU_EVENT_BRANCH_MISSES]  = 0x00C5,
+};
+
+// Fixed-function counter that counts each event, or -1. Fixed counters are preferred so that the scarce
+// general-purpose counters stay available for cache and branch events.
+static const int8_t pmu_event_fixed[PMU_EVENT_COUNT] = {
+    [PMU_EVENT_CYCLES]         = 1,
+    [PMU_EVENT_INSTRUCTIONS]   = 0,
+    [PMU_EVENT_REF_CYCLES]     = 2,
+    [PMU_EVENT_LLC_REFERENCES] = -1,
+    [PMU_EVENT_LLC_MISSES]     = -1,
+    [PMU_EVENT_BRANCHES]       = -1,
+    [PMU_EVENT_BRANCH_MISSES]  = -1,
+};
+
+/// @fn      static uint64_t pmu_width_mask(uint8_t width)
+/// @brief   Returns a mask covering the low width bits of a counter.
+///
+/// @param   width the counter width in bits
+/// @returns 2^width - 1, saturating at 64 bits
+static uint64_t pmu_width_mask(uint8_t width)
+{
+    return width >= 64 ? UINT64_MAX : (1ULL << width) - 1;
+}
+
+/// @fn      int pmu_init(unsigned int cpu)
+/// @brief   Discovers the executing processor's PMU and stops every counter on it.
+///
+/// @details Must run on the processor being initialized, after cpu_features_init(cpu). Only architectural performance
+/// monitoring version 2 and later is supported, as earlier versions lack IA32_PERF_GLOBAL_CTRL.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns 0 on success, -ENODEV if the processor has no usable architectural PMU, or on the bootstrap processor a
+///          slab_cache_init() error for the thread context cache, which leaves SYS_PMU_OPEN failing with -ENOMEM
+int pmu_init(unsigned int cpu)
+{
+    const struct cpu_info *info = &cpu_info[cpu];
+    struct pmu_cpu        *pc   = &pmu_cpus[cpu];
+
+    if (info->pmu_version < 2 || info->pmu_gp_counters == 0)
+        return -ENODEV;
+
+    pc->nr_gp            = info->pmu_gp_counters < PMU_MAX_GP ? info->pmu_gp_counters : PMU_MAX_GP;
+    pc->nr_fixed         = info->pmu_fixed_counters < PMU_MAX_FIXED ? info->pmu_fixed_counters : PMU_MAX_FIXED;
+    pc->gp_value_mask    = pmu_width_mask(info->pmu_gp_width);
+    pc->fixed_value_mask = pmu_width_mask(info->pmu_fixed_width);
+    pc->global_ctrl      = 0;
+    pc->fixed_ctrl       = 0;
+    pc->pce              = (_rdcr4() & CR4_PCE) != 0;
+
+    _wrmsr(IA32_PERF_GLOBAL_CTRL, 0);
+    _wrmsr(IA32_FIXED_CTR_CTRL, 0);
+    for (unsigned int i = 0; i < pc->nr_gp; i++)
+        _wrmsr(IA32_PERFEVTSEL0 + i, 0);
+
+    if (cpu == 0)
+        return slab_cache_init(&pmu_context_cache);
+    return 0;
+}
+
+/// @fn      void pmu_counter_init(struct pmu_counter *ctr, enum pmu_event event, uint8_t flags)
+/// @brief   Prepares a counter descriptor; the counter does not count until it is started or switched in.
+///
+/// @param   ctr   the counter to initialize
+/// @param   event the architectural event to count
+/// @param   flags a combination of PMU_COUNT_KERNEL, PMU_COUNT_USER and PMU_COUNT_INTERRUPT
+/// @returns None (void)
+void pmu_counter_init(struct pmu_counter *ctr, enum pmu_event event, uint8_t flags)
+{
+    ctr->count = 0;
+    ctr->start = 0;
+    ctr->event = (uint8_t) event;
+    ctr->flags = flags;
+    ctr->slot  = PMU_SLOT_NONE;
+    ctr->cpu   = 0;
+}
+
+/// @fn      static int pmu_slot_alloc(unsigned int cpu, const struct pmu_counter *ctr)
+/// @brief   Chooses a free hardware slot able to count the counter's event.
+///
+/// @param   cpu the logical index of the executing processor
+/// @param   ctr the counter needing a slot
+/// @returns a slot number, -ENODEV if the event is not implemented, or -EBUSY if every suitable slot is taken
+static int pmu_slot_alloc(unsigned int cpu, const struct pmu_counter *ctr)
+{
+    const struct pmu_cpu *pc = &pmu_cpus[cpu];
+    int fixed = pmu_event_fixed[ctr->event];
+
+    if (fixed >= 0 && fixed < pc->nr_fixed && !pc->fixed[fixed])
+        return PMU_SLOT_FIXED + fixed;
+    if (cpu_info[cpu].pmu_events_unavailable & (1u << ctr->event))
+        return -ENODEV;
+    for (int i = 0; i < pc->nr_gp; i++)
+        if (!pc->gp[i])
+            return i;
+    return -EBUSY;
+}
+
+/// @fn      static void pmu_load(struct pmu_cpu *pc, struct pmu_counter *ctr, int slot)
+/// @brief   Makes a counter resident in a hardware slot, updating the control shadows but not the global enables.
+///
+/// @details The slot's current value is taken as the counter's baseline instead of zeroing the hardware counter,
+/// which saves one WRMSR per counter on every context switch.
+///
+/// @param   pc   the executing processor's PMU state
+/// @param   ctr  the counter to load
+/// @param   slot the hardware slot returned by pmu_slot_alloc()
+/// @returns None (void)
+static void pmu_load(struct pmu_cpu *pc, struct pmu_counter *ctr, int slot)
+{
+    ctr->slot  = (int8_t) slot;
+    ctr->start = _rdpmc(pmu_rdpmc_index(slot));
+
+    if (slot >= PMU_SLOT_FIXED) {
+        int n = slot - PMU_SLOT_FIXED;
+        uint64_t bits = (ctr->flags & PMU_COUNT_KERNEL    ? FIXED_CTRL_OS  : 0)
+                      | (ctr->flags & PMU_COUNT_USER      ? FIXED_CTRL_USR : 0)
+                      | (ctr->flags & PMU_COUNT_INTERRUPT ? FIXED_CTRL_PMI : 0);
+        pc->fixed[n]     = ctr;
+        pc->fixed_ctrl  |= bits << (n * FIXED_CTRL_BITS);
+        pc->global_ctrl |= 1ULL << (32 + n);
+    } else {
+        uint64_t sel = pmu_event_codes[ctr->event] | PERFEVTSEL_EN
+                     | (ctr->flags & PMU_COUNT_KERNEL    ? PERFEVTSEL_OS  : 0)
+                     | (ctr->flags & PMU_COUNT_USER      ? PERFEVTSEL_USR : 0)
+                     | (ctr->flags & PMU_COUNT_INTERRUPT ? PERFEVTSEL_INT : 0);
+        pc->gp[slot]     = ctr;
+        pc->global_ctrl |= 1ULL << slot;
+        _wrmsr(IA32_PERFEVTSEL0 + slot, sel);
+    }
+}
+
+/// @fn      static void pmu_unload(struct pmu_cpu *pc, struct pmu_counter *ctr)
+/// @brief   Folds a resident counter's hardware delta into its count and releases its slot.
+///
+/// @param   pc  the executing processor's PMU state
+/// @param   ctr the counter to unload
+/// @returns None (void)
+static void pmu_unload(struct pmu_cpu *pc, struct pmu_counter *ctr)
+{
+    int      slot  = ctr->slot;
+    uint64_t value = _rdpmc(pmu_rdpmc_index(slot));
+
+    if (slot >= PMU_SLOT_FIXED) {
+        int n = slot - PMU_SLOT_FIXED;
+        pc->fixed[n]     = NULL;
+        pc->fixed_ctrl  &= ~(0xFULL << (n * FIXED_CTRL_BITS));
+        pc->global_ctrl &= ~(1ULL << (32 + n));
+        ctr->count      += (value - ctr->start) & pc->fixed_value_mask;
+    } else {
+        pc->gp[slot]     = NULL;
+        pc->global_ctrl &= ~(1ULL << slot);
+        ctr->count      += (value - ctr->start) & pc->gp_value_mask;
+    }
+    ctr->slot = PMU_SLOT_NONE;
+}
+
+/// @fn      static void pmu_commit(struct pmu_cpu *pc)
+/// @brief   Writes the fixed-counter and global control registers; the MSR shadow skips the ones that are unchanged.
+///
+/// @param   pc the executing processor's PMU state
+/// @returns None (void)
+static void pmu_commit(struct pmu_cpu *pc)
+{
+    msr_write(MSR_SLOT_FIXED_CTR_CTRL, pc->fixed_ctrl);
+    msr_write(MSR_SLOT_PERF_GLOBAL_CTRL, pc->global_ctrl);
+}
+
+/// @fn      int pmu_counter_start(unsigned int cpu, struct pmu_counter *ctr)
+/// @brief   Starts a counter on the executing processor, where it stays until stopped.
+///
+/// @details Used for per-CPU counters. Per-thread counters are instead added to a pmu_context and loaded by
+/// pmu_context_switch().
+///
+/// @param   cpu the logical index of the executing processor
+/// @param   ctr the counter to start
+/// @returns 0 on success, -EBUSY if the counter is already running or no slot is free, or -ENODEV
+int pmu_counter_start(unsigned int cpu, struct pmu_counter *ctr)
+{
+    struct pmu_cpu *pc = &pmu_cpus[cpu];
+
+    if (ctr->slot != PMU_SLOT_NONE)
+        return -EBUSY;
+
+    int slot = pmu_slot_alloc(cpu, ctr);
+    if (slot < 0)
+        return slot;
+
+    ctr->cpu = (uint16_t) cpu;
+    pmu_load(pc, ctr, slot);
+    pmu_commit(pc);
+    return 0;
+}
+
+/// @fn      void pmu_counter_stop(unsigned int cpu, struct pmu_counter *ctr)
+/// @brief   Stops a running counter on the executing processor, preserving its accumulated count.
+///
+/// @param   cpu the logical index of the executing processor
+/// @param   ctr the counter to stop
+/// @returns None (void)
+void pmu_counter_stop(unsigned int cpu, struct pmu_counter *ctr)
+{
+    struct pmu_cpu *pc = &pmu_cpus[cpu];
+
+    if (ctr->slot == PMU_SLOT_NONE)
+        return;
+    pmu_unload(pc, ctr);
+    pmu_commit(pc);
+}
+
+/// @fn      uint64_t pmu_counter_read(const struct pmu_counter *ctr)
+/// @brief   Returns the current value of a counter.
+///
+/// @details A resident counter is read with RDPMC, so this must run on the processor the counter is resident on.
+///
+/// @param   ctr the counter to read
+/// @returns the number of events counted since pmu_counter_init()
+uint64_t pmu_counter_read(const struct pmu_counter *ctr)
+{
+    const struct pmu_cpu *pc = &pmu_cpus[ctr->cpu];
+
+    if (ctr->slot == PMU_SLOT_NONE)
+        return ctr->count;
+    uint64_t mask = ctr->slot >= PMU_SLOT_FIXED ? pc->fixed_value_mask : pc->gp_value_mask;
+    return ctr->count + ((_rdpmc(pmu_rdpmc_index(ctr->slot)) - ctr->start) & mask);
+}
+
+/// @fn      int pmu_context_add(struct pmu_context *ctx, struct pmu_counter *ctr)
+/// @brief   Attaches a counter to a thread's PMU context; it will count whenever the thread runs.
+///
+/// @param   ctx the thread's PMU context
+/// @param   ctr the counter to attach
+/// @returns 0 on success, or -ENOSPC if the context is full
+int pmu_context_add(struct pmu_context *ctx, struct pmu_counter *ctr)
+{
+    if (ctx->nr_counters >= PMU_CONTEXT_COUNTERS)
+        return -ENOSPC;
+    ctx->counters[ctx->nr_counters++] = ctr;
+    return 0;
+}
+
+/// @fn      static void pmu_update_pce(struct pmu_cpu *pc, bool allow)
+/// @brief   Sets or clears CR4.PCE on the executing processor, writing CR4 only when the bit changes.
+///
+/// @param   pc    the executing processor's PMU state
+/// @param   allow whether RDPMC is allowed at CPL 3
+/// @returns None (void)
+static void pmu_update_pce(struct pmu_cpu *pc, bool allow)
+{
+    if (pc->pce == allow)
+        return;
+
+    uint64_t cr4 = _rdcr4();
+    _wrcr4(allow ? cr4 | CR4_PCE : cr4 & ~CR4_PCE);
+    pc->pce = allow;
+}
+
+/// @fn      void pmu_context_switch(unsigned int cpu, struct pmu_context *prev, struct pmu_context *next)
+/// @brief   Saves the outgoing thread's counters and loads the incoming thread's.
+///
+/// @details Called by the scheduler on every context switch. Per-CPU counters started with pmu_counter_start() are left
+/// running. The fixed and global control registers are written at most once each, and not at all when neither thread
+/// has counters. A thread counter that finds no free slot simply does not count for that time slice. CR4.PCE follows
+/// the incoming thread's RDPMC permission.
+///
+/// @param   cpu  the logical index of the executing processor
+/// @param   prev the outgoing thread's context, or NULL
+/// @param   next the incoming thread's context, or NULL
+/// @returns None (void)
+void pmu_context_switch(unsigned int cpu, struct pmu_context *prev, struct pmu_context *next)
+{
+    struct pmu_cpu *pc = &pmu_cpus[cpu];
+
+    if (prev == next)
+        return;
+    pmu_update_pce(pc, pc->user_rdpmc || (next && next->user_rdpmc));
+    if (prev)
+        for (unsigned int i = 0; i < prev->nr_counters; i++)
+            if (prev->counters[i]->slot != PMU_SLOT_NONE)
+                pmu_unload(pc, prev->counters[i]);
+    if (next)
+        for (unsigned int i = 0; i < next->nr_counters; i++) {
+            struct pmu_counter *ctr = next->counters[i];
+            int slot = pmu_slot_alloc(cpu, ctr);
+            if (slot >= 0) {
+                ctr->cpu = (uint16_t) cpu;
+                pmu_load(pc, ctr, slot);
+            }
+        }
+    pmu_commit(pc);
+}
+
+/// @fn      void pmu_set_user_rdpmc(bool allow)
+/// @brief   Allows or forbids RDPMC at CPL 3 on the executing processor.
+///
+/// @details Privileged user-space servers that own counters on a CPU can read them directly with RDPMC instead of
+/// entering the kernel. The setting is per-CPU because CR4 is; threads that opened counters with PMU_OPEN_RDPMC may
+/// use RDPMC regardless.
+///
+/// @param   allow true to set CR4.PCE, false to clear it
+/// @returns None (void)
+void pmu_set_user_rdpmc(bool allow)
+{
+    struct pmu_cpu            *pc  = &pmu_cpus[cpu_id()];
+    const struct thread       *t   = this_cpu_read(current);
+    const struct pmu_context  *ctx = t ? t->pmu : NULL;
+
+    pc->user_rdpmc = allow;
+    pmu_update_pce(pc, allow || (ctx && ctx->user_rdpmc));
+}
+
+/// @fn      void pmu_counter_rearm(struct pmu_counter *ctr, uint64_t period)
+/// @brief   Presets a resident counter so that it overflows after period more events.
+///
+/// @details Used by sampling clients together with PMU_COUNT_INTERRUPT. General-purpose counters written through
+/// IA32_PMCx take a sign-extended 32-bit value, so period must be below 2^31. The counter's accumulated count is not
+/// meaningful for a sampling counter and is left untouched.
+///
+/// @param   ctr    a counter resident on the executing processor
+/// @param   period the number of events until the next overflow
+/// @returns None (void)
+void pmu_counter_rearm(struct pmu_counter *ctr, uint64_t period)
+{
+    const struct pmu_cpu *pc = &pmu_cpus[ctr->cpu];
+
+    if (ctr->slot >= PMU_SLOT_FIXED) {
+        ctr->start = -period & pc->fixed_value_mask;
+        _wrmsr(IA32_FIXED_CTR0 + ctr->slot - PMU_SLOT_FIXED, ctr->start);
+    } else {
+        ctr->start = -period & pc->gp_value_mask;
+        _wrmsr(IA32_PMC0 + ctr->slot, ctr->start);
+    }
+}
+
+/// @fn      void pmu_release(struct thread *t)
+/// @brief   Frees a thread's PMU context. Called once the thread has exited and been switched away from.
+///
+/// @param   t the exited thread
+/// @returns None (void)
+void pmu_release(struct thread *t)
+{
+    if (t->pmu) {
+        slab_free(&pmu_context_cache, t->pmu);
+        t->pmu = NULL;
+    }
+}
+
+/// @fn      static struct pmu_context *pmu_context_get(struct thread *t)
+/// @brief   Returns a thread's PMU context, allocating an empty one on first use.
+///
+/// @param   t the thread
+/// @returns the context, or NULL if none could be allocated
+static struct pmu_context *pmu_context_get(struct thread *t)
+{
+    struct pmu_context *ctx = t->pmu;
+
+    if (!ctx) {
+        ctx = pmu_context_cache.cpus ? slab_alloc(&pmu_context_cache) : NULL;
+        if (!ctx)
+            return NULL;
+        ctx->nr_counters = 0;
+        ctx->nr_owned    = 0;
+        ctx->user_rdpmc  = false;
+        t->pmu           = ctx;
+    }
+    return ctx;
+}
+
+/// @fn      int64_t pmu_sys_open(struct syscall_frame *frame)
+/// @brief   SYS_PMU_OPEN: starts counting an event (RDI) for the calling thread, or on the executing CPU.
+///
+/// @details Only threads created with THREAD_PRIVILEGED may open counters. By default the counter is virtualized: it
+/// counts user-mode events of the caller only, is saved and restored with it, and counts nothing while others run. With
+/// PMU_OPEN_CPU in RSI it instead counts user- and kernel-mode events of every thread on the executing processor, keeps
+/// its hardware slot until the processor goes down, and can only be read there, so a server normally pins one thread to
+/// each processor it watches. PMU_OPEN_RDPMC also sets CR4.PCE whenever the caller runs; RDPMC then reads the raw
+/// hardware counter, whose selector SYS_PMU_READ returns in RDX, and the difference of two reads taken within one time
+/// slice counts the events between them.
+///
+/// @param   frame the caller's saved registers
+/// @returns the counter's handle for SYS_PMU_READ, -EPERM for an unprivileged caller, -EINVAL for a bad event or flag,
+///          -ENOSPC if the thread or processor already has all the counters it may open, -EBUSY if no slot is free for
+///          a per-CPU counter, -ENODEV without a usable PMU, or -ENOMEM
+int64_t pmu_sys_open(struct syscall_frame *frame)
+{
+    struct thread  *self  = this_cpu_read(current);
+    unsigned int    cpu   = cpu_id();
+    struct pmu_cpu *pc    = &pmu_cpus[cpu];
+    uint64_t        flags = frame->rsi;
+    int64_t         handle;
+
+    if (!(self->flags & THREAD_PRIVILEGED))
+        return -EPERM;
+    if (frame->rdi >= PMU_EVENT_COUNT || (flags & ~(uint64_t) (PMU_OPEN_CPU | PMU_OPEN_RDPMC)))
+        return -EINVAL;
+    if (!pc->nr_gp)
+        return -ENODEV;
+
+    struct pmu_context *ctx = NULL;
+    if (!(flags & PMU_OPEN_CPU) || (flags & PMU_OPEN_RDPMC)) {
+        ctx = pmu_context_get(self);
+        if (!ctx)
+            return -ENOMEM;
+    }
+
+    if (flags & PMU_OPEN_CPU) {
+        if (pc->nr_owned >= PMU_CPU_COUNTERS)
+            return -ENOSPC;
+        struct pmu_counter *ctr = &pc->owned[pc->nr_owned];
+        pmu_counter_init(ctr, (enum pmu_event) frame->rdi, PMU_COUNT_KERNEL | PMU_COUNT_USER);
+        int err = pmu_counter_start(cpu, ctr);
+        if (err)
+            return err;
+        handle = (int64_t) (PMU_HANDLE_CPU | ((uint64_t) cpu << PMU_HANDLE_CPU_SHIFT) | pc->nr_owned++);
+    } else {
+        if (ctx->nr_owned >= PMU_CONTEXT_COUNTERS || ctx->nr_counters >= PMU_CONTEXT_COUNTERS)
+            return -ENOSPC;
+        handle = ctx->nr_owned++;
+        struct pmu_counter *ctr = &ctx->owned[handle];
+        pmu_counter_init(ctr, (enum pmu_event) frame->rdi, PMU_COUNT_USER);
+        pmu_context_add(ctx, ctr);
+        pmu_counter_start(cpu, ctr);        /* -EBUSY just means it waits for a slot at the next switch */
+    }
+
+    if (flags & PMU_OPEN_RDPMC) {
+        ctx->user_rdpmc = true;
+        pmu_update_pce(pc, true);
+    }
+    return handle;
+}
+
+/// @fn      int64_t pmu_sys_read(struct syscall_frame *frame)
+/// @brief   SYS_PMU_READ: returns the count of a counter (RDI, a handle from SYS_PMU_OPEN).
+///
+/// @details A thread counter can be read only by its thread. A per-CPU counter can be read by any privileged thread
+/// running on that counter's processor. RDX receives the counter's RDPMC selector while it is resident, or UINT64_MAX
+/// when a thread counter found no free slot in the current time slice.
+///
+/// @param   frame the caller's saved registers
+/// @returns the number of events counted since the counter was opened, -EPERM if an unprivileged thread names a
+///          per-CPU counter, or -EINVAL for a bad handle or a per-CPU counter of another processor
+int64_t pmu_sys_read(struct syscall_frame *frame)
+{
+    const struct thread      *self   = this_cpu_read(current);
+    uint64_t                  handle = frame->rdi;
+    const struct pmu_counter *ctr;
+
+    if (handle & PMU_HANDLE_CPU) {
+        unsigned int          cpu   = cpu_id();
+        const struct pmu_cpu *pc    = &pmu_cpus[cpu];
+        uint64_t              index = handle & PMU_HANDLE_INDEX_MASK;
+
+        if (!(self->flags & THREAD_PRIVILEGED))
+            return -EPERM;
+        if (handle != (PMU_HANDLE_CPU | ((uint64_t) cpu << PMU_HANDLE_CPU_SHIFT) | index) || index >= pc->nr_owned)
+            return -EINVAL;
+        ctr = &pc->owned[index];
+    } else {
+        const struct pmu_context *ctx = self->pmu;
+
+        if (!ctx || handle >= ctx->nr_owned)
+            return -EINVAL;
+        ctr = &ctx->owned[handle];
+    }
+
+    frame->rdx = ctr->slot == PMU_SLOT_NONE ? UINT64_MAX : pmu_rdpmc_index(ctr->slot);
+    return (int64_t) (pmu_counter_read(ctr) & INT64_MAX);
+}
@@ -0,0 +1,210 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/prof.c                                                                            |
+// | Name          : x86 NMI Sampling Profiler (Source)                                                                |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Records interrupted RIPs on reference-cycle counter overflow, delivered as NMI.                   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/msr.h"
+#include "arch/percpu.h"
+#include "arch/prof.h"
+#include "arch/syscall.h"
+#include "arch/tsc.h"
+#include "kern/thread.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+#include "sys/spinlock.h"
+
+struct prof_cpu prof_cpus[CONFIG_MAX_CPUS];
+
+/// Serializes the consumers of the rings: prof_drain() and SYS_PROF_DRAIN may both be used.
+static struct spinlock prof_drain_lock = SPINLOCK_INIT;
+
+_Static_assert(sizeof(struct prof_sample) % 8 == 0, "samples are copied to user mode in 8-byte words");
+
+#define PROF_PERIOD_MAX              0x7FFFFFFFULL
+
+/// @fn      int prof_start(unsigned int cpu, uint32_t sample_hz)
+/// @brief   Starts sampling on the executing processor at approximately sample_hz samples per second.
+///
+/// @details Sampling counts unhalted reference cycles, which tick at the TSC rate, so the period follows directly from
+/// the calibrated TSC frequency and does not drift with turbo or power-saving frequency changes. Idle (halted) time
+/// generates no samples. The PMI is routed to the NMI vector, whose IDT gate uses the IST_NMI stack, so samples are
+/// taken even inside interrupt-disabled kernel code.
+///
+/// @param   cpu       the logical index of the executing processor
+/// @param   sample_hz the desired sampling rate per CPU
+/// @returns 0 on success, -EINVAL for a rate the counter cannot express, or a pmu_counter_start() error
+int prof_start(unsigned int cpu, uint32_t sample_hz)
+{
+    struct prof_cpu *pc = &prof_cpus[cpu];
+
+    if (pc->active)
+        return -EBUSY;
+    if (sample_hz == 0 || tsc_clock.hz / sample_hz == 0 || tsc_clock.hz / sample_hz > PROF_PERIOD_MAX)
+        return -EINVAL;
+
+    pc->period = tsc_clock.hz / sample_hz;
+    pmu_counter_init(&pc->counter, PMU_EVENT_REF_CYCLES, PMU_COUNT_KERNEL | PMU_COUNT_USER | PMU_COUNT_INTERRUPT);
+    int ret = pmu_counter_start(cpu, &pc->counter);
+    if (ret < 0)
+        return ret;
+
+    pmu_counter_rearm(&pc->counter, pc->period);
+    apic_write(APIC_REG_LVT_PMI, APIC_LVT_DM_NMI);
+    __atomic_store_n(&pc->active, true, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/// @fn      void prof_stop(unsigned int cpu)
+/// @brief   Stops sampling on the executing processor. Buffered samples remain available to prof_drain().
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void prof_stop(unsigned int cpu)
+{
+    struct prof_cpu *pc = &prof_cpus[cpu];
+
+    if (!pc->active)
+        return;
+    __atomic_store_n(&pc->active, false, __ATOMIC_RELEASE);
+    pmu_counter_stop(cpu, &pc->counter);
+}
+
+/// @fn      bool prof_nmi(unsigned int cpu, uint64_t rip, uint32_t thread)
+/// @brief   NMI-time sample handler.
+///
+/// @details Called from the NMI handler on the IST_NMI stack. NMIs are shared, so the overflow status is checked and
+/// false is returned when the profiler's counter did not cause this NMI. The handler takes no locks and touches only
+/// this CPU's ring; when the consumer falls behind, the sample is counted as dropped rather than overwriting unread
+/// samples. Cost per sample is two MSR writes to rearm and acknowledge, one to unmask the LVT entry, and one RDMSR.
+///
+/// @param   cpu    the logical index of the executing processor
+/// @param   rip    the instruction pointer at which the processor was interrupted
+/// @param   thread the identifier of the interrupted thread
+/// @returns true if the NMI was a profiler overflow and has been handled, otherwise false
+bool prof_nmi(unsigned int cpu, uint64_t rip, uint32_t thread)
+{
+    struct prof_cpu  *pc   = &prof_cpus[cpu];
+    struct prof_ring *ring = &pc->ring;
+
+    if (!__atomic_load_n(&pc->active, __ATOMIC_ACQUIRE))
+        return false;
+
+    uint64_t bit = pmu_overflow_bit(&pc->counter);
+    if (!(_rdmsr(IA32_PERF_GLOBAL_STATUS) & bit))
+        return false;
+
+    uint64_t head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) < PROF_RING_SIZE) {
+        struct prof_sample *s = &ring->samples[head & (PROF_RING_SIZE - 1)];
+        s->rip    = rip;
+        s->tsc    = _rdtsc();
+        s->cpu    = cpu;
+        s->thread = thread;
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    } else {
+        ring->dropped++;
+    }
+
+    pmu_counter_rearm(&pc->counter, pc->period);
+    _wrmsr(IA32_PERF_OVF_CTRL, bit);
+    // The processor masks the LVT entry each time it delivers a PMI, so it is rewritten unmasked before returning.
+    apic_write(APIC_REG_LVT_PMI, APIC_LVT_DM_NMI);
+    return true;
+}
+
+/// @fn      size_t prof_drain(unsigned int cpu, struct prof_sample *out, size_t max)
+/// @brief   Copies buffered samples of one CPU out of its ring, oldest first.
+///
+/// @details May run on any processor. Consumers are serialized with SYS_PROF_DRAIN, so a kernel client and the
+/// profiling server may share the rings. The returned RIPs are symbolized off-line.
+///
+/// @param   cpu the logical index of the processor whose samples are wanted
+/// @param   out the buffer receiving samples
+/// @param   max the capacity of out, in samples
+/// @returns the number of samples copied
+size_t prof_drain(unsigned int cpu, struct prof_sample *out, size_t max)
+{
+    struct prof_ring *ring = &prof_cpus[cpu].ring;
+    size_t            n    = 0;
+
+    uint64_t irq = irq_save();
+    spin_lock(&prof_drain_lock);
+    uint64_t tail = ring->tail;
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    while (tail != head && n < max)
+        out[n++] = ring->samples[tail++ & (PROF_RING_SIZE - 1)];
+    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    spin_unlock(&prof_drain_lock);
+    irq_restore(irq);
+    return n;
+}
+
+/// @fn      int64_t prof_sys_drain(struct syscall_frame *frame)
+/// @brief   SYS_PROF_DRAIN: copies buffered samples of one CPU into the calling thread's memory, oldest first.
+///
+/// @details Reserved for the profiling server, a thread created with THREAD_PRIVILEGED: samples carry the user RIPs of
+/// every address space, and draining consumes them. The samples are copied straight from the ring, in at most two runs
+/// when it wraps, and are consumed only once the copy has succeeded, so a fault loses none of them.
+///
+/// @param   frame the caller's registers: RDI the CPU, RSI the buffer's user address (8-byte aligned), RDX its capacity
+///                in samples
+/// @returns the number of samples copied, -EPERM for an unprivileged caller, -EINVAL for a bad CPU or buffer or a
+/// kernel-only thread, or -EFAULT if the buffer is not mapped writable for user mode
+int64_t prof_sys_drain(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+    uint64_t       va   = frame->rsi;
+    uint64_t       max  = frame->rdx;
+    int            err  = 0;
+
+    if (!(self->flags & THREAD_PRIVILEGED))
+        return -EPERM;
+    if (frame->rdi >= CONFIG_MAX_CPUS || !self->vm || va > vm_config.user_end)
+        return -EINVAL;
+    if (max > (vm_config.user_end - va) / sizeof(struct prof_sample))
+        max = (vm_config.user_end - va) / sizeof(struct prof_sample);
+
+    struct prof_ring *ring = &prof_cpus[frame->rdi].ring;
+
+    uint64_t irq = irq_save();
+    spin_lock(&prof_drain_lock);
+    uint64_t tail = ring->tail;
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint64_t n    = head - tail < max ? head - tail : max;
+    for (uint64_t done = 0; done < n && !err;) {
+        uint64_t first = (tail + done) & (PROF_RING_SIZE - 1);
+        uint64_t run   = PROF_RING_SIZE - first < n - done ? PROF_RING_SIZE - first : n - done;
+        err   = vm_copy_out(self->vm, va + done * sizeof(struct prof_sample), &ring->samples[first],
+                            run * sizeof(struct prof_sample));
+        done += run;
+    }
+    if (!err)
+        __atomic_store_n(&ring->tail, tail + n, __ATOMIC_RELEASE);
+    spin_unlock(&prof_drain_lock);
+    irq_restore(irq);
+    return err ? err : (int64_t) n;
+}
\ No newline at end of file
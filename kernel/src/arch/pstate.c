@@ -0,0 +1,368 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/pstate.c                                                                          |
+// | Name          : x86 Performance Policy (Source)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Programs HWP requests or PERF_CTL ratios and energy bias from per-CPU and per-thread policy.      |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+#include "arch/percpu.h"
+#include "arch/pstate.h"
+#include "arch/tsc.h"
+#include "arch/vectors.h"
+#include "kern/thread.h"
+#include "sys/errno.h"
+
+struct pstate_config pstate_config = {
+    .lock = SPINLOCK_INIT,
+};
+struct pstate_cpu pstate_cpus[CONFIG_MAX_CPUS];
+
+static struct cpumask pstate_online;
+
+#define PM_ENABLE_HWP                (1ULL << 0)
+
+#define HWP_CAP_HIGHEST(v)           ((uint8_t) ((v) >> 0))
+#define HWP_CAP_GUARANTEED(v)        ((uint8_t) ((v) >> 8))
+#define HWP_CAP_EFFICIENT(v)         ((uint8_t) ((v) >> 16))
+#define HWP_CAP_LOWEST(v)            ((uint8_t) ((v) >> 24))
+
+#define HWP_REQUEST(min, max, epp)   ((uint64_t) (min) | (uint64_t) (max) << 8 | (uint64_t) (epp) << 24)
+
+#define PERF_CTL_RATIO(r)            ((uint64_t) (r) << 8)
+#define PERF_CTL_TURBO_DISENGAGE     (1ULL << 32)
+
+#define MISC_ENABLE_EIST             (1ULL << 16)
+#define MISC_ENABLE_TURBO_DISABLE    (1ULL << 38)
+
+#define PSTATE_BUS_MHZ_DEFAULT       100            /* bus clock of every Intel core since Sandy Bridge */
+
+// HWP energy/performance preference (0 favours performance, 255 energy) and the IA32_ENERGY_PERF_BIAS hint (0 to 15)
+// used in its place when HWP lacks EPP or is absent. The balanced values match what firmware usually programs.
+static const uint8_t pstate_epp[PSTATE_POLICIES] = {
+    [PSTATE_DEFAULT]     = 0x80,
+    [PSTATE_EFFICIENCY]  = 0xC0,
+    [PSTATE_BALANCED]    = 0x80,
+    [PSTATE_PERFORMANCE] = 0x00,
+};
+
+static const uint8_t pstate_epb[PSTATE_POLICIES] = {
+    [PSTATE_DEFAULT]     = 6,
+    [PSTATE_EFFICIENCY]  = 8,
+    [PSTATE_BALANCED]    = 6,
+    [PSTATE_PERFORMANCE] = 0,
+};
+
+/// @fn      static void pstate_configure(void)
+/// @brief   Selects the P-state mechanism and creates the default domain.
+///
+/// @details HWP is preferred whenever it is enumerated: once firmware or the kernel has enabled it, IA32_PERF_CTL is
+/// ignored, so a PERF_CTL-only driver would silently lose control on HWP parts. Every CPU starts in domain 0, which
+/// runs the balanced policy.
+///
+/// @returns None (void)
+static void pstate_configure(void)
+{
+    if (cpu_has(CPU_FEATURE_HWP))
+        pstate_config.mode = PSTATE_MODE_HWP;
+    else if (cpu_has(CPU_FEATURE_EIST))
+        pstate_config.mode = PSTATE_MODE_PERF_CTL;
+
+    pstate_config.epp              = pstate_config.mode == PSTATE_MODE_HWP && cpu_has(CPU_FEATURE_HWP_EPP);
+    pstate_config.epb              = cpu_has(CPU_FEATURE_EPB);
+    pstate_config.nr_domains       = 1;
+    pstate_config.domain_policy[0] = PSTATE_BALANCED;
+}
+
+/// @fn      static void pstate_levels(unsigned int cpu, struct pstate_cpu *pc)
+/// @brief   Determines the executing processor's performance levels.
+///
+/// @details With HWP the levels come from IA32_HWP_CAPABILITIES, which differ between core types on hybrid parts.
+/// Otherwise they are bus ratios derived from CPUID leaf 0x16; the lowest and most efficient ratios are not
+/// architecturally enumerated and are left at zero, which the PERF_CTL path never uses.
+///
+/// @param   cpu the logical index of the executing processor
+/// @param   pc  the processor's policy state
+/// @returns None (void)
+static void pstate_levels(unsigned int cpu, struct pstate_cpu *pc)
+{
+    if (pstate_config.mode == PSTATE_MODE_HWP) {
+        uint64_t caps = _rdmsr(IA32_HWP_CAPABILITIES);
+        pc->highest    = HWP_CAP_HIGHEST(caps);
+        pc->guaranteed = HWP_CAP_GUARANTEED(caps);
+        pc->efficient  = HWP_CAP_EFFICIENT(caps);
+        pc->lowest     = HWP_CAP_LOWEST(caps);
+        return;
+    }
+
+    const struct cpu_info *info = &cpu_info[cpu];
+    uint64_t bus_hz = (uint64_t) (info->bus_mhz ? info->bus_mhz : PSTATE_BUS_MHZ_DEFAULT) * 1000000;
+    uint64_t base   = info->base_mhz ? (uint64_t) info->base_mhz * 1000000 : tsc_clock.hz;
+    uint64_t max    = info->max_mhz ? (uint64_t) info->max_mhz * 1000000 : 0;
+
+    pc->guaranteed = (uint8_t) (base / bus_hz);
+    pc->highest    = max ? (uint8_t) (max / bus_hz) : 0xFF;     /* requests above the top ratio are clamped */
+}
+
+/// @fn      void pstate_init(unsigned int cpu)
+/// @brief   Takes over P-state control on the executing processor and applies its policy.
+///
+/// @details Must run on every processor after cpu_features_init() and tsc_init(), with interrupts disabled. Turbo is
+/// re-enabled in IA32_MISC_ENABLE if firmware disabled it, since the performance policy depends on it and the
+/// efficiency policy disengages it per CPU instead. Domain membership and per-CPU overrides set before the processor
+/// came online are kept.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void pstate_init(unsigned int cpu)
+{
+    struct pstate_cpu *pc = &pstate_cpus[cpu];
+
+    if (cpu == 0)
+        pstate_configure();
+
+    if (pstate_config.mode != PSTATE_MODE_NONE) {
+        uint64_t misc = _rdmsr(IA32_MISC_ENABLE);
+        uint64_t want = misc & ~MISC_ENABLE_TURBO_DISABLE;
+        if (pstate_config.mode == PSTATE_MODE_PERF_CTL)
+            want |= MISC_ENABLE_EIST;
+        if (want != misc)
+            _wrmsr(IA32_MISC_ENABLE, want);
+
+        if (pstate_config.mode == PSTATE_MODE_HWP && !(_rdmsr(IA32_PM_ENABLE) & PM_ENABLE_HWP))
+            _wrmsr(IA32_PM_ENABLE, PM_ENABLE_HWP);
+        pstate_levels(cpu, pc);
+    }
+
+    spin_lock(&pstate_config.lock);
+    pc->policy = pc->override != PSTATE_DEFAULT ? pc->override : pstate_config.domain_policy[pc->domain];
+    cpumask_set_atomic(&pstate_online, cpu);
+    spin_unlock(&pstate_config.lock);
+
+    pstate_apply(cpu, pc->policy);
+}
+
+/// @fn      void pstate_apply(unsigned int cpu, uint8_t policy)
+/// @brief   Programs the executing processor's performance request for a policy.
+///
+/// @details Called with interrupts disabled, normally through pstate_update(). Under HWP the performance policy sets
+/// the minimum to the highest level, so the core stays at full frequency however idle-heavy its load looks, and the
+/// efficiency policy caps the maximum at the guaranteed level. Under PERF_CTL the performance policy requests the top
+/// turbo ratio and the efficiency policy the base ratio with turbo disengaged.
+///
+/// @param   cpu    the logical index of the executing processor
+/// @param   policy the enum pstate_policy to apply
+/// @returns None (void)
+void pstate_apply(unsigned int cpu, uint8_t policy)
+{
+    struct pstate_cpu *pc = &pstate_cpus[cpu];
+
+    switch (pstate_config.mode) {
+    case PSTATE_MODE_HWP: {
+        uint8_t min = policy == PSTATE_PERFORMANCE ? pc->highest : pc->lowest;
+        uint8_t max = policy == PSTATE_EFFICIENCY ? pc->guaranteed : pc->highest;
+        msr_write(MSR_SLOT_HWP_REQUEST, HWP_REQUEST(min, max, pstate_config.epp ? pstate_epp[policy] : 0));
+        pc->writes++;
+        break;
+    }
+    case PSTATE_MODE_PERF_CTL: {
+        uint64_t ctl = PERF_CTL_RATIO(policy == PSTATE_PERFORMANCE ? pc->highest : pc->guaranteed);
+        if (policy == PSTATE_EFFICIENCY)
+            ctl |= PERF_CTL_TURBO_DISENGAGE;
+        msr_write(MSR_SLOT_PERF_CTL, ctl);
+        pc->writes++;
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (pstate_config.epb && !pstate_config.epp) {
+        msr_write(MSR_SLOT_ENERGY_PERF_BIAS, pstate_epb[policy]);
+        pc->writes++;
+    }
+
+    pc->applied = policy;
+    pc->switches[policy]++;
+}
+
+/// @fn      static bool pstate_refresh(unsigned int cpu, struct cpumask *remote)
+/// @brief   Recomputes a processor's CPU-level policy after a setting changed.
+///
+/// @details Called with the configuration lock held and interrupts disabled. The executing processor reprograms itself
+/// at once; other online processors whose policy changed are collected for a reschedule IPI, whose handler,
+/// sched_ipi_interrupt(), calls pstate_update() for the thread running there. An idle processor applies the new policy
+/// when it next dispatches a thread.
+///
+/// @param   cpu    the logical index of the processor
+/// @param   remote mask collecting processors that must be interrupted
+/// @returns true if cpu was added to remote
+static bool pstate_refresh(unsigned int cpu, struct cpumask *remote)
+{
+    struct pstate_cpu *pc     = &pstate_cpus[cpu];
+    uint8_t            policy = pc->override != PSTATE_DEFAULT ? pc->override : pstate_config.domain_policy[pc->domain];
+
+    if (pc->policy == policy)
+        return false;
+    __atomic_store_n(&pc->policy, policy, __ATOMIC_RELAXED);
+
+    if (!cpumask_test(&pstate_online, cpu))
+        return false;
+    if (cpu == this_cpu_read(cpu)) {
+        const struct thread *self = this_cpu_read(current);
+        pstate_update(cpu, self->perf_policy);
+        return false;
+    }
+    cpumask_set(remote, cpu);
+    return true;
+}
+
+/// @fn      int pstate_set_cpu_policy(unsigned int cpu, enum pstate_policy policy)
+/// @brief   Pins a processor to a policy regardless of its domain, or returns it to its domain's policy.
+///
+/// @param   cpu    the logical index of the processor
+/// @param   policy the policy to pin, or PSTATE_DEFAULT to follow the domain again
+/// @returns 0 on success, or -EINVAL if cpu or policy is out of range
+int pstate_set_cpu_policy(unsigned int cpu, enum pstate_policy policy)
+{
+    struct cpumask remote;
+    bool           kick;
+
+    if (cpu >= CONFIG_MAX_CPUS || policy >= PSTATE_POLICIES)
+        return -EINVAL;
+
+    cpumask_clear_all(&remote);
+    uint64_t flags = irq_save();
+    spin_lock(&pstate_config.lock);
+    pstate_cpus[cpu].override = (uint8_t) policy;
+    kick = pstate_refresh(cpu, &remote);
+    spin_unlock(&pstate_config.lock);
+    irq_restore(flags);
+
+    if (kick)
+        apic_send_ipi(cpu, VECTOR_IPI_RESCHEDULE);
+    return 0;
+}
+
+/// @fn      int pstate_domain_create(const struct cpumask *cpus, enum pstate_policy policy)
+/// @brief   Creates a performance domain and moves a set of processors into it.
+///
+/// @details A domain groups the cores that serve one purpose, such as the cores polling network and storage queues,
+/// so that their policy can be changed together. Each processor belongs to exactly one domain; the ones named here
+/// leave whichever domain they were in.
+///
+/// @param   cpus   the processors to move into the new domain
+/// @param   policy the domain's initial policy
+/// @returns the new domain's index, -EINVAL if policy is out of range or PSTATE_DEFAULT, or -ENOSPC if all
+///          PSTATE_MAX_DOMAINS domains exist
+int pstate_domain_create(const struct cpumask *cpus, enum pstate_policy policy)
+{
+    struct cpumask remote;
+    bool           kick = false;
+    int            cpu, domain;
+
+    if (policy == PSTATE_DEFAULT || policy >= PSTATE_POLICIES)
+        return -EINVAL;
+
+    cpumask_clear_all(&remote);
+    uint64_t flags = irq_save();
+    spin_lock(&pstate_config.lock);
+    if (pstate_config.nr_domains == PSTATE_MAX_DOMAINS) {
+        domain = -ENOSPC;
+    } else {
+        domain = (int) pstate_config.nr_domains++;
+        pstate_config.domain_policy[domain] = (uint8_t) policy;
+        for_each_cpu(cpu, cpus) {
+            pstate_cpus[cpu].domain = (uint8_t) domain;
+            kick |= pstate_refresh((unsigned int) cpu, &remote);
+        }
+    }
+    spin_unlock(&pstate_config.lock);
+    irq_restore(flags);
+
+    if (kick)
+        apic_send_ipi_mask(&remote, VECTOR_IPI_RESCHEDULE);
+    return domain;
+}
+
+/// @fn      int pstate_set_domain_policy(unsigned int domain, enum pstate_policy policy)
+/// @brief   Changes the policy of every processor in a domain that is not individually pinned.
+///
+/// @param   domain the domain index returned by pstate_domain_create(), or 0 for the default domain
+/// @param   policy the new policy
+/// @returns 0 on success, or -EINVAL if the domain does not exist or policy is out of range or PSTATE_DEFAULT
+int pstate_set_domain_policy(unsigned int domain, enum pstate_policy policy)
+{
+    struct cpumask remote;
+    bool           kick = false;
+    int            rc   = 0;
+
+    if (policy == PSTATE_DEFAULT || policy >= PSTATE_POLICIES)
+        return -EINVAL;
+
+    cpumask_clear_all(&remote);
+    uint64_t flags = irq_save();
+    spin_lock(&pstate_config.lock);
+    if (domain >= pstate_config.nr_domains) {
+        rc = -EINVAL;
+    } else {
+        pstate_config.domain_policy[domain] = (uint8_t) policy;
+        for (unsigned int cpu = 0; cpu < CONFIG_MAX_CPUS; cpu++)
+            if (pstate_cpus[cpu].domain == domain)
+                kick |= pstate_refresh(cpu, &remote);
+    }
+    spin_unlock(&pstate_config.lock);
+    irq_restore(flags);
+
+    if (kick)
+        apic_send_ipi_mask(&remote, VECTOR_IPI_RESCHEDULE);
+    return rc;
+}
+
+/// @fn      int pstate_set_thread_policy(struct thread *t, enum pstate_policy policy)
+/// @brief   Sets the policy a thread requests on whichever processor runs it.
+///
+/// @details A thread's policy can only raise its CPU's, never lower it: a batch thread stolen onto a pinned core runs
+/// at full speed rather than slowing the core's latency-critical threads. The change applies immediately if t is the
+/// calling thread, and otherwise when t is next dispatched.
+///
+/// @param   t      the thread
+/// @param   policy the requested policy, or PSTATE_DEFAULT to run at the CPU's policy
+/// @returns 0 on success, or -EINVAL if policy is out of range
+int pstate_set_thread_policy(struct thread *t, enum pstate_policy policy)
+{
+    if (policy >= PSTATE_POLICIES)
+        return -EINVAL;
+
+    __atomic_store_n(&t->perf_policy, (uint8_t) policy, __ATOMIC_RELAXED);
+
+    uint64_t flags = irq_save();
+    if (t == this_cpu_read(current))
+        pstate_update(this_cpu_read(cpu), (uint8_t) policy);
+    irq_restore(flags);
+    return 0;
+}
\ No newline at end of file
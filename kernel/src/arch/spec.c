@@ -0,0 +1,202 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/spec.c                                                                            |
+// | Name          : Speculation Barriers                                                                              |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Issues IBPB and L1D flushes only where execution crosses between differently trusted domains.     |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+#include "arch/spec.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+struct spec_config spec_config;
+struct spec_cpu    spec_cpus[CONFIG_MAX_CPUS];
+
+#define SPEC_CTRL_IBRS               (1ULL << 0)
+#define SPEC_CTRL_STIBP              (1ULL << 1)
+#define SPEC_CTRL_SSBD               (1ULL << 2)
+
+#define PRED_CMD_IBPB                (1ULL << 0)
+#define FLUSH_CMD_L1D                (1ULL << 0)
+
+/// @fn      static void spec_configure(void)
+/// @brief   Reads the processor's mitigation support and immunities once, and sets the default policy.
+///
+/// @details Only the Intel enumeration (CPUID leaf 7 and IA32_ARCH_CAPABILITIES) is consulted. IBPB has no immunity
+/// bit: predictions trained in one user domain can always steer another. The L1D flush is unnecessary on parts that
+/// are immune to both L1TF (RDCL_NO) and MDS (MDS_NO); on MD_CLEAR parts it also clears the fill buffers. With
+/// enhanced IBRS, IBRS is simply left on everywhere, which also implies STIBP. Every label starts with SPEC_IBPB, so
+/// domains are isolated from each other's branch predictions once they are given different labels and cost nothing
+/// while they share one.
+///
+/// @returns None (void)
+static void spec_configure(void)
+{
+    uint8_t available = 0, immune = 0;
+
+    if (cpu_has(CPU_FEATURE_SPEC_CTRL))
+        available |= SPEC_IBPB;
+    if (cpu_has(CPU_FEATURE_FLUSH_L1D))
+        available |= SPEC_L1D_FLUSH;
+    if (cpu_has(CPU_FEATURE_STIBP))
+        available |= SPEC_STIBP;
+    if (cpu_has(CPU_FEATURE_SSBD))
+        available |= SPEC_SSBD;
+
+    if (cpu_has(CPU_FEATURE_RDCL_NO) && cpu_has(CPU_FEATURE_MDS_NO))
+        immune |= SPEC_L1D_FLUSH;
+    if (cpu_has(CPU_FEATURE_IBRS_ALL)) {
+        immune                    |= SPEC_STIBP;
+        spec_config.spec_ctrl_base = SPEC_CTRL_IBRS;
+    }
+    if (cpu_has(CPU_FEATURE_SSB_NO))
+        immune |= SPEC_SSBD;
+
+    spec_config.spec_ctrl = cpu_has(CPU_FEATURE_SPEC_CTRL) || cpu_has(CPU_FEATURE_SSBD);
+    spec_config.available = available;
+    spec_config.needed    = available & ~immune;
+    for (unsigned int i = 0; i < SPEC_MAX_LABELS; i++)
+        spec_config.label_policy[i] = SPEC_IBPB;
+}
+
+/// @fn      void spec_init(unsigned int cpu)
+/// @brief   Sets up mitigations on the executing processor.
+///
+/// @details Must run on every processor after cpu_features_init() and msr_shadow_init_cpu(), with interrupts disabled.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void spec_init(unsigned int cpu)
+{
+    if (cpu == 0)
+        spec_configure();
+
+    spec_cpus[cpu].label = SPEC_LABEL_NONE;
+    if (spec_config.spec_ctrl)
+        msr_write(MSR_SLOT_SPEC_CTRL, spec_config.spec_ctrl_base);
+}
+
+/// @fn      static void spec_barrier(struct spec_cpu *sc, enum spec_barrier barrier, bool wanted, bool issue)
+/// @brief   Issues one barrier if it is both requested and useful, and counts the outcome.
+///
+/// @param   sc      the executing processor's state
+/// @param   barrier the barrier
+/// @param   wanted  a policy on either side of the switch asks for it
+/// @param   issue   the labels differ and the processor is not immune
+/// @returns None (void)
+static void spec_barrier(struct spec_cpu *sc, enum spec_barrier barrier, bool wanted, bool issue)
+{
+    if (!wanted)
+        return;
+    if (!issue) {
+        sc->skipped[barrier]++;
+        return;
+    }
+
+    if (barrier == SPEC_BARRIER_IBPB)
+        _wrmsr(IA32_PRED_CMD, PRED_CMD_IBPB);
+    else
+        _wrmsr(IA32_FLUSH_CMD, FLUSH_CMD_L1D);
+    sc->issued[barrier]++;
+}
+
+/// @fn      void spec_switch(unsigned int cpu, const struct vm_space *next)
+/// @brief   Applies the mitigations due when the executing processor loads another address space.
+///
+/// @details Called by vm_switch(), so switches within one space, and through kernel threads that borrow it, never
+/// get here. The kernel space is trusted and does not count as a domain: a user domain is compared with the last
+/// user domain this processor ran. Domains sharing a label trust each other, so IPC between them and every system
+/// call cost no barrier at all. On a crossing, IBPB and the L1D flush are issued if either label's policy asks for
+/// them, and the incoming label's SPEC_CTRL controls are queued for the return to user mode, where the MSR shadow
+/// drops the write if the value is unchanged.
+///
+/// @param   cpu  the logical index of the executing processor
+/// @param   next the space being loaded
+/// @returns None (void)
+void spec_switch(unsigned int cpu, const struct vm_space *next)
+{
+    struct spec_cpu *sc = &spec_cpus[cpu];
+
+    if (next == &vm_kernel)
+        return;
+
+    uint8_t label  = next->spec_label;
+    uint8_t policy = __atomic_load_n(&spec_config.label_policy[label], __ATOMIC_RELAXED);
+    bool    cross  = label != sc->label;
+
+    if (sc->label != SPEC_LABEL_NONE)
+        policy |= __atomic_load_n(&spec_config.label_policy[sc->label], __ATOMIC_RELAXED) & ~(SPEC_STIBP | SPEC_SSBD);
+
+    uint8_t issue = cross ? spec_config.needed : 0;
+    spec_barrier(sc, SPEC_BARRIER_IBPB, policy & SPEC_IBPB, issue & SPEC_IBPB);
+    spec_barrier(sc, SPEC_BARRIER_L1D_FLUSH, policy & SPEC_L1D_FLUSH, issue & SPEC_L1D_FLUSH);
+    if (!cross)
+        return;
+
+    sc->label = label;
+    sc->crossings++;
+    if (spec_config.spec_ctrl) {
+        uint64_t ctrl = spec_config.spec_ctrl_base;
+        if (policy & spec_config.needed & SPEC_STIBP)
+            ctrl |= SPEC_CTRL_STIBP;
+        if (policy & spec_config.needed & SPEC_SSBD)
+            ctrl |= SPEC_CTRL_SSBD;
+        msr_write_deferred(MSR_SLOT_SPEC_CTRL, ctrl);
+    }
+}
+
+/// @fn      int spec_set_label_policy(unsigned int label, unsigned int policy)
+/// @brief   Sets the mitigations of every domain carrying a label.
+///
+/// @details Takes effect at each processor's next crossing into or out of the label.
+///
+/// @param   label  the trust label
+/// @param   policy SPEC_* flags
+/// @returns 0 on success, or -EINVAL if the label or a flag is out of range
+int spec_set_label_policy(unsigned int label, unsigned int policy)
+{
+    if (label >= SPEC_MAX_LABELS || (policy & ~SPEC_POLICY_MASK))
+        return -EINVAL;
+    __atomic_store_n(&spec_config.label_policy[label], (uint8_t) policy, __ATOMIC_RELAXED);
+    return 0;
+}
+
+/// @fn      int spec_set_domain_label(struct vm_space *space, unsigned int label)
+/// @brief   Assigns a trust label to a user address space. Spaces start with label 0.
+///
+/// @details Meant to be called before the space first runs; a processor already running it applies the new label at
+/// its next switch into the space.
+///
+/// @param   space the space
+/// @param   label the trust label
+/// @returns 0 on success, or -EINVAL if the space is the kernel's or the label is out of range
+int spec_set_domain_label(struct vm_space *space, unsigned int label)
+{
+    if (space == &vm_kernel || label >= SPEC_MAX_LABELS)
+        return -EINVAL;
+    __atomic_store_n(&space->spec_label, (uint8_t) label, __ATOMIC_RELAXED);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/syscall.c                                                                         |
+// | Name          : x86 System Call Entry (Source)                                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Configures SYSCALL/SYSRET and dispatches system calls through a constant table.                   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/cr.h"
+#include "arch/idle.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/msr_shadow.h"
+#include "arch/percpu.h"
+#include "arch/pmu.h"
+#include "arch/prof.h"
+#include "arch/segment.h"
+#include "arch/syscall.h"
+#include "arch/telemetry.h"
+#include "kern/chan.h"
+#include "kern/intr.h"
+#include "kern/ipc.h"
+#include "kern/thread.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+// RFLAGS bits cleared on SYSCALL entry: TF, IF, DF, NT and AC. The kernel runs the fast path with interrupts disabled.
+#define SYSCALL_RFLAGS_MASK          0x00044700ULL
+
+/// @fn      static int64_t sys_null(struct syscall_frame *frame)
+/// @brief   System call that does nothing; used to measure the raw kernel entry and exit cost.
+///
+/// @param   frame the caller's saved registers
+/// @returns 0
+static int64_t sys_null(struct syscall_frame *frame)
+{
+    (void) frame;
+    return 0;
+}
+
+/// @fn      static int64_t sys_umwait_policy(struct syscall_frame *frame)
+/// @brief   Reports the limits the kernel imposes on user-mode UMWAIT and TPAUSE.
+///
+/// @details Servers polling shared-memory rings use the result to size their wait deadlines and to pick the C0.1 or
+/// C0.2 hint: bits 31:2 are the maximum wait in TSC cycles (0 for none) and bit 0 is set if C0.2 is disallowed, as in
+/// IA32_UMWAIT_CONTROL.
+///
+/// @param   frame the caller's saved registers
+/// @returns the current IA32_UMWAIT_CONTROL value, or -ENODEV if the processor lacks WAITPKG
+static int64_t sys_umwait_policy(struct syscall_frame *frame)
+{
+    (void) frame;
+    if (!idle_config.waitpkg)
+        return -ENODEV;
+    return idle_config.umwait_control;
+}
+
+/// @fn      static int64_t sys_tls_base(struct syscall_frame *frame)
+/// @brief   Sets the caller's user FS and GS bases (RDI and RSI), for thread-local storage.
+///
+/// @details Where FSGSBASE is available user mode can also use WRFSBASE and WRGSBASE directly, behind the shadow's
+/// back, so the shadow is refreshed from the registers first; otherwise a stale shadow equal to the new value would
+/// make msr_shadow_apply() skip a write that is needed. Either way the bases are written on the way back to user mode,
+/// and only if they changed.
+///
+/// @param   frame the caller's saved registers
+/// @returns 0, or -EINVAL if a base is not a user address
+static int64_t sys_tls_base(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+
+    if (frame->rdi >= vm_config.user_end || frame->rsi >= vm_config.user_end)
+        return -EINVAL;
+
+    if (msr_fsgsbase) {
+        msr_read_base(MSR_SLOT_FS_BASE);
+        msr_read_base(MSR_SLOT_USER_GS_BASE);
+    }
+    self->fs_base = frame->rdi;
+    self->gs_base = frame->rsi;
+    msr_write_deferred(MSR_SLOT_FS_BASE, self->fs_base);
+    msr_write_deferred(MSR_SLOT_USER_GS_BASE, self->gs_base);
+    return 0;
+}
+
+static const syscall_fn syscall_table[SYS_COUNT] = {
+    [SYS_NULL]           = sys_null,
+    [SYS_UMWAIT_POLICY]  = sys_umwait_policy,
+    [SYS_IPC_CALL]       = ipc_sys_call,
+    [SYS_IPC_REPLY_WAIT] = ipc_sys_reply_wait,
+    [SYS_IPC_BUFFER]     = ipc_sys_buffer,
+    [SYS_CHAN_CREATE]    = chan_sys_create,
+    [SYS_CHAN_MAP]       = chan_sys_map,
+    [SYS_CHAN_WAIT]      = chan_sys_wait,
+    [SYS_CHAN_NOTIFY]    = chan_sys_notify,
+    [SYS_INTR_CREATE]    = intr_sys_create,
+    [SYS_INTR_BIND]      = intr_sys_bind,
+    [SYS_INTR_AFFINITY]  = intr_sys_affinity,
+    [SYS_INTR_WAIT]      = intr_sys_wait,
+    [SYS_TLS_BASE]       = sys_tls_base,
+    [SYS_PMU_OPEN]       = pmu_sys_open,
+    [SYS_PMU_READ]       = pmu_sys_read,
+    [SYS_PROF_DRAIN]     = prof_sys_drain,
+    [SYS_TELEMETRY_MAP]  = telemetry_sys_map,
+};
+
+/// @fn      int64_t syscall_dispatch(struct syscall_frame *frame)
+/// @brief   Invokes the handler selected by the system call number in RAX.
+///
+/// @details Called by both entry stubs with interrupts disabled. The table is constant, so the lookup is a bounds check
+/// and an indirect call.
+///
+/// @param   frame the caller's saved registers
+/// @returns the value placed in the caller's RAX
+int64_t syscall_dispatch(struct syscall_frame *frame)
+{
+    uint64_t nr = frame->rax;
+
+    if (nr >= SYS_COUNT || !syscall_table[nr])
+        return -ENOSYS;
+    return syscall_table[nr](frame);
+}
+
+/// @fn      void syscall_init(void)
+/// @brief   Enables SYSCALL/SYSRET on the executing processor.
+///
+/// @details Must run on every processor after percpu_init(). STAR selects the kernel selectors for SYSCALL and the
+/// user selectors for SYSRET according to the layout in arch/segment.h. The legacy INT gate at SYSCALL_VECTOR is
+/// installed with the IDT, not here.
+///
+/// @returns None (void)
+void syscall_init(void)
+{
+    if (!cpu_has(CPU_FEATURE_SYSCALL))
+        return;
+
+    _wrmsr(IA32_STAR, ((uint64_t) (SEL_USER_CODE32 & ~SEG_RPL_USER) << 48) | ((uint64_t) SEL_KERNEL_CODE << 32));
+    _wrmsr(IA32_LSTAR, (uint64_t) (uintptr_t) syscall_entry);
+    _wrmsr(IA32_FMASK, SYSCALL_RFLAGS_MASK);
+    _wrmsr(IA32_EFER, _rdmsr(IA32_EFER) | EFER_SCE);
+}
\ No newline at end of file
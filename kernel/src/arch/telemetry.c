@@ -0,0 +1,252 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/telemetry.c                                                                       |
+// | Name          : x86 Frequency and Thermal Telemetry (Source)                                                      |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Samples APERF/MPERF and thermal MSRs and publishes per-CPU results.                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "arch/syscall.h"
+#include "arch/telemetry.h"
+#include "arch/tsc.h"
+#include "kern/thread.h"
+#include "mm/layout.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+struct telemetry_page telemetry_page;
+
+/// Kernel-private sampling state; kept out of the published page.
+static struct telemetry_state {
+    uint64_t aperf;
+    uint64_t mperf;
+    uint64_t tsc;
+    uint64_t next_tsc;                  ///< earliest TSC at which telemetry_tick() samples again
+    uint8_t  therm_active;              ///< THERM_STATUS throttle bits seen at the previous sample
+} __cacheline_aligned telemetry_state[CONFIG_MAX_CPUS];
+
+static uint64_t telemetry_interval_tsc;
+
+// IA32_THERM_STATUS and IA32_PACKAGE_THERM_STATUS share this layout for the fields used here.
+#define THERM_STATUS_THROTTLE        (1ULL << 0)
+#define THERM_STATUS_THROTTLE_LOG    (1ULL << 1)
+#define THERM_STATUS_PROCHOT         (1ULL << 2)
+#define THERM_STATUS_PROCHOT_LOG     (1ULL << 3)
+#define THERM_STATUS_POWER_LIMIT     (1ULL << 10)
+#define THERM_STATUS_POWER_LIMIT_LOG (1ULL << 11)
+#define THERM_STATUS_CURRENT_LIMIT   (1ULL << 12)
+#define THERM_STATUS_CURRENT_LOG     (1ULL << 13)
+#define THERM_STATUS_READOUT(v)      (((v) >> 16) & 0x7F)
+#define THERM_STATUS_VALID           (1ULL << 31)
+#define THERM_STATUS_LOGS            (THERM_STATUS_THROTTLE_LOG | THERM_STATUS_PROCHOT_LOG | \
+                                      THERM_STATUS_POWER_LIMIT_LOG | THERM_STATUS_CURRENT_LOG)
+
+#define CLOCK_MODULATION_ENABLE      (1ULL << 4)
+#define PERF_STATUS_RATIO(v)         (((v) >> 8) & 0xFF)
+
+#define TELEMETRY_RATIO_LIMIT        (1ULL << 40)   /* APERF delta kept below this so kHz * delta fits 64 bits */
+
+_Static_assert(TELEMETRY_PAGE_SIZE == PAGE_SIZE, "the telemetry region is mapped page by page");
+
+/// @fn      void telemetry_init(unsigned int cpu)
+/// @brief   Starts telemetry on the executing processor by taking a baseline sample.
+///
+/// @details Must run on every processor after tsc_init(); the bootstrap processor's call also fills in the header.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void telemetry_init(unsigned int cpu)
+{
+    struct telemetry_header *hdr = &telemetry_page.header;
+
+    if (cpu == 0) {
+        telemetry_interval_tsc = tsc_ns_to_cycles(CONFIG_TELEMETRY_INTERVAL_NS);
+        hdr->version     = TELEMETRY_VERSION;
+        hdr->tsc_hz      = tsc_clock.hz;
+        hdr->interval_us = CONFIG_TELEMETRY_INTERVAL_NS / 1000;
+        if (cpu_has(CPU_FEATURE_APERFMPERF))
+            hdr->features |= TELEMETRY_HAS_APERFMPERF;
+        if (cpu_has(CPU_FEATURE_ACPI) && cpu_has(CPU_FEATURE_DTS))
+            hdr->features |= TELEMETRY_HAS_THERMAL;
+        if (cpu_has(CPU_FEATURE_PTM))
+            hdr->features |= TELEMETRY_HAS_PACKAGE;
+    }
+
+    unsigned int nr = __atomic_load_n(&hdr->nr_cpus, __ATOMIC_RELAXED);
+    while (nr < cpu + 1 && !__atomic_compare_exchange_n(&hdr->nr_cpus, &nr, cpu + 1, true, __ATOMIC_RELEASE,
+                                                        __ATOMIC_RELAXED))
+        ;
+
+    telemetry_sample(cpu);
+}
+
+/// @fn      static uint32_t telemetry_thermal(unsigned int cpu, struct telemetry_cpu *rec)
+/// @brief   Reads the core and package thermal status, counting new throttle episodes and clearing consumed log bits.
+///
+/// @details An episode is counted when a status bit is active now but was not at the previous sample, or when its
+/// sticky log bit shows it came and went in between. Log bits are cleared by writing zero to them, and only when one
+/// was set, so a quiet CPU pays two RDMSRs here and no WRMSR.
+///
+/// @param   cpu the logical index of the executing processor
+/// @param   rec the record being updated
+/// @returns the TELEMETRY_* throttling flags in force
+static uint32_t telemetry_thermal(unsigned int cpu, struct telemetry_cpu *rec)
+{
+    struct telemetry_header *hdr   = &telemetry_page.header;
+    struct telemetry_state  *st    = &telemetry_state[cpu];
+    uint32_t                 flags = 0;
+
+    if (hdr->features & TELEMETRY_HAS_THERMAL) {
+        uint64_t v      = _rdmsr(IA32_THERM_STATUS);
+        uint8_t  active = (uint8_t) (v & (THERM_STATUS_THROTTLE | THERM_STATUS_PROCHOT | THERM_STATUS_POWER_LIMIT));
+        uint8_t  rising = active & ~st->therm_active;
+
+        if ((rising & (THERM_STATUS_THROTTLE | THERM_STATUS_PROCHOT)) ||
+            (v & (THERM_STATUS_THROTTLE_LOG | THERM_STATUS_PROCHOT_LOG)))
+            rec->thermal_events++;
+        if ((rising & THERM_STATUS_POWER_LIMIT) ||
+            (v & (THERM_STATUS_POWER_LIMIT_LOG | THERM_STATUS_CURRENT_LOG)))
+            rec->power_limit_events++;
+        if (v & THERM_STATUS_LOGS)
+            _wrmsr(IA32_THERM_STATUS, THERM_STATUS_LOGS & ~(v & THERM_STATUS_LOGS));
+        st->therm_active = active;
+
+        if (v & THERM_STATUS_THROTTLE)
+            flags |= TELEMETRY_THERMAL_THROTTLE;
+        if (v & THERM_STATUS_PROCHOT)
+            flags |= TELEMETRY_PROCHOT;
+        if (v & (THERM_STATUS_POWER_LIMIT | THERM_STATUS_CURRENT_LIMIT))
+            flags |= TELEMETRY_POWER_LIMIT;
+        if (v & THERM_STATUS_VALID)
+            rec->thermal_margin_c = (uint32_t) THERM_STATUS_READOUT(v);
+
+        if (_rdmsr(IA32_CLOCK_MODULATION) & CLOCK_MODULATION_ENABLE)
+            flags |= TELEMETRY_CLOCK_MODULATION;
+    }
+
+    if (hdr->features & TELEMETRY_HAS_PACKAGE) {
+        uint64_t v = _rdmsr(IA32_PACKAGE_THERM_STATUS);
+        if (v & THERM_STATUS_LOGS) {
+            if (v & (THERM_STATUS_THROTTLE_LOG | THERM_STATUS_PROCHOT_LOG))
+                __atomic_fetch_add(&hdr->package_thermal_events, 1, __ATOMIC_RELAXED);
+            if (v & THERM_STATUS_POWER_LIMIT_LOG)
+                __atomic_fetch_add(&hdr->package_power_limit_events, 1, __ATOMIC_RELAXED);
+            _wrmsr(IA32_PACKAGE_THERM_STATUS, THERM_STATUS_LOGS & ~(v & THERM_STATUS_LOGS));
+        }
+        if (v & (THERM_STATUS_THROTTLE | THERM_STATUS_PROCHOT))
+            flags |= TELEMETRY_THERMAL_THROTTLE;
+    }
+    return flags;
+}
+
+/// @fn      void telemetry_sample(unsigned int cpu)
+/// @brief   Samples the executing processor's counters and republishes its record.
+///
+/// @details Effective frequency is the TSC rate scaled by dAPERF/dMPERF, and the busy ratio is dMPERF/dTSC; MPERF
+/// advances at the TSC rate only in C0, so both hold however the interval was split between running and idling. The
+/// ratio is taken in kHz with both deltas scaled down together after a long gap, so only 64-bit arithmetic is used.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void telemetry_sample(unsigned int cpu)
+{
+    struct telemetry_cpu   *rec = &telemetry_page.cpus[cpu];
+    struct telemetry_state *st  = &telemetry_state[cpu];
+    uint64_t                tsc = _rdtsc();
+    uint32_t                seq = rec->seq;
+
+    __atomic_store_n(&rec->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (telemetry_page.header.features & TELEMETRY_HAS_APERFMPERF) {
+        uint64_t aperf = _rdmsr(IA32_APERF), mperf = _rdmsr(IA32_MPERF);
+        uint64_t da = aperf - st->aperf, dm = mperf - st->mperf, dt = tsc - st->tsc;
+
+        if (st->tsc && dm && dt) {
+            uint64_t sa = da, sm = dm;
+            while (sa >= TELEMETRY_RATIO_LIMIT) {
+                sa >>= 1;
+                sm >>= 1;
+            }
+            rec->effective_mhz = (uint32_t) (sm ? tsc_clock.hz / 1000 * sa / sm / 1000 : 0);
+            rec->busy_permille = (uint32_t) (dm >= dt ? 1000 : dm * 1000 / dt);
+            rec->aperf        += da;
+            rec->mperf        += dm;
+        }
+        st->aperf = aperf;
+        st->mperf = mperf;
+    }
+    rec->perf_status_ratio = (uint32_t) PERF_STATUS_RATIO(_rdmsr(IA32_PERF_STATUS));
+    rec->flags             = telemetry_thermal(cpu, rec);
+    rec->timestamp_ns      = tsc_cycles_to_ns(tsc - tsc_clock.base);
+
+    st->tsc      = tsc;
+    st->next_tsc = tsc + telemetry_interval_tsc;
+    __atomic_store_n(&rec->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/// @fn      void telemetry_tick(unsigned int cpu)
+/// @brief   Samples if the interval has elapsed. Cheap enough for every scheduling decision and idle transition.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void telemetry_tick(unsigned int cpu)
+{
+    if (_rdtsc() >= telemetry_state[cpu].next_tsc)
+        telemetry_sample(cpu);
+}
+
+/// @fn      int64_t telemetry_sys_map(struct syscall_frame *frame)
+/// @brief   SYS_TELEMETRY_MAP: maps the telemetry region read-only into the calling thread's address space.
+///
+/// @details The region lives in the kernel image, whose pages need not be physically contiguous, so each page is
+/// looked up in the kernel space and mapped on its own. The mapping is user-readable, never writable or executable;
+/// readers take snapshots with telemetry_read(). A failure part way removes the pages already mapped.
+///
+/// @param   frame the caller's registers: RDI the address to map the TELEMETRY_PAGES pages at, page aligned
+/// @returns 0 on success, -EINVAL for a bad address or a kernel-only thread, -EEXIST if part of the range is already
+/// mapped, or -ENOMEM if a page table could not be allocated
+int64_t telemetry_sys_map(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+    uint64_t       va   = frame->rdi;
+    uint64_t       size = TELEMETRY_PAGES * PAGE_SIZE;
+    int            err  = 0;
+
+    if (!self->vm || va & ~PAGE_MASK || va > vm_config.user_end - size)
+        return -EINVAL;
+
+    for (uint64_t off = 0; off < size; off += PAGE_SIZE) {
+        uint64_t pa;
+        if ((err = vm_translate(&vm_kernel, (uint64_t) (uintptr_t) &telemetry_page + off, &pa, NULL)) ||
+            (err = vm_map(self->vm, va + off, pa, PAGE_SIZE, PTE_U | vm_config.nx))) {
+            if (off)
+                vm_unmap(self->vm, va, off);
+            break;
+        }
+    }
+    return err;
+}
@@ -0,0 +1,151 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/tsc.c                                                                             |
+// | Name          : x86 TSC Clocksource (Source)                                                                      |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Detects invariant TSC and calibrates its frequency from CPUID or the legacy PIT.                  |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/tsc.h"
+
+struct tsc_clock tsc_clock;
+
+// Legacy 8254 PIT. Channel 2 is used because its gate is software-controlled through port 0x61 and its output can be
+// polled there, so calibration needs neither an interrupt handler nor the IRQ 0 routing.
+#define PIT_HZ              1193182
+#define PIT_CH2_DATA        0x42
+#define PIT_COMMAND         0x43
+#define PIT_CH2_MODE0_LOHI  0xB0
+#define PIT_PORT_B          0x61
+#define PIT_PORT_B_GATE2    0x01
+#define PIT_PORT_B_SPEAKER  0x02
+#define PIT_PORT_B_OUT2     0x20
+
+#define PIT_CALIBRATE_TICKS 11932           /* ~10 ms */
+#define PIT_CALIBRATE_RUNS  3
+
+#define TSC_SHIFT           32
+#define NSEC_PER_SEC        1000000000ULL
+
+/// @fn      static uint64_t tsc_hz_from_cpuid(void)
+/// @brief   Derives the TSC frequency from CPUID leaves 0x15 and 0x16, if the processor enumerates them.
+///
+/// @details Leaf 0x15 gives the exact TSC/crystal ratio; when the crystal frequency is also reported the result is
+/// exact. Otherwise the nominal base frequency from leaf 0x16 is used, which is correct to within the rounding of the
+/// reported MHz value on parts where the TSC runs at base frequency.
+///
+/// @returns the TSC frequency in Hz, or 0 if CPUID does not provide enough information
+static uint64_t tsc_hz_from_cpuid(void)
+{
+    const struct cpu_info *info = &cpu_info[0];
+
+    if (info->tsc_denominator && info->tsc_numerator && info->crystal_hz)
+        return (uint64_t) info->crystal_hz * info->tsc_numerator / info->tsc_denominator;
+    if (info->base_mhz)
+        return (uint64_t) info->base_mhz * 1000000;
+    return 0;
+}
+
+/// @fn      static uint64_t tsc_pit_measure(void)
+/// @brief   Measures how many TSC cycles elapse during one PIT channel-2 one-shot countdown.
+///
+/// @details Channel 2 is programmed in mode 0 (interrupt on terminal count) with the speaker output disabled. OUT2 in
+/// port 0x61 goes high when the count expires, which is polled with interrupts assumed disabled.
+///
+/// @returns the TSC delta over PIT_CALIBRATE_TICKS PIT ticks
+static uint64_t tsc_pit_measure(void)
+{
+    uint8_t portb = _inb(PIT_PORT_B);
+
+    _outb(PIT_PORT_B, (portb & ~PIT_PORT_B_SPEAKER) & ~PIT_PORT_B_GATE2);
+    _outb(PIT_COMMAND, PIT_CH2_MODE0_LOHI);
+    _outb(PIT_CH2_DATA, PIT_CALIBRATE_TICKS & 0xFF);
+    _outb(PIT_CH2_DATA, PIT_CALIBRATE_TICKS >> 8);
+
+    _outb(PIT_PORT_B, (portb & ~PIT_PORT_B_SPEAKER) | PIT_PORT_B_GATE2);
+    uint64_t start = _rdtsc();
+    while (!(_inb(PIT_PORT_B) & PIT_PORT_B_OUT2))
+        ;
+    uint64_t end = _rdtsc();
+
+    _outb(PIT_PORT_B, portb);
+    return end - start;
+}
+
+/// @fn      static uint64_t tsc_hz_from_pit(void)
+/// @brief   Calibrates the TSC frequency against the PIT.
+///
+/// @details Several runs are taken and the shortest is kept: an SMI or a hypervisor preemption can only lengthen a
+/// measurement, never shorten it.
+///
+/// @returns the TSC frequency in Hz
+static uint64_t tsc_hz_from_pit(void)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < PIT_CALIBRATE_RUNS; i++) {
+        uint64_t delta = tsc_pit_measure();
+        if (delta < best)
+            best = delta;
+    }
+    return best * PIT_HZ / PIT_CALIBRATE_TICKS;
+}
+
+/// @fn      void tsc_init(void)
+/// @brief   Determines the TSC frequency and prepares the fixed-point conversion factors used by ktime_ns().
+///
+/// @details Must run on the bootstrap processor after cpu_features_init(0) and with interrupts disabled. The divisions
+/// needed to derive the multipliers are performed here, once, so that no clock read ever divides. hz << TSC_SHIFT does
+/// not fit in 64 bits, so inv_mult is built from the whole and fractional gigahertz separately, each with a 64-bit
+/// divide; the kernel never needs libgcc's 128-bit division.
+///
+/// @returns None (void)
+void tsc_init(void)
+{
+    uint64_t hz = tsc_hz_from_cpuid();
+
+    tsc_clock.calibrated = (hz == 0);
+    if (hz == 0)
+        hz = tsc_hz_from_pit();
+
+    tsc_clock.hz        = hz;
+    tsc_clock.shift     = TSC_SHIFT;
+    tsc_clock.mult      = (NSEC_PER_SEC << TSC_SHIFT) / hz;
+    tsc_clock.inv_mult  = (hz / NSEC_PER_SEC) << TSC_SHIFT | ((hz % NSEC_PER_SEC) << TSC_SHIFT) / NSEC_PER_SEC;
+    tsc_clock.invariant = cpu_has(CPU_FEATURE_INVARIANT_TSC);
+    tsc_clock.synchronized = true;
+    tsc_clock.base      = _rdtsc();
+}
+
+/// @fn      void tsc_spin_ns(uint64_t ns)
+/// @brief   Busy-waits for at least the given number of nanoseconds.
+///
+/// @param   ns the minimum delay in nanoseconds
+/// @returns None (void)
+void tsc_spin_ns(uint64_t ns)
+{
+    uint64_t start = _rdtsc(), cycles = tsc_ns_to_cycles(ns);
+
+    while (_rdtsc() - start < cycles)
+        _pause();
+}
\ No newline at end of file
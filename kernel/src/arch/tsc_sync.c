@@ -0,0 +1,154 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/arch/tsc_sync.c                                                                        |
+// | Name          : x86 Cross-CPU TSC Synchronization                                                                 |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Measures AP-to-BSP TSC skew at bring-up and removes it through IA32_TSC_ADJUST.                   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/cpu.h"
+#include "arch/inst.h"
+#include "arch/msr.h"
+#include "arch/tsc.h"
+
+struct tsc_sync_result tsc_sync_results[CONFIG_MAX_CPUS];
+
+// Each measurement is a series of cache-line ping-pongs: the AP stamps t0 and posts a request, the BSP stamps its own
+// TSC and replies, and the AP stamps t1 on seeing the reply. The BSP stamp was taken somewhere inside [t0, t1], so
+// assuming the midpoint bounds the error by half the round trip. Only the fastest round of each series is kept, as it
+// has the tightest bound. Every field below is written by exactly one side and sits on its own cache line, so the only
+// coherence traffic is the transfer being timed.
+#define TSC_SYNC_ROUNDS   64
+#define TSC_SYNC_ATTEMPTS 4
+#define TSC_SYNC_DONE     UINT64_MAX
+
+static struct {
+    uint64_t ready        __cacheline_aligned;  /* BSP: logical CPU being synchronized, plus one */
+    uint64_t bsp_adjust;                        /* BSP: its own IA32_TSC_ADJUST value */
+    uint64_t request      __cacheline_aligned;  /* AP: sequence number of the outstanding request */
+    uint64_t reply        __cacheline_aligned;  /* BSP: sequence number being answered */
+    uint64_t reply_tsc;                         /* BSP: TSC sampled for that answer */
+} tsc_sync;
+
+/// @fn      void tsc_sync_bsp(unsigned int cpu)
+/// @brief   Serves TSC samples to an application processor running tsc_sync_ap() until it reports completion.
+///
+/// @details Runs on the bootstrap processor, with interrupts disabled, while the AP identified by cpu runs
+/// tsc_sync_ap(). Application processors are synchronized one at a time.
+///
+/// @param   cpu the logical index of the application processor being synchronized
+/// @returns None (void)
+void tsc_sync_bsp(unsigned int cpu)
+{
+    uint64_t seen = 0, seq;
+
+    tsc_sync.bsp_adjust = cpu_has(CPU_FEATURE_TSC_ADJUST) ? _rdmsr(IA32_TSC_ADJUST) : 0;
+    __atomic_store_n(&tsc_sync.ready, (uint64_t) cpu + 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        while ((seq = __atomic_load_n(&tsc_sync.request, __ATOMIC_ACQUIRE)) == seen)
+            _pause();
+        if (seq == TSC_SYNC_DONE)
+            break;
+        tsc_sync.reply_tsc = tsc_read_ordered();
+        __atomic_store_n(&tsc_sync.reply, seq, __ATOMIC_RELEASE);
+        seen = seq;
+    }
+
+    tsc_sync.request = 0;
+    tsc_sync.reply   = 0;
+    __atomic_store_n(&tsc_sync.ready, 0, __ATOMIC_RELEASE);
+}
+
+/// @fn      static int64_t tsc_sync_measure(uint64_t *seq, uint64_t *round_trip)
+/// @brief   Estimates the skew between the BSP's TSC and the executing AP's TSC.
+///
+/// @param   seq        the AP's running request sequence number
+/// @param   round_trip receives the fastest round trip observed, in cycles
+/// @returns the estimated skew (BSP minus AP), in cycles
+static int64_t tsc_sync_measure(uint64_t *seq, uint64_t *round_trip)
+{
+    uint64_t best = UINT64_MAX;
+    int64_t  skew = 0;
+
+    for (int i = 0; i < TSC_SYNC_ROUNDS; i++) {
+        uint64_t s = ++*seq;
+        uint64_t t0 = tsc_read_ordered();
+        __atomic_store_n(&tsc_sync.request, s, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&tsc_sync.reply, __ATOMIC_ACQUIRE) != s)
+            _pause();
+        uint64_t t1 = tsc_read_ordered();
+        uint64_t tb = tsc_sync.reply_tsc;
+
+        if (t1 - t0 < best) {
+            best = t1 - t0;
+            skew = (int64_t) (tb - (t0 + best / 2));
+        }
+    }
+    *round_trip = best;
+    return skew;
+}
+
+/// @fn      void tsc_sync_ap(unsigned int cpu)
+/// @brief   Aligns the executing application processor's TSC with the bootstrap processor's.
+///
+/// @details Runs on the AP during bring-up, after cpu_features_init(cpu) and with interrupts disabled, while the BSP
+/// runs tsc_sync_bsp(cpu). The AP first inherits the BSP's IA32_TSC_ADJUST, which removes any offset firmware applied
+/// to the BSP alone, then measures the remaining skew and folds it into IA32_TSC_ADJUST until the residual is within
+/// the measurement error, for at most TSC_SYNC_ATTEMPTS corrections. Every correction is followed by a measurement, so
+/// the outcome and the residual always describe the final IA32_TSC_ADJUST value. Without IA32_TSC_ADJUST the skew is
+/// only measured and reported. If the residual cannot be brought within tolerance, tsc_clock.synchronized is cleared so
+/// that cross-CPU users of ktime_ns() know not to compare timestamps taken on different processors.
+///
+/// @param   cpu the logical index of the executing application processor
+/// @returns None (void)
+void tsc_sync_ap(unsigned int cpu)
+{
+    struct tsc_sync_result *res = &tsc_sync_results[cpu];
+    bool     adjustable = cpu_has(CPU_FEATURE_TSC_ADJUST);
+    uint64_t seq = 0, rtt = 0;
+    int64_t  skew = 0;
+
+    while (__atomic_load_n(&tsc_sync.ready, __ATOMIC_ACQUIRE) != (uint64_t) cpu + 1)
+        _pause();
+    if (adjustable)
+        _wrmsr(IA32_TSC_ADJUST, tsc_sync.bsp_adjust);
+
+    res->adjust = 0;
+    res->synchronized = false;
+    for (int attempt = 0;; attempt++) {
+        skew = tsc_sync_measure(&seq, &rtt);
+        if ((uint64_t) (skew < 0 ? -skew : skew) <= rtt / 2) {
+            res->synchronized = true;
+            break;
+        }
+        if (!adjustable || attempt == TSC_SYNC_ATTEMPTS)
+            break;
+        _wrmsr(IA32_TSC_ADJUST, _rdmsr(IA32_TSC_ADJUST) + (uint64_t) skew);
+        res->adjust += skew;
+    }
+    res->residual   = skew;
+    res->round_trip = rtt;
+
+    if (!res->synchronized)
+        __atomic_store_n(&tsc_clock.synchronized, false, __ATOMIC_RELAXED);
+    __atomic_store_n(&tsc_sync.request, TSC_SYNC_DONE, __ATOMIC_RELEASE);
+}
\ No newline at end of file
@@ -0,0 +1,595 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/kern/bench.c                                                                           |
+// | Name          : Benchmarks                                                                                        |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : In-kernel microbenchmarks of entry, IPC, scheduling and memory paths, built with make BENCH=1.    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "arch/msr_shadow.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "arch/segment.h"
+#include "arch/syscall.h"
+#include "arch/vectors.h"
+#include "kern/bench.h"
+#include "kern/chan.h"
+#include "kern/sched.h"
+#include "mm/frame.h"
+#include "mm/layout.h"
+#include "mm/tlb.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+// Results are consumed through this sink so the compiler cannot discard the measured work.
+static volatile uint64_t bench_sink;
+
+/// Partner thread of the scheduler and system call benchmarks, run on a stack of its own.
+struct bench_peer {
+    struct thread  thread;
+    struct thread *partner;             ///< the benchmarking thread, woken by the peer in the ping-pong
+    bool           stop;
+    uint64_t       user_va;             ///< code page of a user-mode peer, followed by its data page
+    uint64_t       batches;             ///< batches a user-mode peer times
+};
+
+// Ring-3 code of the system call benchmark, in kern/bench_user.S.
+extern const uint8_t bench_user_start[];
+extern const uint8_t bench_user_end[];
+
+static struct bench_peer bench_peer;
+static uint8_t           bench_peer_stack[CONFIG_KERNEL_STACK_SIZE] __aligned(16);
+
+/// @fn      static uint64_t bench_rdtsc_call(void)
+/// @brief   RDTSC behind a real call, as every intrinsic was when they were defined out of line.
+///
+/// @returns the time-stamp counter
+static __noinline uint64_t bench_rdtsc_call(void)
+{
+    return _rdtsc();
+}
+
+/// @fn      void bench_intrinsics(struct bench_result *results, uint64_t batches)
+/// @brief   Compares an inlined intrinsic with the same instruction behind an out-of-line call.
+///
+/// @details results[0] times the always-inline _rdtsc(), results[1] the call. The difference is the per-use cost the
+/// header-only intrinsics remove: the call and return, and the caller-saved registers spilled around them.
+///
+/// @param   results BENCH_INTRINSICS_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @returns None (void)
+void bench_intrinsics(struct bench_result *results, uint64_t batches)
+{
+    uint64_t acc = 0;
+
+    BENCH_TIME(&results[0], "rdtsc inline", batches, acc += _rdtsc());
+    BENCH_TIME(&results[1], "rdtsc call", batches, acc += bench_rdtsc_call());
+    bench_sink = acc;
+}
+
+/// @fn      void bench_int(struct bench_result *results, uint64_t batches)
+/// @brief   Measures the cost of raising a software interrupt with a constant and with a run-time vector.
+///
+/// @details Raises VECTOR_SOFTWARE, whose handler returns at once without an EOI, so the loop is safe on a running
+/// kernel with its IDT loaded and never acknowledges an APIC interrupt that is in service. results[0] uses the inline
+/// INT imm8 emitted for a constant vector, results[1] passes the same vector to _int_indirect() and its stub table.
+/// The difference is the call and indirect branch of the dynamic path; both include the full interrupt round trip.
+///
+/// @param   results BENCH_INT_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @returns None (void)
+void bench_int(struct bench_result *results, uint64_t batches)
+{
+    BENCH_TIME(&results[0], "int constant", batches, _int(VECTOR_SOFTWARE));
+    BENCH_TIME(&results[1], "int stub table", batches, _int_indirect(VECTOR_SOFTWARE));
+}
+
+/// @fn      void bench_ipi(struct bench_result *results, uint64_t batches, const struct cpumask *targets)
+/// @brief   Measures the cost of sending IPIs and the round trip of a shootdown that every processor acknowledges.
+///
+/// @details results[0] sends a unicast IPI to the first target, results[1] one multicast to all of them; both time the
+/// sender only, which in x2APIC mode is one WRMSR per cluster and in xAPIC mode an ICR write per target. The vector is
+/// VECTOR_IPI_CALL, whose handler only acknowledges the APIC. results[2] flushes one kernel page everywhere with
+/// tlb_flush(), timing the multicast, the remote handlers and the wait for every acknowledgement. Run with
+/// increasing processor counts (QEMU -smp) to see how each scales. Interrupts should be enabled on the targets.
+///
+/// @param   results BENCH_IPI_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @param   targets the processors to interrupt, excluding the executing one; must not be empty
+/// @returns None (void)
+void bench_ipi(struct bench_result *results, uint64_t batches, const struct cpumask *targets)
+{
+    unsigned int     first = (unsigned int) cpumask_next(targets, -1);
+    struct tlb_batch batch;
+
+    BENCH_TIME(&results[0], "ipi unicast send", batches, apic_send_ipi(first, VECTOR_IPI_CALL));
+    BENCH_TIME(&results[1], "ipi multicast send", batches, apic_send_ipi_mask(targets, VECTOR_IPI_CALL));
+
+    tlb_batch_init(&batch, &vm_kernel);
+    tlb_batch_add(&batch, (uint64_t) (uintptr_t) &bench_sink & PAGE_MASK, PAGE_SIZE);
+    BENCH_TIME(&results[2], "ipi shootdown round trip", batches, tlb_flush(&batch));
+}
+
+/// @fn      static void bench_yield_main(void *arg)
+/// @brief   Peer of the context-switch loop: yields back to the benchmarking thread until told to stop.
+///
+/// @param   arg the struct bench_peer
+/// @returns None (void)
+static void bench_yield_main(void *arg)
+{
+    struct bench_peer *peer = arg;
+
+    while (!__atomic_load_n(&peer->stop, __ATOMIC_ACQUIRE))
+        sched_yield();
+}
+
+/// @fn      static void bench_pong_main(void *arg)
+/// @brief   Peer of the wake-up loop: blocks, and wakes the benchmarking thread each time it is woken itself.
+///
+/// @param   arg the struct bench_peer
+/// @returns None (void)
+static void bench_pong_main(void *arg)
+{
+    struct bench_peer *peer = arg;
+
+    for (;;) {
+        sched_prepare_block();
+        sched_block();
+        if (__atomic_load_n(&peer->stop, __ATOMIC_ACQUIRE))
+            return;
+        while (!sched_wake(peer->partner))
+            _pause();
+    }
+}
+
+/// @fn      static void bench_ping(struct thread *peer)
+/// @brief   Wakes the peer and blocks until it wakes the caller back.
+///
+/// @param   peer the peer thread, blocked or about to block
+/// @returns None (void)
+static void bench_ping(struct thread *peer)
+{
+    sched_prepare_block();
+    while (!sched_wake(peer))
+        _pause();
+    sched_block();
+}
+
+/// @fn      static int bench_peer_start(void (*entry)(void *), unsigned int cpu, struct vm_space *vm)
+/// @brief   Starts the peer thread pinned to a CPU at the caller's priority.
+///
+/// @param   entry the peer's main function
+/// @param   cpu   the logical index of the CPU it runs on
+/// @param   vm    the address space of a peer that enters user mode, which then also takes its entries from user mode
+///                on its own stack, or NULL for a kernel-only peer
+/// @returns 0 on success, or a sched_thread_init() error
+static int bench_peer_start(void (*entry)(void *), unsigned int cpu, struct vm_space *vm)
+{
+    struct thread *self = this_cpu_read(current);
+
+    bench_peer.partner = self;
+    bench_peer.stop    = false;
+    int err = sched_thread_init(&bench_peer.thread, entry, &bench_peer, &bench_peer_stack[sizeof(bench_peer_stack)],
+                                self->priority, THREAD_PINNED);
+    if (err)
+        return err;
+    if (vm) {
+        bench_peer.thread.vm         = vm;
+        bench_peer.thread.kstack_top = (uint64_t) &bench_peer_stack[sizeof(bench_peer_stack)];
+    }
+    sched_add(&bench_peer.thread, cpu);
+    return 0;
+}
+
+/// @fn      static void bench_peer_join(void)
+/// @brief   Waits until the peer thread has exited and left its processor, so its storage can be reused.
+///
+/// @returns None (void)
+static void bench_peer_join(void)
+{
+    while (__atomic_load_n(&bench_peer.thread.state, __ATOMIC_ACQUIRE) != THREAD_DEAD ||
+           __atomic_load_n(&bench_peer.thread.on_cpu, __ATOMIC_ACQUIRE))
+        sched_yield();
+}
+
+/// @fn      int bench_sched(struct bench_result *results, uint64_t batches, unsigned int peer_cpu)
+/// @brief   Measures a context switch and the round trip of a cross-CPU wake-up.
+///
+/// @details Must be called from a pinned thread, not an idle context. results[0] yields to a peer pinned to the
+/// executing processor at the same priority, which yields straight back: each operation is two switches through
+/// schedule(). results[1] wakes a peer blocked on peer_cpu and blocks until the peer wakes the caller: each operation
+/// is two remote wake-ups, two inbox drains and the notifications (MWAIT line store or IPI) that deliver them. The
+/// per-CPU scheduler statistics break the second figure down into wake-up-to-dispatch latency.
+///
+/// @param   results  BENCH_SCHED_RESULTS results to fill in
+/// @param   batches  number of batches to time
+/// @param   peer_cpu the logical index of another processor, idle or running less urgent work
+/// @returns 0 on success, or a sched_thread_init() error
+int bench_sched(struct bench_result *results, uint64_t batches, unsigned int peer_cpu)
+{
+    int err;
+
+    if ((err = bench_peer_start(bench_yield_main, this_cpu_read(cpu), NULL)))
+        return err;
+    BENCH_TIME(&results[0], "sched yield pair", batches, sched_yield());
+    __atomic_store_n(&bench_peer.stop, true, __ATOMIC_RELEASE);
+    bench_peer_join();
+
+    if ((err = bench_peer_start(bench_pong_main, peer_cpu, NULL)))
+        return err;
+    BENCH_TIME(&results[1], "sched remote wake pair", batches, bench_ping(&bench_peer.thread));
+    __atomic_store_n(&bench_peer.stop, true, __ATOMIC_RELEASE);
+    while (!sched_wake(&bench_peer.thread))
+        _pause();
+    bench_peer_join();
+    return 0;
+}
+
+/// @fn      static void bench_user_main(void *arg)
+/// @brief   Peer of the system call benchmark: drops to ring 3 at the copied bench_user_start and never returns.
+///
+/// @details The kernel stack below this frame is the one entries from user mode use, which is harmless because nothing
+/// here runs again. The UD2 that ends the user code faults, and the fault ends the thread.
+///
+/// @param   arg the struct bench_peer
+/// @returns None (void)
+static void bench_user_main(void *arg)
+{
+    const struct bench_peer *peer = arg;
+    uint64_t                 data = peer->user_va + PAGE_SIZE;
+
+    _cli();
+    msr_shadow_apply();
+    asm volatile ("swapgs\n\t"
+                  "pushq   %[ss]\n\t"
+                  "pushq   %[rsp]\n\t"
+                  "pushq   %[rflags]\n\t"
+                  "pushq   %[cs]\n\t"
+                  "pushq   %[rip]\n\t"
+                  "iretq"
+                  :
+                  : [ss] "i" (SEL_USER_DATA), [rsp] "r" (data + PAGE_SIZE), [rflags] "i" (RFLAGS_IF),
+                    [cs] "i" (SEL_USER_CODE), [rip] "r" (peer->user_va), "D" (peer->batches), "S" (data),
+                    "d" (BENCH_BATCH)
+                  : "memory");
+    __builtin_unreachable();
+}
+
+/// @fn      static int64_t bench_legacy_null(void)
+/// @brief   Issues SYS_NULL through the legacy INT SYSCALL_VECTOR gate from ring 0.
+///
+/// @returns the system call's result
+static __always_inline int64_t bench_legacy_null(void)
+{
+    int64_t ret = SYS_NULL;
+
+    asm volatile ("int %1" : "+a" (ret) : "i" (SYSCALL_VECTOR) : "memory");
+    return ret;
+}
+
+/// @fn      int bench_syscall(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+/// @brief   Measures the null system call round trip through SYSCALL and through the legacy INT gate.
+///
+/// @details results[0] and [1] are timed in ring 3 by a peer thread pinned to this processor, running the code of
+/// kern/bench_user.S in space: SYSCALL through syscall_entry and SYSRET, then INT SYSCALL_VECTOR through
+/// syscall_legacy_entry and IRETQ, each with the full return path (sched_preempt() and msr_shadow_apply()). The
+/// caller yields until the peer is done. results[2] raises the same gate from ring 0, which skips the SWAPGS pair and
+/// the privilege change, and results[3] calls syscall_dispatch() directly, the part common to every entry; subtracting
+/// results[3] from the others gives the cost of the entry mechanisms themselves.
+///
+/// @param   results BENCH_SYSCALL_RESULTS results to fill in
+/// @param   batches number of batches to time, at least one
+/// @param   space   a user address space
+/// @param   va      page-aligned start of two unused pages in space
+/// @returns 0 on success, -EINVAL if batches is 0, -ENOMEM if no frame could be allocated, or a vm_map() or
+/// sched_thread_init() error
+int bench_syscall(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+{
+    struct syscall_frame frame = { .rax = SYS_NULL };
+    int64_t              acc   = 0;
+    uint64_t             code, data;
+    int                  err;
+
+    if (!batches || (uint64_t) (bench_user_end - bench_user_start) > PAGE_SIZE)
+        return -EINVAL;
+    if (!(code = frame_alloc()))
+        return -ENOMEM;
+    if (!(data = frame_alloc())) {
+        frame_free(code);
+        return -ENOMEM;
+    }
+
+    uint8_t *text = phys_to_virt(code);
+    for (size_t i = 0; i < (size_t) (bench_user_end - bench_user_start); i++)     /* not a memcpy() call */
+        __atomic_store_n(&text[i], bench_user_start[i], __ATOMIC_RELAXED);
+
+    err = vm_map(space, va, code, PAGE_SIZE, PTE_U);
+    if (!err)
+        err = vm_map(space, va + PAGE_SIZE, data, PAGE_SIZE, PTE_U | PTE_W | vm_config.nx);
+    if (!err) {
+        bench_peer.user_va = va;
+        bench_peer.batches = batches;
+        err = bench_peer_start(bench_user_main, this_cpu_read(cpu), space);
+    }
+    if (!err) {
+        bench_peer_join();
+
+        const uint64_t    *words    = phys_to_virt(data);
+        static const char *names[2] = { "null syscall user", "null int gate user" };
+        for (unsigned int i = 0; i < 2; i++) {
+            results[i].name   = names[i];
+            results[i].ops    = batches * BENCH_BATCH;
+            results[i].cycles = words[2 * i];
+            results[i].best   = words[2 * i + 1];
+        }
+
+        BENCH_TIME(&results[2], "null int gate kernel", batches, acc += bench_legacy_null());
+        BENCH_TIME(&results[3], "null dispatch", batches, acc += syscall_dispatch(&frame));
+        bench_sink = (uint64_t) acc;
+    }
+
+    vm_unmap(space, va, 2 * PAGE_SIZE);
+    frame_free(data);
+    frame_free(code);
+    return err;
+}
+
+/// @fn      static void bench_frame_pair(void)
+/// @brief   Allocates one frame through the magazines and frees it again.
+///
+/// @returns None (void)
+static void bench_frame_pair(void)
+{
+    uint64_t phys = frame_alloc();
+
+    if (phys)
+        frame_free(phys);
+}
+
+/// @fn      static void bench_frame_buddy_pair(void)
+/// @brief   Allocates one frame straight from the local node's buddy lists and frees it there.
+///
+/// @returns None (void)
+static void bench_frame_buddy_pair(void)
+{
+    uint64_t phys = frame_alloc_order(0, FRAME_NODE_LOCAL);
+
+    if (phys)
+        frame_free_order(phys, 0);
+}
+
+/// @fn      void bench_frame(struct bench_result *results, uint64_t batches)
+/// @brief   Measures single-frame allocation and free through the per-CPU magazines and through the node lock.
+///
+/// @details results[0] is an alloc/free pair served by the magazines, results[1] the same pair on the buddy lists under
+/// the zone lock. Run it on every processor at once for the multi-core throughput: the first figure should stay flat
+/// as processors are added, while the second shows the lock contention the magazines avoid.
+///
+/// @param   results BENCH_FRAME_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @returns None (void)
+void bench_frame(struct bench_result *results, uint64_t batches)
+{
+    BENCH_TIME(&results[0], "frame magazine pair", batches, bench_frame_pair());
+    BENCH_TIME(&results[1], "frame buddy pair", batches, bench_frame_buddy_pair());
+}
+
+/// Pages unmapped per operation by the batched unmap loop, each in a range of its own.
+#define BENCH_UNMAP_PAGES            8
+
+/// @fn      static void bench_unmap_single(struct vm_space *space, uint64_t va, uint64_t pa)
+/// @brief   Maps BENCH_UNMAP_PAGES scattered pages and unmaps each with its own vm_unmap() and shootdown.
+///
+/// @param   space the address space
+/// @param   va    the first page of the bench area
+/// @param   pa    the frame mapped at every page
+/// @returns None (void)
+static void bench_unmap_single(struct vm_space *space, uint64_t va, uint64_t pa)
+{
+    for (unsigned int i = 0; i < BENCH_UNMAP_PAGES; i++)
+        vm_map(space, va + 2 * i * PAGE_SIZE, pa, PAGE_SIZE, PTE_U | vm_config.nx);
+    for (unsigned int i = 0; i < BENCH_UNMAP_PAGES; i++)
+        vm_unmap(space, va + 2 * i * PAGE_SIZE, PAGE_SIZE);
+}
+
+/// @fn      static void bench_unmap_batched(struct vm_space *space, uint64_t va, uint64_t pa)
+/// @brief   Maps the same pages and unmaps them into one batch, flushed with a single shootdown.
+///
+/// @param   space the address space
+/// @param   va    the first page of the bench area
+/// @param   pa    the frame mapped at every page
+/// @returns None (void)
+static void bench_unmap_batched(struct vm_space *space, uint64_t va, uint64_t pa)
+{
+    struct tlb_batch batch;
+
+    for (unsigned int i = 0; i < BENCH_UNMAP_PAGES; i++)
+        vm_map(space, va + 2 * i * PAGE_SIZE, pa, PAGE_SIZE, PTE_U | vm_config.nx);
+    tlb_batch_init(&batch, space);
+    for (unsigned int i = 0; i < BENCH_UNMAP_PAGES; i++)
+        vm_unmap_batch(space, va + 2 * i * PAGE_SIZE, PAGE_SIZE, &batch);
+    tlb_flush(&batch);
+}
+
+/// @fn      int bench_unmap(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+/// @brief   Measures unmapping throughput with one shootdown per page and with one per batch.
+///
+/// @details Each operation maps BENCH_UNMAP_PAGES non-adjacent pages and unmaps them: results[0] with a vm_unmap()
+/// per page, results[1] with vm_unmap_batch() and one tlb_flush(). Only the processors with the space loaded are
+/// interrupted, so run it with threads of the space active on other processors and vary their number (QEMU -smp)
+/// to see the IPI cost that batching removes. Divide the figures by BENCH_UNMAP_PAGES for the cost per page.
+///
+/// @param   results BENCH_UNMAP_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @param   space   a user address space
+/// @param   va      page-aligned start of 2 * BENCH_UNMAP_PAGES unused pages in space
+/// @returns 0 on success, or -ENOMEM if no frame could be allocated
+int bench_unmap(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+{
+    uint64_t pa = frame_alloc();
+
+    if (!pa)
+        return -ENOMEM;
+    BENCH_TIME(&results[0], "unmap page by page", batches, bench_unmap_single(space, va, pa));
+    BENCH_TIME(&results[1], "unmap batched", batches, bench_unmap_batched(space, va, pa));
+    frame_free(pa);
+    return 0;
+}
+
+/// Payload bytes of one channel benchmark message, and messages per burst in the throughput loops.
+#define BENCH_CHAN_PAYLOAD           512
+#define BENCH_CHAN_BURST             32
+#define BENCH_CHAN_WORDS             (BENCH_CHAN_PAYLOAD / sizeof(uint64_t))
+
+// The ring is created on first use and reused: every timed operation leaves it empty, and channels are never freed.
+static int      bench_chan_handle = -1;
+static uint64_t bench_chan_bounce[BENCH_CHAN_WORDS];
+
+/// @fn      static void bench_copy_words(uint64_t *to, const uint64_t *from)
+/// @brief   Copies one message payload.
+///
+/// @param   to   the destination
+/// @param   from the source
+/// @returns None (void)
+static void bench_copy_words(uint64_t *to, const uint64_t *from)
+{
+    for (unsigned int i = 0; i < BENCH_CHAN_WORDS; i++)     /* not a memcpy() call: there is none to link */
+        __atomic_store_n(&to[i], from[i], __ATOMIC_RELAXED);
+}
+
+/// @fn      static uint64_t bench_read_words(const uint64_t *words)
+/// @brief   Reads one message payload, as a consumer would.
+///
+/// @param   words the payload
+/// @returns the sum of its words
+static uint64_t bench_read_words(const uint64_t *words)
+{
+    uint64_t sum = 0;
+
+    for (unsigned int i = 0; i < BENCH_CHAN_WORDS; i++)
+        sum += words[i];
+    return sum;
+}
+
+/// @fn      static void bench_chan_ring(struct chan_ring *ring, const uint64_t *src, unsigned int count)
+/// @brief   Passes count messages through a channel ring: all produced in place, one doorbell check, all consumed in
+/// place, one doorbell check.
+///
+/// @param   ring  the ring, empty, with at least count slots
+/// @param   src   the producer's payload
+/// @param   count the number of messages
+/// @returns None (void)
+static void bench_chan_ring(struct chan_ring *ring, const uint64_t *src, unsigned int count)
+{
+    uint64_t sum = 0;
+
+    for (unsigned int i = 0; i < count; i++) {
+        uint64_t          pos  = 0;
+        struct chan_slot *slot = chan_reserve(ring, &pos);
+        bench_copy_words((uint64_t *) slot->data, src);
+        chan_commit(ring, slot, pos);
+    }
+    sum += chan_doorbell(ring, CHAN_SIDE_CONSUMER);
+
+    for (unsigned int i = 0; i < count; i++) {
+        struct chan_slot *slot = chan_peek(ring);
+        sum += bench_read_words((const uint64_t *) slot->data);
+        chan_release(ring, slot);
+    }
+    sum += chan_doorbell(ring, CHAN_SIDE_PRODUCER);
+    bench_sink = sum;
+}
+
+/// @fn      static void bench_chan_copy(struct vm_space *space, uint64_t va, const uint64_t *dst, unsigned int count)
+/// @brief   Passes count messages the way a copying IPC path does: from the sender's user buffer into a kernel
+/// bounce buffer and out into the receiver's, which then reads it.
+///
+/// @param   space the address space holding both user buffers
+/// @param   va    the sender's buffer, followed by the receiver's
+/// @param   dst   kernel alias of the receiver's buffer
+/// @param   count the number of messages
+/// @returns None (void)
+static void bench_chan_copy(struct vm_space *space, uint64_t va, const uint64_t *dst, unsigned int count)
+{
+    uint64_t sum = 0;
+
+    for (unsigned int i = 0; i < count; i++) {
+        vm_copy_in(space, va, bench_chan_bounce, BENCH_CHAN_PAYLOAD);
+        vm_copy_out(space, va + BENCH_CHAN_PAYLOAD, bench_chan_bounce, BENCH_CHAN_PAYLOAD);
+        sum += bench_read_words(dst);
+    }
+    bench_sink = sum;
+}
+
+/// @fn      int bench_chan(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+/// @brief   Measures moving BENCH_CHAN_PAYLOAD-byte messages through a channel ring against copying them through the
+/// kernel.
+///
+/// @details results[0] and [1] are the latency of one message, through the ring and through the copy path;
+/// results[2] and [3] move bursts of BENCH_CHAN_BURST messages, so divide them by BENCH_CHAN_BURST for the cost per
+/// message at full throughput. The ring path writes each payload into its slot and reads it there, checking the
+/// doorbell once per burst; the copy path translates and copies each payload twice, as ipc_transfer() does for long
+/// messages, before the receiver reads it. Both run on this processor without entering the kernel, so the difference
+/// is the data movement alone; a copy-based system call would add its entry on top. Run it on one processor at a
+/// time: the ring is shared by every run.
+///
+/// @param   results BENCH_CHAN_RESULTS results to fill in
+/// @param   batches number of batches to time
+/// @param   space   a user address space
+/// @param   va      page-aligned address of an unused page in space
+/// @returns 0 on success, -ENOMEM if no frame or ring could be allocated, or another error from chan_create() or
+/// vm_map()
+int bench_chan(struct bench_result *results, uint64_t batches, struct vm_space *space, uint64_t va)
+{
+    if (bench_chan_handle < 0) {
+        int handle = chan_create(2 * BENCH_CHAN_PAYLOAD, BENCH_CHAN_BURST, 0);
+        if (handle < 0)
+            return handle;
+        bench_chan_handle = handle;
+    }
+
+    uint64_t pa = frame_alloc();
+    if (!pa)
+        return -ENOMEM;
+    int err = vm_map(space, va, pa, PAGE_SIZE, PTE_U | PTE_W | vm_config.nx);
+    if (err) {
+        frame_free(pa);
+        return err;
+    }
+
+    struct chan_ring *ring = chan_table[bench_chan_handle].ring;
+    uint64_t         *src  = phys_to_virt(pa);
+    const uint64_t   *dst  = src + BENCH_CHAN_WORDS;
+    for (unsigned int i = 0; i < BENCH_CHAN_WORDS; i++)
+        src[i] = i;
+
+    BENCH_TIME(&results[0], "chan ring message", batches, bench_chan_ring(ring, src, 1));
+    BENCH_TIME(&results[1], "chan copy message", batches, bench_chan_copy(space, va, dst, 1));
+    BENCH_TIME(&results[2], "chan ring burst", batches, bench_chan_ring(ring, src, BENCH_CHAN_BURST));
+    BENCH_TIME(&results[3], "chan copy burst", batches, bench_chan_copy(space, va, dst, BENCH_CHAN_BURST));
+
+    vm_unmap(space, va, PAGE_SIZE);
+    frame_free(pa);
+    return 0;
+}
@@ -0,0 +1,220 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/kern/chan.c                                                                            |
+// | Name          : Channels                                                                                          |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements zero-copy shared-memory channels whose doorbells enter the kernel only for sleepers.   |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/irq.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "kern/chan.h"
+#include "kern/sched.h"
+#include "kern/thread.h"
+#include "mm/frame.h"
+#include "mm/layout.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+struct chan chan_table[CONFIG_CHANNELS];
+
+/// @fn      int chan_create(uint32_t slot_size, uint32_t nr_slots, uint32_t flags)
+/// @brief   Allocates a channel and initializes its ring.
+///
+/// @details Every slot starts free for the position equal to its index, so the ring is usable as soon as it is mapped.
+///
+/// @param   slot_size bytes per slot including its sequence word, a power of two from CHAN_MIN_SLOT_SIZE to
+///                    CHAN_MAX_SLOT_SIZE
+/// @param   nr_slots  the number of slots, a power of two
+/// @param   flags     CHAN_MPSC or 0
+/// @returns the channel's handle, -EINVAL for a bad geometry or flag, -ENOMEM if the ring could not be allocated, or
+/// -ENOSPC if the table is full
+int chan_create(uint32_t slot_size, uint32_t nr_slots, uint32_t flags)
+{
+    if (slot_size < CHAN_MIN_SLOT_SIZE || slot_size > CHAN_MAX_SLOT_SIZE || (slot_size & (slot_size - 1)) ||
+        !nr_slots || (nr_slots & (nr_slots - 1)) || (flags & ~CHAN_MPSC))
+        return -EINVAL;
+
+    uint64_t     bytes = CHAN_RING_HEADER_SIZE + (uint64_t) nr_slots * slot_size;
+    unsigned int order = 0;
+    while ((PAGE_SIZE << order) < bytes) {
+        if (++order == CONFIG_FRAME_ORDERS)
+            return -EINVAL;
+    }
+
+    uint64_t phys = frame_alloc_order(order, FRAME_NODE_LOCAL);
+    if (!phys)
+        return -ENOMEM;
+
+    struct chan_ring *ring = phys_to_virt(phys);
+    uint64_t         *line = (uint64_t *) ring;
+    for (unsigned int i = 0; i < CHAN_RING_HEADER_SIZE / sizeof(uint64_t); i++)
+        line[i] = 0;
+    ring->magic     = CHAN_RING_MAGIC;
+    ring->nr_slots  = nr_slots;
+    ring->slot_size = slot_size;
+    ring->flags     = flags;
+    for (uint32_t i = 0; i < nr_slots; i++)
+        chan_slot_at(ring, i)->seq = i;
+
+    for (unsigned int i = 0; i < CONFIG_CHANNELS; i++) {
+        struct chan *ch = &chan_table[i];
+
+        uint64_t irq = irq_save();
+        spin_lock(&ch->lock);
+        bool taken = ch->valid;
+        if (!taken) {
+            ch->order       = (uint8_t) order;
+            ch->phys        = phys;
+            ch->ring        = ring;
+            ch->sleepers[0] = NULL;
+            ch->sleepers[1] = NULL;
+            ch->waits       = 0;
+            ch->notifies    = 0;
+            ch->wakeups     = 0;
+            __atomic_store_n(&ch->valid, true, __ATOMIC_RELEASE);
+        }
+        spin_unlock(&ch->lock);
+        irq_restore(irq);
+        if (!taken)
+            return (int) i;
+    }
+
+    frame_free_order(phys, order);
+    return -ENOSPC;
+}
+
+/// @fn      static struct chan *chan_get(uint64_t handle)
+/// @brief   Resolves a channel handle passed by user mode.
+///
+/// @param   handle the handle
+/// @returns the channel, or NULL if the handle does not name one
+static struct chan *chan_get(uint64_t handle)
+{
+    if (handle >= CONFIG_CHANNELS || !__atomic_load_n(&chan_table[handle].valid, __ATOMIC_ACQUIRE))
+        return NULL;
+    return &chan_table[handle];
+}
+
+/// @fn      int64_t chan_sys_create(struct syscall_frame *frame)
+/// @brief   SYS_CHAN_CREATE: creates a channel.
+///
+/// @param   frame the caller's registers: RDI the slot size, RSI the number of slots, RDX the CHAN_* flags
+/// @returns the channel's handle, or a negative error number as for chan_create()
+int64_t chan_sys_create(struct syscall_frame *frame)
+{
+    if ((frame->rdi | frame->rsi | frame->rdx) > UINT32_MAX)
+        return -EINVAL;
+    return chan_create((uint32_t) frame->rdi, (uint32_t) frame->rsi, (uint32_t) frame->rdx);
+}
+
+/// @fn      int64_t chan_sys_map(struct syscall_frame *frame)
+/// @brief   SYS_CHAN_MAP: maps a channel's ring into the calling thread's address space.
+///
+/// @details Both ends of a channel, and any further producers, map the same frames, so a slot written by one is read
+/// in place by the other. The mapping is user-writable and never executable.
+///
+/// @param   frame the caller's registers: RDI the channel, RSI the address to map the ring at, page aligned
+/// @returns 0 on success, -EINVAL for a bad handle or address or a kernel-only thread, -EEXIST if part of the range is
+/// already mapped, or -ENOMEM if a page table could not be allocated
+int64_t chan_sys_map(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+    struct chan   *ch   = chan_get(frame->rdi);
+    uint64_t       va   = frame->rsi;
+
+    if (!ch || !self->vm)
+        return -EINVAL;
+
+    uint64_t size = PAGE_SIZE << ch->order;
+    if (va & ~PAGE_MASK || va > vm_config.user_end - size)
+        return -EINVAL;
+    return vm_map(self->vm, va, ch->phys, size, PTE_U | PTE_W | vm_config.nx);
+}
+
+/// @fn      int64_t chan_sys_wait(struct syscall_frame *frame)
+/// @brief   SYS_CHAN_WAIT: sleeps until a peer rings the doorbell of one side of a channel.
+///
+/// @details The caller announces itself with chan_prepare_wait() and retries the ring before calling. The flag is
+/// tested again here under the channel lock, and SYS_CHAN_NOTIFY clears it under the same lock, so a notification
+/// that came first makes this call return at once rather than be lost. Returning does not promise progress; the
+/// caller retries the ring and waits again if needed.
+///
+/// @param   frame the caller's registers: RDI the channel, RSI the CHAN_SIDE_* the caller waits on
+/// @returns 0 once woken or already notified, or -EINVAL for a bad handle or side
+int64_t chan_sys_wait(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+    struct chan   *ch   = chan_get(frame->rdi);
+    uint64_t       side = frame->rsi;
+
+    if (!ch || side > CHAN_SIDE_PRODUCER)
+        return -EINVAL;
+
+    spin_lock(&ch->lock);
+    if (!__atomic_load_n(&ch->ring->waiting[side], __ATOMIC_RELAXED)) {
+        spin_unlock(&ch->lock);
+        return 0;
+    }
+    sched_prepare_block();
+    self->ipc_next     = ch->sleepers[side];
+    ch->sleepers[side] = self;
+    ch->waits++;
+    spin_unlock(&ch->lock);
+
+    sched_block();
+    return 0;
+}
+
+/// @fn      int64_t chan_sys_notify(struct syscall_frame *frame)
+/// @brief   SYS_CHAN_NOTIFY: wakes every thread sleeping on one side of a channel.
+///
+/// @details Called after chan_doorbell() reports a sleeper, once for a whole batch of slots. Clearing the flag tells
+/// the peer's next batch that no doorbell is due until someone sleeps again.
+///
+/// @param   frame the caller's registers: RDI the channel, RSI the CHAN_SIDE_* to wake
+/// @returns the number of threads woken, or -EINVAL for a bad handle or side
+int64_t chan_sys_notify(struct syscall_frame *frame)
+{
+    struct chan *ch    = chan_get(frame->rdi);
+    uint64_t     side  = frame->rsi;
+    int64_t      woken = 0;
+
+    if (!ch || side > CHAN_SIDE_PRODUCER)
+        return -EINVAL;
+
+    spin_lock(&ch->lock);
+    __atomic_store_n(&ch->ring->waiting[side], 0, __ATOMIC_RELAXED);
+    struct thread *t = ch->sleepers[side];
+    ch->sleepers[side] = NULL;
+    ch->notifies++;
+    spin_unlock(&ch->lock);
+
+    while (t) {
+        struct thread *next = t->ipc_next;
+        woken += sched_wake(t);
+        t = next;
+    }
+
+    __atomic_add_fetch(&ch->wakeups, (uint64_t) woken, __ATOMIC_RELAXED);
+    return woken;
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/kern/intr.c                                                                            |
+// | Name          : Interrupt Notification                                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Turns device interrupts into batched bits in user-mode drivers' notification words.               |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/percpu.h"
+#include "arch/tsc.h"
+#include "kern/intr.h"
+#include "kern/sched.h"
+#include "kern/thread.h"
+#include "sys/errno.h"
+
+struct intr_notify intr_notifies[CONFIG_INTR_NOTIFIES];
+struct intr_line   intr_lines[INTR_VECTORS];
+struct intr_cpu    intr_cpus[CONFIG_MAX_CPUS];
+
+/// @fn      int intr_notify_create(struct vm_space *owner)
+/// @brief   Allocates a notification word.
+///
+/// @param   owner the address space whose threads may use the word, or NULL for kernel-only threads
+/// @returns the word's handle, or -ENOSPC if the table is full
+int intr_notify_create(struct vm_space *owner)
+{
+    for (unsigned int i = 0; i < CONFIG_INTR_NOTIFIES; i++) {
+        struct intr_notify *n = &intr_notifies[i];
+
+        uint64_t flags = irq_save();
+        spin_lock(&n->lock);
+        bool taken = n->valid;
+        if (!taken) {
+            n->word   = 0;
+            n->bound  = 0;
+            n->waiter = NULL;
+            n->owner  = owner;
+            __atomic_store_n(&n->valid, true, __ATOMIC_RELEASE);
+        }
+        spin_unlock(&n->lock);
+        irq_restore(flags);
+        if (!taken)
+            return (int) i;
+    }
+    return -ENOSPC;
+}
+
+/// @fn      static int intr_notify_get(uint64_t handle, struct intr_notify **out)
+/// @brief   Resolves a notification handle passed by user mode, checking that the caller's address space owns it.
+///
+/// @param   handle the handle
+/// @param   out    receives the notification word
+/// @returns 0 on success, -EINVAL if the handle does not name a word, or -EPERM if another address space created it
+static int intr_notify_get(uint64_t handle, struct intr_notify **out)
+{
+    const struct thread *self = this_cpu_read(current);
+
+    if (handle >= CONFIG_INTR_NOTIFIES || !__atomic_load_n(&intr_notifies[handle].valid, __ATOMIC_ACQUIRE))
+        return -EINVAL;
+    if (intr_notifies[handle].owner != self->vm)
+        return -EPERM;
+    *out = &intr_notifies[handle];
+    return 0;
+}
+
+/// @fn      static void intr_signal(struct intr_notify *n, uint64_t bit)
+/// @brief   Sets a bit in a notification word and wakes the driver if it is waiting.
+///
+/// @details A driver that is still busy with the previous batch is not woken; it finds the bit on its next
+/// SYS_INTR_WAIT without blocking.
+///
+/// @param   n   the notification word
+/// @param   bit the line's bit
+/// @returns None (void)
+static void intr_signal(struct intr_notify *n, uint64_t bit)
+{
+    spin_lock(&n->lock);
+    n->word |= bit;
+    struct thread *t = n->waiter;
+    n->waiter = NULL;
+    spin_unlock(&n->lock);
+
+    if (t)
+        sched_wake(t);
+}
+
+/// @fn      static void intr_disarm(struct intr_line *line)
+/// @brief   Withdraws a line from its processor's coalescing timer. Called with the line locked.
+///
+/// @details The processor's deadline is left as it is; if it fires with nothing left to flush, it is simply dropped.
+///
+/// @param   line the line
+/// @returns None (void)
+static void intr_disarm(struct intr_line *line)
+{
+    unsigned int vector = (unsigned int) (line - intr_lines);
+
+    if (!line->armed)
+        return;
+    line->armed = false;
+    __atomic_fetch_and(&intr_cpus[line->armed_cpu].armed[vector / 64], ~(1ULL << (vector % 64)), __ATOMIC_RELAXED);
+}
+
+/// @fn      static void intr_arm(struct intr_line *line)
+/// @brief   Makes the executing processor's timer flush the line's incomplete batch. Called with the line locked.
+///
+/// @param   line the line
+/// @returns None (void)
+static void intr_arm(struct intr_line *line)
+{
+    unsigned int     vector   = (unsigned int) (line - intr_lines);
+    unsigned int     cpu      = this_cpu_read(cpu);
+    struct intr_cpu *ic       = &intr_cpus[cpu];
+    uint64_t         deadline = line->first_tsc + line->delay;
+
+    line->armed     = true;
+    line->armed_cpu = (uint16_t) cpu;
+    __atomic_fetch_or(&ic->armed[vector / 64], 1ULL << (vector % 64), __ATOMIC_RELAXED);
+    if (!ic->deadline || deadline < ic->deadline) {
+        ic->deadline = deadline;
+        sched_timer_event(deadline);
+    }
+}
+
+/// @fn      static void intr_update(struct intr_line *line, uint64_t now)
+/// @brief   Delivers a line's batch if it is complete or overdue, or else arms the timer for it.
+///
+/// @details Called with the line locked.
+///
+/// @param   line the line
+/// @param   now  the current TSC value
+/// @returns None (void)
+static void intr_update(struct intr_line *line, uint64_t now)
+{
+    if (line->masked || !line->count)
+        return;
+
+    if (line->count >= line->batch || now - line->first_tsc >= line->delay) {
+        intr_disarm(line);
+        line->masked = true;
+        line->count  = 0;
+        line->deliveries++;
+        intr_signal(line->notify, line->bit);
+    } else if (!line->armed) {
+        intr_arm(line);
+    }
+}
+
+/// @fn      void intr_interrupt(unsigned int vector)
+/// @brief   Handles a device vector: counts the interrupt on its line and delivers the line's batch when it is due.
+///
+/// @param   vector the vector taken, from VECTOR_DEVICE_FIRST to VECTOR_DEVICE_LAST
+/// @returns None (void)
+void intr_interrupt(unsigned int vector)
+{
+    struct intr_line *line = &intr_lines[vector];
+    uint64_t          now  = _rdtsc();
+
+    spin_lock(&line->lock);
+    if (!line->notify) {
+        line->spurious++;
+    } else {
+        line->interrupts++;
+        if (!line->count++)
+            line->first_tsc = now;
+        intr_update(line, now);
+    }
+    spin_unlock(&line->lock);
+    apic_eoi();
+}
+
+/// @fn      void intr_timer_expired(uint64_t now)
+/// @brief   Flushes the overdue batches armed on the executing processor. Called from sched_timer_interrupt().
+///
+/// @param   now the current TSC value
+/// @returns None (void)
+void intr_timer_expired(uint64_t now)
+{
+    unsigned int     cpu  = this_cpu_read(cpu);
+    struct intr_cpu *ic   = &intr_cpus[cpu];
+    uint64_t         next = 0;
+
+    ic->deadline = 0;
+    for (unsigned int i = 0; i < INTR_VECTORS / 64; i++) {
+        uint64_t bits = __atomic_load_n(&ic->armed[i], __ATOMIC_RELAXED);
+
+        while (bits) {
+            struct intr_line *line = &intr_lines[i * 64 + (unsigned int) __builtin_ctzll(bits)];
+            bits &= bits - 1;
+
+            spin_lock(&line->lock);
+            if (line->armed && line->armed_cpu == cpu) {
+                intr_update(line, now);
+                if (line->armed && (!next || line->first_tsc + line->delay < next))
+                    next = line->first_tsc + line->delay;
+            }
+            spin_unlock(&line->lock);
+        }
+    }
+
+    if (next) {
+        ic->deadline = next;
+        sched_timer_event(next);
+    }
+}
+
+/// @fn      static int intr_target(uint64_t cpu, unsigned int vector, struct syscall_frame *frame)
+/// @brief   Validates a target processor and returns the MSI message that interrupts it, in RDX and R10.
+///
+/// @details The message is fixed delivery, edge triggered, physical destination. Destinations beyond APIC ID 255
+/// would need interrupt remapping, which the kernel does not program.
+///
+/// @param   cpu    the logical CPU index
+/// @param   vector the line's vector
+/// @param   frame  the caller's registers
+/// @returns 0 on success, -EINVAL if the processor is not running the scheduler, or -ERANGE if its APIC ID does not
+/// fit an MSI address
+static int intr_target(uint64_t cpu, unsigned int vector, struct syscall_frame *frame)
+{
+    if (cpu >= CONFIG_MAX_CPUS || !runqueues[cpu].idle)
+        return -EINVAL;
+    if (apic.apic_id[cpu] > 0xFF)
+        return -ERANGE;
+
+    frame->rdx = INTR_MSI_ADDRESS | ((uint64_t) apic.apic_id[cpu] << 12);
+    frame->r10 = vector;
+    return 0;
+}
+
+/// @fn      int64_t intr_sys_create(struct syscall_frame *frame)
+/// @brief   SYS_INTR_CREATE: creates a notification word.
+///
+/// @details The word belongs to the caller's address space: its other threads may use it, and no other thread may.
+///
+/// @param   frame the caller's registers
+/// @returns the word's handle, or -ENOSPC if the table is full
+int64_t intr_sys_create(struct syscall_frame *frame)
+{
+    const struct thread *self = this_cpu_read(current);
+
+    (void) frame;
+    return intr_notify_create(self->vm);
+}
+
+/// @fn      int64_t intr_sys_bind(struct syscall_frame *frame)
+/// @brief   SYS_INTR_BIND: allocates a device vector and binds it to a bit of a notification word.
+///
+/// @details The driver programs the returned MSI message into its device. A batch of one delivers every interrupt
+/// at once; a larger batch must come with a delay, which bounds the latency of the last interrupts of a burst.
+///
+/// @param   frame the caller's registers: RDI the notification word, RSI the bit, RDX the target processor or
+///                INTR_CPU_SELF, R10 the batch size (0 means 1), R8 the delay in nanoseconds
+/// @returns the vector, with the MSI address in RDX and data in R10; -EINVAL for a bad handle, bit, processor or
+/// coalescing setting, -EPERM if the word belongs to another address space, -EEXIST if the bit is bound, -ERANGE as
+/// for intr_target(), or -ENOSPC if no vector is free
+int64_t intr_sys_bind(struct syscall_frame *frame)
+{
+    struct intr_notify *n;
+    uint64_t            bit   = frame->rsi;
+    uint64_t            cpu   = frame->rdx == INTR_CPU_SELF ? this_cpu_read(cpu) : frame->rdx;
+    uint64_t            batch = frame->r10 ? frame->r10 : 1;
+    int                 err   = intr_notify_get(frame->rdi, &n);
+
+    if (err)
+        return err;
+    if (bit >= INTR_NOTIFY_BITS || batch > UINT32_MAX || (batch > 1 && !frame->r8))
+        return -EINVAL;
+    if (__atomic_load_n(&n->bound, __ATOMIC_RELAXED) & (1ULL << bit))
+        return -EEXIST;
+
+    for (unsigned int vector = VECTOR_DEVICE_FIRST; vector <= VECTOR_DEVICE_LAST; vector++) {
+        struct intr_line *line = &intr_lines[vector];
+
+        if (vector == SYSCALL_VECTOR)
+            continue;
+        spin_lock(&line->lock);
+        if (line->notify) {
+            spin_unlock(&line->lock);
+            continue;
+        }
+        err = intr_target(cpu, vector, frame);
+        if (err) {
+            spin_unlock(&line->lock);
+            return err;
+        }
+
+        spin_lock(&n->lock);
+        bool taken = n->bound & (1ULL << bit);
+        if (!taken) {
+            n->bound |= 1ULL << bit;
+            n->vectors[bit] = (uint8_t) vector;
+        }
+        spin_unlock(&n->lock);
+        if (taken) {
+            spin_unlock(&line->lock);
+            return -EEXIST;
+        }
+
+        line->notify     = n;
+        line->bit        = 1ULL << bit;
+        line->cpu        = (uint32_t) cpu;
+        line->batch      = (uint32_t) batch;
+        line->delay      = tsc_ns_to_cycles(frame->r8);
+        line->count      = 0;
+        line->masked     = false;
+        line->interrupts = 0;
+        line->deliveries = 0;
+        spin_unlock(&line->lock);
+        return vector;
+    }
+    return -ENOSPC;
+}
+
+/// @fn      int64_t intr_sys_affinity(struct syscall_frame *frame)
+/// @brief   SYS_INTR_AFFINITY: retargets a bound line at another processor, usually the one its driver now runs on.
+///
+/// @details Only the MSI message changes; the driver reprograms its device with it. Interrupts already in flight to
+/// the old processor are still counted, and a batch armed there is still flushed there.
+///
+/// @param   frame the caller's registers: RDI the notification word, RSI the bit, RDX the target processor or
+///                INTR_CPU_SELF
+/// @returns 0 with the MSI address in RDX and data in R10, -EINVAL for a bad handle, unbound bit or processor, -EPERM
+/// if the word belongs to another address space, or -ERANGE as for intr_target()
+int64_t intr_sys_affinity(struct syscall_frame *frame)
+{
+    struct intr_notify *n;
+    uint64_t            bit = frame->rsi;
+    uint64_t            cpu = frame->rdx == INTR_CPU_SELF ? this_cpu_read(cpu) : frame->rdx;
+    int                 err = intr_notify_get(frame->rdi, &n);
+
+    if (err)
+        return err;
+    if (bit >= INTR_NOTIFY_BITS || !(__atomic_load_n(&n->bound, __ATOMIC_ACQUIRE) & (1ULL << bit)))
+        return -EINVAL;
+
+    unsigned int      vector = n->vectors[bit];
+    struct intr_line *line   = &intr_lines[vector];
+
+    spin_lock(&line->lock);
+    err = intr_target(cpu, vector, frame);
+    if (!err)
+        line->cpu = (uint32_t) cpu;
+    spin_unlock(&line->lock);
+    return err;
+}
+
+/// @fn      int64_t intr_sys_wait(struct syscall_frame *frame)
+/// @brief   SYS_INTR_WAIT: acknowledges serviced lines, then collects the pending bits, sleeping until there are some.
+///
+/// @details Acknowledging unmasks a line; interrupts it took while masked are delivered at once if they form a full
+/// or overdue batch, so a driver that keeps up with a busy device never blocks. One call per batch both completes the
+/// previous one and fetches the next.
+///
+/// @param   frame the caller's registers: RDI the notification word, RSI the bits to acknowledge
+/// @returns the collected bits, each naming a masked line to service, -EINVAL for a bad handle, -EPERM if the word
+/// belongs to another address space, or -EBUSY if another thread is already waiting on the word
+int64_t intr_sys_wait(struct syscall_frame *frame)
+{
+    struct thread      *self = this_cpu_read(current);
+    struct intr_notify *n;
+    int                 err  = intr_notify_get(frame->rdi, &n);
+
+    if (err)
+        return err;
+
+    uint64_t ack = frame->rsi & __atomic_load_n(&n->bound, __ATOMIC_ACQUIRE);
+    uint64_t now = _rdtsc();
+    while (ack) {
+        struct intr_line *line = &intr_lines[n->vectors[__builtin_ctzll(ack)]];
+        ack &= ack - 1;
+
+        spin_lock(&line->lock);
+        if (line->masked) {
+            line->masked = false;
+            intr_update(line, now);
+        }
+        spin_unlock(&line->lock);
+    }
+
+    spin_lock(&n->lock);
+    if (n->waiter) {
+        spin_unlock(&n->lock);
+        return -EBUSY;
+    }
+    uint64_t bits = n->word;
+    n->word = 0;
+    if (!bits) {
+        sched_prepare_block();
+        n->waiter = self;
+    }
+    spin_unlock(&n->lock);
+    if (bits)
+        return (int64_t) bits;
+
+    sched_block();
+
+    spin_lock(&n->lock);
+    bits = n->word;
+    n->word = 0;
+    spin_unlock(&n->lock);
+    return (int64_t) bits;
+}
\ No newline at end of file
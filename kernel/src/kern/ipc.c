@@ -0,0 +1,341 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/kern/ipc.c                                                                             |
+// | Name          : Synchronous IPC                                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements call and reply-wait with a register-only fast path that bypasses the scheduler.        |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/irq.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "kern/ipc.h"
+#include "kern/sched.h"
+#include "kern/thread.h"
+#include "mm/layout.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+struct ipc_endpoint ipc_endpoints[CONFIG_IPC_ENDPOINTS];
+struct ipc_stats    ipc_stats[CONFIG_MAX_CPUS];
+
+/// @fn      int ipc_endpoint_create(void)
+/// @brief   Allocates an endpoint.
+///
+/// @returns the endpoint's handle, or -ENOSPC if the table is full
+int ipc_endpoint_create(void)
+{
+    for (unsigned int i = 0; i < CONFIG_IPC_ENDPOINTS; i++) {
+        struct ipc_endpoint *ep = &ipc_endpoints[i];
+
+        uint64_t flags = irq_save();
+        spin_lock(&ep->lock);
+        bool taken = ep->valid;
+        if (!taken) {
+            ep->receivers    = NULL;
+            ep->senders      = NULL;
+            ep->senders_tail = NULL;
+            __atomic_store_n(&ep->valid, true, __ATOMIC_RELEASE);
+        }
+        spin_unlock(&ep->lock);
+        irq_restore(flags);
+        if (!taken)
+            return (int) i;
+    }
+    return -ENOSPC;
+}
+
+/// @fn      static struct ipc_endpoint *ipc_endpoint_get(uint64_t handle)
+/// @brief   Resolves an endpoint handle passed by user mode.
+///
+/// @param   handle the handle
+/// @returns the endpoint, or NULL if the handle does not name one
+static struct ipc_endpoint *ipc_endpoint_get(uint64_t handle)
+{
+    if (handle >= CONFIG_IPC_ENDPOINTS || !__atomic_load_n(&ipc_endpoints[handle].valid, __ATOMIC_ACQUIRE))
+        return NULL;
+    return &ipc_endpoints[handle];
+}
+
+/// @fn      static int ipc_check_send(const struct thread *self, uint64_t tag)
+/// @brief   Validates the tag of a message about to be sent.
+///
+/// @param   self the sending thread
+/// @param   tag  the message tag
+/// @returns 0 if the message can be sent, -EOPNOTSUPP for capability transfer (there are no capability spaces yet),
+/// or -EINVAL for a long message without a registered buffer
+static int ipc_check_send(const struct thread *self, uint64_t tag)
+{
+    if (tag & IPC_TAG_CAP)
+        return -EOPNOTSUPP;
+    if (IPC_TAG_LENGTH(tag) > IPC_FAST_WORDS && !self->ipc_buffer)
+        return -EINVAL;
+    return 0;
+}
+
+/// @fn      static void ipc_transfer(struct thread *to, const struct thread *from, const struct syscall_frame *src)
+/// @brief   Delivers a message into the registers of a blocked thread, and its tail into the thread's buffer.
+///
+/// @details The tail is copied from the sender's buffer into the receiver's through a bounce buffer on this stack,
+/// translating both user addresses at the time of the copy. A receiver without a buffer, or a copy that faults because
+/// either buffer was unmapped since it was registered, leaves the first IPC_FAST_WORDS words and a tag whose length
+/// says so. The receiver's system call completes with status 0.
+///
+/// @param   to   the receiving thread, blocked
+/// @param   from the sending thread
+/// @param   src  the sender's registers
+/// @returns None (void)
+static void ipc_transfer(struct thread *to, const struct thread *from, const struct syscall_frame *src)
+{
+    struct syscall_frame *dst = to->ipc_regs;
+    uint64_t              tag = src->rsi;
+    uint32_t              len = IPC_TAG_LENGTH(tag);
+
+    if (len > IPC_FAST_WORDS) {
+        uint64_t words[IPC_MAX_WORDS - IPC_FAST_WORDS];
+        uint64_t offset = IPC_FAST_WORDS * sizeof(uint64_t);
+        size_t   size   = (len - IPC_FAST_WORDS) * sizeof(uint64_t);
+
+        if (!to->ipc_buffer || !from->ipc_buffer || vm_copy_in(from->vm, from->ipc_buffer + offset, words, size) ||
+            vm_copy_out(to->vm, to->ipc_buffer + offset, words, size))
+            len = IPC_FAST_WORDS;
+        tag = (tag & ~0x3FULL) | len;
+    }
+
+    dst->rax = 0;
+    dst->rsi = tag;
+    dst->rdx = src->rdx;
+    dst->r10 = src->r10;
+    dst->r8  = src->r8;
+    dst->r9  = src->r9;
+}
+
+/// @fn      int64_t ipc_sys_call(struct syscall_frame *frame)
+/// @brief   Slow path of SYS_IPC_CALL: sends a message to an endpoint and waits for the reply.
+///
+/// @details Taken when the fast path declines: long messages, no waiting server, a server that blocked in the slow
+/// path, or a more urgent thread runnable here. Runs with interrupts disabled, like every system call. The reply is
+/// written into frame by the server, which also sets the status in frame->rax.
+///
+/// @param   frame the caller's registers: RDI the endpoint, RSI the tag, RDX/R10/R8/R9 the first message words
+/// @returns 0 with the reply in RSI and RDX/R10/R8/R9, or a negative error number
+int64_t ipc_sys_call(struct syscall_frame *frame)
+{
+    struct thread       *self = this_cpu_read(current);
+    struct ipc_endpoint *ep   = ipc_endpoint_get(frame->rdi);
+    int                  err  = ipc_check_send(self, frame->rsi);
+
+    if (err)
+        return err;
+    if (!ep)
+        return -EINVAL;
+
+    ipc_stats[this_cpu_read(cpu)].slow_calls++;
+    self->ipc_regs = frame;
+    sched_prepare_block();
+
+    spin_lock(&ep->lock);
+    struct thread *server = ep->receivers;
+    if (server) {
+        ep->receivers = server->ipc_next;
+        spin_unlock(&ep->lock);
+        server->ipc_frame   = NULL;
+        server->ipc_partner = self;
+        ipc_transfer(server, self, frame);
+        server->ipc_regs->rdi = self->ipc_badge;
+        sched_wake(server);
+    } else {
+        self->ipc_next = NULL;
+        if (ep->senders_tail)
+            ep->senders_tail->ipc_next = self;
+        else
+            ep->senders = self;
+        ep->senders_tail = self;
+        spin_unlock(&ep->lock);
+    }
+
+    sched_block();
+    return (int64_t) frame->rax;
+}
+
+/// @fn      int64_t ipc_sys_reply_wait(struct syscall_frame *frame)
+/// @brief   Slow path of SYS_IPC_REPLY_WAIT: replies to the current caller, if any, then waits for the next call.
+///
+/// @details A queued caller is taken at once without blocking, and stays blocked until the reply. Callers queue only
+/// in the slow path, so replies to them take the slow path as well.
+///
+/// @param   frame the server's registers: RDI the endpoint, RSI the reply tag, RDX/R10/R8/R9 the first reply words
+/// @returns 0 with the caller's badge in RDI and the message in RSI and RDX/R10/R8/R9, or a negative error number
+int64_t ipc_sys_reply_wait(struct syscall_frame *frame)
+{
+    struct thread       *self   = this_cpu_read(current);
+    struct ipc_endpoint *ep     = ipc_endpoint_get(frame->rdi);
+    struct thread       *caller = self->ipc_partner;
+
+    if (!ep)
+        return -EINVAL;
+
+    if (caller) {
+        int err = ipc_check_send(self, frame->rsi);
+        if (err)
+            return err;
+        ipc_stats[this_cpu_read(cpu)].slow_replies++;
+        self->ipc_partner = NULL;
+        caller->ipc_frame = NULL;
+        ipc_transfer(caller, self, frame);
+        sched_wake(caller);
+    }
+
+    self->ipc_regs = frame;
+
+    spin_lock(&ep->lock);
+    caller = ep->senders;
+    if (caller) {
+        ep->senders = caller->ipc_next;
+        if (!ep->senders)
+            ep->senders_tail = NULL;
+        spin_unlock(&ep->lock);
+        self->ipc_partner = caller;
+        ipc_transfer(self, caller, caller->ipc_regs);
+        frame->rdi = caller->ipc_badge;
+        return 0;
+    }
+    sched_prepare_block();
+    self->ipc_next = ep->receivers;
+    ep->receivers  = self;
+    spin_unlock(&ep->lock);
+
+    sched_block();
+    return (int64_t) frame->rax;
+}
+
+/// @fn      int64_t ipc_sys_buffer(struct syscall_frame *frame)
+/// @brief   SYS_IPC_BUFFER: registers the calling thread's buffer for long messages.
+///
+/// @details Only the user address is kept. The kernel does not pin the frame behind it: every transfer translates the
+/// address again under the space's lock, so the page may be unmapped or remapped at any time, and a transfer that
+/// finds it missing delivers a truncated message rather than touching a retired frame.
+///
+/// @param   frame the caller's registers: RDI the buffer's user address, or 0 to unregister
+/// @returns 0 on success, -EINVAL for a misaligned or page-crossing buffer or a kernel-only thread, or -EFAULT if the
+/// buffer is not mapped writable for user mode
+int64_t ipc_sys_buffer(struct syscall_frame *frame)
+{
+    struct thread *self = this_cpu_read(current);
+    uint64_t       va   = frame->rdi;
+    uint64_t       pa, flags;
+
+    if (!va) {
+        self->ipc_buffer = 0;
+        return 0;
+    }
+    if (!self->vm || (va & 7) || va + sizeof(struct ipc_buffer) > vm_config.user_end ||
+        (va & PAGE_MASK) != ((va + sizeof(struct ipc_buffer) - 1) & PAGE_MASK))
+        return -EINVAL;
+    if (vm_translate(self->vm, va, &pa, &flags) || (flags & (PTE_U | PTE_W)) != (PTE_U | PTE_W))
+        return -EFAULT;
+
+    self->ipc_buffer = va;
+    return 0;
+}
+
+/// @fn      static bool ipc_fast_ok(const struct thread *t)
+/// @brief   Tests whether a blocked thread can be resumed directly by the fast path.
+///
+/// @param   t the thread
+/// @returns true if t blocked through the fast path, has left its processor, and may run next here
+static bool ipc_fast_ok(const struct thread *t)
+{
+    return t->ipc_frame && !__atomic_load_n(&t->on_cpu, __ATOMIC_ACQUIRE) && sched_can_handoff(t);
+}
+
+/// @fn      struct ipc_switch ipc_fastpath(struct ipc_frame *frame)
+/// @brief   Fast path of SYS_IPC_CALL and SYS_IPC_REPLY_WAIT, called by ipc_entry.
+///
+/// @details Handles short messages between threads that both block and resume through the fast path. A call takes a
+/// waiting server; a reply-wait answers the caller and waits on an endpoint with no queued callers. The message is
+/// copied from frame into the partner's saved registers, the current thread is left blocked with frame as its saved
+/// context, and the processor is handed over with sched_handoff(). The stub then loads the partner's frame and
+/// returns to user mode, so the round trip touches no run queue and makes no context_switch() call. Everything that
+/// could fail is checked before the current thread is published, and any doubt sends the call to the slow path.
+///
+/// @param   frame the current thread's registers, saved by ipc_entry
+/// @returns the frame to resume and the thread it replaces, or a NULL frame to take the slow path
+struct ipc_switch ipc_fastpath(struct ipc_frame *frame)
+{
+    struct ipc_switch     sw   = { NULL, NULL };
+    struct syscall_frame *regs = &frame->sys;
+    struct thread        *self = this_cpu_read(current);
+    struct ipc_endpoint  *ep   = ipc_endpoint_get(regs->rdi);
+    struct thread        *next;
+
+    if (!ep || (regs->rsi & IPC_TAG_CAP) || IPC_TAG_LENGTH(regs->rsi) > IPC_FAST_WORDS)
+        return sw;
+
+    self->ipc_regs  = regs;
+    self->ipc_frame = frame;
+    self->rsp       = (uint64_t) frame;
+
+    if (regs->rax == SYS_IPC_CALL) {
+        spin_lock(&ep->lock);
+        next = ep->receivers;
+        if (!next || !ipc_fast_ok(next)) {
+            spin_unlock(&ep->lock);
+            self->ipc_frame = NULL;
+            return sw;
+        }
+        ep->receivers = next->ipc_next;
+        spin_unlock(&ep->lock);
+
+        __atomic_store_n(&self->state, THREAD_BLOCKED, __ATOMIC_RELAXED);
+        next->ipc_partner = self;
+        ipc_transfer(next, self, regs);
+        next->ipc_regs->rdi = self->ipc_badge;
+        ipc_stats[this_cpu_read(cpu)].fast_calls++;
+    } else {
+        next = self->ipc_partner;
+        if (!next || !ipc_fast_ok(next) || __atomic_load_n(&ep->senders, __ATOMIC_RELAXED)) {
+            self->ipc_frame = NULL;
+            return sw;
+        }
+        spin_lock(&ep->lock);
+        if (ep->senders) {
+            spin_unlock(&ep->lock);
+            self->ipc_frame = NULL;
+            return sw;
+        }
+        // The reply is read from regs and ipc_partner is cleared before self is published: a caller on another CPU
+        // may take self off the receiver stack as soon as the lock drops, and then overwrites both.
+        self->ipc_partner = NULL;
+        ipc_transfer(next, self, regs);
+        __atomic_store_n(&self->state, THREAD_BLOCKED, __ATOMIC_RELAXED);
+        self->ipc_next = ep->receivers;
+        ep->receivers  = self;
+        spin_unlock(&ep->lock);
+        ipc_stats[this_cpu_read(cpu)].fast_replies++;
+    }
+
+    sw.next         = next->ipc_frame;
+    sw.prev         = self;
+    next->ipc_frame = NULL;
+    sched_handoff(self, next);
+    return sw;
+}
\ No newline at end of file
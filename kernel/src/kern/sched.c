@@ -0,0 +1,807 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/kern/sched.c                                                                           |
+// | Name          : Tickless SMP Scheduler (Source)                                                                   |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements per-CPU priority run queues, lock-free stealing and deadline-driven slices.            |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/context.h"
+#include "arch/fpu.h"
+#include "arch/idle.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/msr_shadow.h"
+#include "arch/percpu.h"
+#include "arch/pmu.h"
+#include "arch/pstate.h"
+#include "arch/telemetry.h"
+#include "arch/tsc.h"
+#include "arch/vectors.h"
+#include "kern/intr.h"
+#include "kern/sched.h"
+#include "mm/vm.h"
+#include "sys/errno.h"
+
+struct runqueue runqueues[CONFIG_MAX_CPUS];
+struct cpumask  sched_idle_cpus;
+
+static uint64_t     sched_slice_cycles;
+static unsigned int sched_nr_cpus;
+static uint32_t     sched_last_id;      /* thread identifiers handed out so far */
+
+#define SCHED_RING_MASK              (CONFIG_SCHED_QUEUE_SLOTS - 1)
+#define SCHED_PRIO_IDLE              CONFIG_SCHED_PRIORITIES
+
+/// @fn      static inline struct runqueue *this_rq(void)
+/// @brief   Returns the executing processor's run queue.
+///
+/// @returns a pointer to the run queue of the executing processor
+static __always_inline struct runqueue *this_rq(void)
+{
+    return this_cpu_read(runqueue);
+}
+
+/// @fn      static bool ring_push(struct sched_ring *ring, struct thread *t)
+/// @brief   Appends a thread to a ring. Called only by the owning CPU.
+///
+/// @param   ring the ring to append to
+/// @param   t    the thread to append
+/// @returns true on success, or false if the ring is full
+static bool ring_push(struct sched_ring *ring, struct thread *t)
+{
+    uint64_t tail = ring->tail;
+
+    if (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) >= CONFIG_SCHED_QUEUE_SLOTS)
+        return false;
+    __atomic_store_n(&ring->slots[tail & SCHED_RING_MASK], t, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/// @fn      static struct thread *ring_pop(struct sched_ring *ring)
+/// @brief   Removes the oldest thread from a ring. Safe to call from any CPU.
+///
+/// @details The slot is read before head is claimed. The producer can only reuse that slot after head has moved past
+/// it, in which case the compare-and-swap fails and the stale read is discarded.
+///
+/// @param   ring the ring to remove from
+/// @returns the removed thread, or NULL if the ring is empty
+static struct thread *ring_pop(struct sched_ring *ring)
+{
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        if (head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE))
+            return NULL;
+        struct thread *t = __atomic_load_n(&ring->slots[head & SCHED_RING_MASK], __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&ring->head, &head, head + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return t;
+    }
+}
+
+/// @fn      static void list_push(struct sched_list *list, struct thread *t)
+/// @brief   Appends a thread to a CPU-private run list.
+///
+/// @param   list the list to append to
+/// @param   t    the thread to append
+/// @returns None (void)
+static void list_push(struct sched_list *list, struct thread *t)
+{
+    t->next = NULL;
+    if (list->tail)
+        list->tail->next = t;
+    else
+        list->head = t;
+    list->tail = t;
+}
+
+/// @fn      static struct thread *list_pop(struct sched_list *list)
+/// @brief   Removes the oldest thread from a CPU-private run list.
+///
+/// @param   list the list to remove from
+/// @returns the removed thread, or NULL if the list is empty
+static struct thread *list_pop(struct sched_list *list)
+{
+    struct thread *t = list->head;
+
+    if (t) {
+        list->head = t->next;
+        if (!list->head)
+            list->tail = NULL;
+    }
+    return t;
+}
+
+/// @fn      static void rq_enqueue(struct runqueue *rq, struct thread *t)
+/// @brief   Queues a runnable thread on the executing processor's run queue.
+///
+/// @details Migratable threads go to the priority's stealable ring; pinned threads, and any overflow when the ring is
+/// full, go to the CPU-private list. Each thread is stamped with a per-CPU sequence number so that dequeueing can
+/// preserve FIFO order across the two.
+///
+/// @param   rq the executing processor's run queue
+/// @param   t  the thread to queue, already in THREAD_RUNNABLE
+/// @returns None (void)
+static void rq_enqueue(struct runqueue *rq, struct thread *t)
+{
+    uint32_t bit = 1u << t->priority;
+
+    __atomic_store_n(&t->seq, rq->seq++, __ATOMIC_RELAXED);
+    t->cpu = (uint16_t) rq->cpu;
+
+    if ((t->flags & THREAD_PINNED) || !ring_push(&rq->rings[t->priority], t))
+        list_push(&rq->local[t->priority], t);
+    else if (!(rq->ready_mask & bit))
+        __atomic_store_n(&rq->ready_mask, rq->ready_mask | bit, __ATOMIC_RELEASE);
+    rq->bitmap |= bit;
+}
+
+/// @fn      static struct thread *rq_take(struct runqueue *rq, unsigned int prio)
+/// @brief   Removes the longest-waiting thread of one priority from the executing processor's run queue.
+///
+/// @param   rq   the executing processor's run queue
+/// @param   prio the priority level
+/// @returns the removed thread, or NULL if the level is empty
+static struct thread *rq_take(struct runqueue *rq, unsigned int prio)
+{
+    struct sched_ring *ring = &rq->rings[prio];
+    struct sched_list *list = &rq->local[prio];
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        if (head == ring->tail)
+            return list_pop(list);
+        struct thread *t = __atomic_load_n(&ring->slots[head & SCHED_RING_MASK], __ATOMIC_RELAXED);
+        if (list->head && list->head->seq < __atomic_load_n(&t->seq, __ATOMIC_RELAXED))
+            return list_pop(list);
+        if (__atomic_compare_exchange_n(&ring->head, &head, head + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return t;
+    }
+}
+
+/// @fn      static unsigned int rq_drain_inbox(struct runqueue *rq)
+/// @brief   Moves threads woken by other CPUs from the inbox onto the local run queue, in wake-up order.
+///
+/// @param   rq the executing processor's run queue
+/// @returns the most urgent priority among the threads moved, or SCHED_PRIO_IDLE if the inbox was empty
+static unsigned int rq_drain_inbox(struct runqueue *rq)
+{
+    struct thread *t, *next, *fifo = NULL;
+    unsigned int   prio = SCHED_PRIO_IDLE;
+
+    if (!__atomic_load_n(&rq->inbox, __ATOMIC_RELAXED))
+        return prio;
+
+    t = __atomic_exchange_n(&rq->inbox, NULL, __ATOMIC_ACQUIRE);
+    for (; t; t = next) {
+        next    = t->next;
+        t->next = fifo;
+        fifo    = t;
+    }
+    for (t = fifo; t; t = next) {
+        next = t->next;
+        if (t->priority < prio)
+            prio = t->priority;
+        rq_enqueue(rq, t);
+    }
+    return prio;
+}
+
+/// @fn      static struct thread *sched_steal(struct runqueue *rq)
+/// @brief   Takes a runnable thread from another CPU's stealable rings.
+///
+/// @details Victims are visited round-robin starting after the thief, and only the priorities their owners have
+/// published in ready_mask are probed, so a scan costs one shared cache-line read per CPU with nothing to offer.
+///
+/// @param   rq the executing (thief) processor's run queue
+/// @returns the stolen thread, or NULL if no CPU had stealable work
+static struct thread *sched_steal(struct runqueue *rq)
+{
+    unsigned int nr = __atomic_load_n(&sched_nr_cpus, __ATOMIC_ACQUIRE);
+
+    for (unsigned int i = 1; i < nr; i++) {
+        struct runqueue *victim = &runqueues[(rq->cpu + i) % nr];
+        uint32_t mask = __atomic_load_n(&victim->ready_mask, __ATOMIC_ACQUIRE);
+
+        for (; mask; mask &= mask - 1) {
+            struct thread *t = ring_pop(&victim->rings[__builtin_ctz(mask)]);
+            if (t) {
+                rq->stats.steals++;
+                return t;
+            }
+        }
+    }
+    return NULL;
+}
+
+/// @fn      static struct thread *rq_pick(struct runqueue *rq)
+/// @brief   Chooses the next thread to run on the executing processor.
+///
+/// @param   rq the executing processor's run queue
+/// @returns the highest-priority local thread, a stolen thread if none is local, or NULL to idle
+static struct thread *rq_pick(struct runqueue *rq)
+{
+    rq_drain_inbox(rq);
+
+    while (rq->bitmap) {
+        unsigned int prio = (unsigned int) __builtin_ctz(rq->bitmap);
+        struct thread *t = rq_take(rq, prio);
+        if (t)
+            return t;
+        rq->bitmap &= ~(1u << prio);
+        __atomic_store_n(&rq->ready_mask, rq->ready_mask & ~(1u << prio), __ATOMIC_RELAXED);
+    }
+    return sched_steal(rq);
+}
+
+/// @fn      static void sched_program_timer(struct runqueue *rq)
+/// @brief   Programs the local one-shot timer for the earlier of the slice end and the event deadline, if any.
+///
+/// @param   rq the executing processor's run queue
+/// @returns None (void)
+static void sched_program_timer(struct runqueue *rq)
+{
+    uint64_t deadline = rq->slice_armed ? rq->slice_deadline : 0;
+
+    if (rq->event_deadline && (!deadline || rq->event_deadline < deadline))
+        deadline = rq->event_deadline;
+    if (deadline == rq->timer_deadline)
+        return;
+
+    rq->timer_deadline = deadline;
+    if (deadline)
+        apic_timer_arm(deadline);
+    else
+        apic_timer_cancel();
+}
+
+/// @fn      static void sched_arm_slice(struct runqueue *rq, uint64_t now)
+/// @brief   Arms the local one-shot timer to end the current thread's time slice.
+///
+/// @param   rq  the executing processor's run queue
+/// @param   now the current TSC value
+/// @returns None (void)
+static void sched_arm_slice(struct runqueue *rq, uint64_t now)
+{
+    rq->slice_deadline = now + sched_slice_cycles;
+    rq->slice_armed    = true;
+    rq->stats.timer_arms++;
+    sched_program_timer(rq);
+}
+
+/// @fn      static void sched_update_timer(struct runqueue *rq, struct thread *next, uint64_t now)
+/// @brief   Programs the local timer for the thread about to run.
+///
+/// @details There is no periodic tick. A slice timer is needed only while another thread of the same priority is
+/// waiting on this CPU; higher-priority arrivals preempt through need_resched and lower-priority ones simply wait. A
+/// thread running uncontended, and the idle thread, therefore take no timer interrupts at all.
+///
+/// @param   rq   the executing processor's run queue
+/// @param   next the thread about to run
+/// @param   now  the current TSC value
+/// @returns None (void)
+static void sched_update_timer(struct runqueue *rq, struct thread *next, uint64_t now)
+{
+    const struct sched_ring *ring = &rq->rings[next->priority];
+
+    if (next != rq->idle && (__atomic_load_n(&ring->head, __ATOMIC_RELAXED) != ring->tail ||
+                             rq->local[next->priority].head)) {
+        sched_arm_slice(rq, now);
+    } else if (rq->slice_armed) {
+        rq->slice_armed = false;
+        sched_program_timer(rq);
+    }
+}
+
+/// @fn      static void sched_notify(struct runqueue *rq, unsigned int cpu)
+/// @brief   Makes another CPU reschedule: a store to its monitored line if it is in MWAIT, an IPI otherwise.
+///
+/// @param   rq  the executing processor's run queue
+/// @param   cpu the logical index of the CPU to notify
+/// @returns None (void)
+static void sched_notify(struct runqueue *rq, unsigned int cpu)
+{
+    if (idle_wake(&runqueues[cpu].idle_line, cpu, VECTOR_IPI_RESCHEDULE))
+        rq->stats.ipis++;
+    else
+        rq->stats.line_wakeups++;
+}
+
+/// @fn      static void sched_kick_idle(struct runqueue *rq)
+/// @brief   Wakes one idle CPU so that it can steal work queued behind a busy one.
+///
+/// @param   rq the executing processor's run queue
+/// @returns None (void)
+static void sched_kick_idle(struct runqueue *rq)
+{
+    int cpu = cpumask_next(&sched_idle_cpus, -1);
+
+    if (cpu < CONFIG_MAX_CPUS && cpumask_test_and_clear_atomic(&sched_idle_cpus, (unsigned int) cpu))
+        sched_notify(rq, (unsigned int) cpu);
+}
+
+/// @fn      static void sched_make_runnable(struct thread *t, unsigned int cpu)
+/// @brief   Places a thread already marked THREAD_RUNNABLE on a CPU and notifies that CPU if it must reschedule.
+///
+/// @details A local enqueue only sets need_resched or arms a slice. A remote one pushes onto the target's inbox, a
+/// lock-free LIFO the target drains on its next scheduling decision, and notifies the target unless it is running
+/// something more urgent; for an equal priority the target only arms its slice timer. The push is a full barrier that
+/// pairs with the fence in sched_idle(), so either the waker sees the target idle or the target sees the inbox
+/// non-empty before it sleeps. A target waiting in MWAIT is woken by the push and the wake store on its remote line
+/// alone, without an IPI.
+///
+/// @param   t   the thread to make runnable
+/// @param   cpu the CPU whose run queue should receive it
+/// @returns None (void)
+static void sched_make_runnable(struct thread *t, unsigned int cpu)
+{
+    struct runqueue *rq = this_rq();
+
+    if (cpu == rq->cpu) {
+        rq_enqueue(rq, t);
+        if (t->priority < rq->cur_prio)
+            rq->need_resched = true;
+        else if (t->priority == rq->cur_prio && !rq->slice_armed)
+            sched_arm_slice(rq, _rdtsc());
+        if (!(t->flags & THREAD_PINNED) && rq->cur_prio != SCHED_PRIO_IDLE)
+            sched_kick_idle(rq);
+        return;
+    }
+
+    struct runqueue *target = &runqueues[cpu];
+    struct thread   *head   = __atomic_load_n(&target->inbox, __ATOMIC_RELAXED);
+    do {
+        t->next = head;
+    } while (!__atomic_compare_exchange_n(&target->inbox, &head, t, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    rq->stats.remote_wakeups++;
+
+    if (t->priority <= __atomic_load_n(&target->cur_prio, __ATOMIC_SEQ_CST))
+        sched_notify(rq, cpu);
+}
+
+/// @fn      static void sched_switch_bases(struct thread *prev, struct thread *next)
+/// @brief   Saves the outgoing thread's user FS and GS bases and queues the incoming thread's.
+///
+/// @details The bases only matter in user mode, so they are deferred to the next return there. Switching through
+/// several threads, or back to the thread that entered the kernel, then writes each base at most once, and not at all
+/// when the values already loaded are the right ones. Without FSGSBASE user mode cannot change its bases, so the
+/// saved copies stay current and nothing is read back.
+///
+/// @param   prev the thread being switched away from
+/// @param   next the thread to run
+/// @returns None (void)
+static void sched_switch_bases(struct thread *prev, struct thread *next)
+{
+    if (prev->kstack_top && msr_fsgsbase) {
+        prev->fs_base = msr_read_base(MSR_SLOT_FS_BASE);
+        prev->gs_base = msr_read_base(MSR_SLOT_USER_GS_BASE);
+    }
+    if (next->kstack_top) {
+        msr_write_deferred(MSR_SLOT_FS_BASE, next->fs_base);
+        msr_write_deferred(MSR_SLOT_USER_GS_BASE, next->gs_base);
+    }
+}
+
+/// @fn      static void sched_switch_prepare(struct runqueue *rq, struct thread *prev, struct thread *next)
+/// @brief   Makes next the executing processor's current thread, short of resuming its saved context.
+///
+/// @details A thread may be picked (locally or by a thief) while the CPU it last ran on is still saving its registers.
+/// on_cpu is cleared by that CPU only after the switch completes, so the new owner waits for it here; the window is a
+/// few dozen instructions and the wait is almost never taken.
+///
+/// @param   rq   the executing processor's run queue
+/// @param   prev the thread being switched away from
+/// @param   next the thread to run
+/// @returns None (void)
+static void sched_switch_prepare(struct runqueue *rq, struct thread *prev, struct thread *next)
+{
+    while (__atomic_load_n(&next->on_cpu, __ATOMIC_ACQUIRE))
+        _pause();
+
+    next->on_cpu = 1;
+    next->cpu    = (uint16_t) rq->cpu;
+    __atomic_store_n(&next->state, THREAD_RUNNING, __ATOMIC_RELAXED);
+    __atomic_store_n(&rq->cur_prio, next == rq->idle ? SCHED_PRIO_IDLE : next->priority, __ATOMIC_RELAXED);
+
+    if (next->wake_tsc) {
+        uint64_t latency = rq->dispatch_tsc - next->wake_tsc;
+        rq->stats.latency_count++;
+        rq->stats.latency_sum += latency;
+        if (latency > rq->stats.latency_max)
+            rq->stats.latency_max = latency;
+        next->wake_tsc = 0;
+    }
+
+    this_cpu_write(current, next);
+    if (next->kstack_top) {
+        this_cpu_write(kernel_rsp, next->kstack_top);
+        percpu[rq->cpu].tss.stack_ptr_0 = next->kstack_top;
+    }
+    rq->stats.switches++;
+
+    idle_sync_umwait(rq->cpu);
+    vm_switch_to(rq->cpu, next->vm);
+    fpu_switch(prev, next);
+    pmu_context_switch(rq->cpu, prev->pmu, next->pmu);
+    sched_switch_bases(prev, next);
+}
+
+/// @fn      static void sched_switch(struct runqueue *rq, struct thread *prev, struct thread *next)
+/// @brief   Hands the executing processor from prev to next.
+///
+/// @param   rq   the executing processor's run queue
+/// @param   prev the thread being switched away from
+/// @param   next the thread to run
+/// @returns None (void)
+static void sched_switch(struct runqueue *rq, struct thread *prev, struct thread *next)
+{
+    sched_switch_prepare(rq, prev, next);
+    prev = context_switch(&prev->rsp, next->rsp, prev);
+    sched_finish_switch(prev);
+}
+
+/// @fn      void sched_finish_switch(struct thread *prev)
+/// @brief   Completes a context switch on the incoming thread's stack by releasing the outgoing thread.
+///
+/// @param   prev the thread that was switched away from
+/// @returns None (void)
+void sched_finish_switch(struct thread *prev)
+{
+    __atomic_store_n(&prev->on_cpu, 0, __ATOMIC_RELEASE);
+}
+
+/// @fn      void schedule(void)
+/// @brief   Runs the highest-priority runnable thread on the executing processor.
+///
+/// @details The current thread is requeued at the tail of its priority if it is still running; a thread that has
+/// blocked or exited is not. If nothing is runnable locally the CPU tries to steal, and otherwise switches to its idle
+/// thread. The dispatched thread's performance policy is applied here, including when it keeps running after a policy
+/// change; switching to the idle thread leaves the request alone, so blocking briefly costs no MSR writes.
+///
+/// @returns None (void)
+void schedule(void)
+{
+    uint64_t         flags = irq_save();
+    struct runqueue *rq    = this_rq();
+    struct thread   *prev  = this_cpu_read(current);
+    uint64_t         now   = _rdtsc();
+
+    rq->need_resched = false;
+    telemetry_tick(rq->cpu);
+    prev->runtime   += now - rq->dispatch_tsc;
+    rq->dispatch_tsc = now;
+
+    if (prev != rq->idle && __atomic_load_n(&prev->state, __ATOMIC_RELAXED) == THREAD_RUNNING) {
+        __atomic_store_n(&prev->state, THREAD_RUNNABLE, __ATOMIC_RELAXED);
+        rq_enqueue(rq, prev);
+    }
+
+    struct thread *next = rq_pick(rq);
+    if (!next)
+        next = rq->idle;
+
+    sched_update_timer(rq, next, now);
+    if (next != rq->idle)
+        pstate_update(rq->cpu, next->perf_policy);
+    if (next != prev)
+        sched_switch(rq, prev, next);
+    else
+        __atomic_store_n(&prev->state, THREAD_RUNNING, __ATOMIC_RELAXED);
+    irq_restore(flags);
+}
+
+/// @fn      bool sched_can_handoff(const struct thread *next)
+/// @brief   Tests whether the executing processor may switch straight to a blocked thread, bypassing the run queue.
+///
+/// @details True when nothing more urgent is queued or pending here and next may run on this CPU, so that the direct
+/// switch makes the same choice schedule() would have made had next been woken and queued.
+///
+/// @param   next the blocked thread
+/// @returns true if sched_handoff() to next is allowed
+bool sched_can_handoff(const struct thread *next)
+{
+    const struct runqueue *rq = this_rq();
+
+    if (rq->need_resched || __atomic_load_n(&rq->inbox, __ATOMIC_RELAXED))
+        return false;
+    if (rq->bitmap && (unsigned int) __builtin_ctz(rq->bitmap) < next->priority)
+        return false;
+    return !(next->flags & THREAD_PINNED) || next->cpu == rq->cpu;
+}
+
+/// @fn      void sched_handoff(struct thread *prev, struct thread *next)
+/// @brief   Performs the scheduler's part of a direct switch from a thread that has just blocked to a blocked thread.
+///
+/// @details Used by IPC, where the caller donates the processor (and the rest of its slice) to the thread that will
+/// serve it. Neither thread touches a run queue. The caller must have checked sched_can_handoff(), marked prev
+/// THREAD_BLOCKED, and must resume next's saved context itself, calling sched_finish_switch(prev) once off prev's
+/// stack. Interrupts must be disabled.
+///
+/// @param   prev the current thread, already blocked
+/// @param   next the thread to run
+/// @returns None (void)
+void sched_handoff(struct thread *prev, struct thread *next)
+{
+    struct runqueue *rq  = this_rq();
+    uint64_t         now = _rdtsc();
+
+    telemetry_tick(rq->cpu);
+    prev->runtime   += now - rq->dispatch_tsc;
+    rq->dispatch_tsc = now;
+    sched_update_timer(rq, next, now);
+    pstate_update(rq->cpu, next->perf_policy);
+    sched_switch_prepare(rq, prev, next);
+}
+
+/// @fn      void sched_preempt(void)
+/// @brief   Reschedules if an interrupt or a wake-up requested it.
+///
+/// @details Called with interrupts disabled on every return to user mode: from interrupts, from SYSCALL (including the
+/// IPC paths) and from the legacy gate. The kernel itself is never preempted.
+///
+/// @returns None (void)
+void sched_preempt(void)
+{
+    if (this_rq()->need_resched)
+        schedule();
+}
+
+/// @fn      void sched_yield(void)
+/// @brief   Gives up the processor to the next runnable thread of equal or higher priority.
+///
+/// @returns None (void)
+void sched_yield(void)
+{
+    schedule();
+}
+
+/// @fn      void sched_prepare_block(void)
+/// @brief   Marks the current thread as about to block.
+///
+/// @details Must be called before the caller checks its wake-up condition, and followed by sched_block() whatever the
+/// outcome of that check. A sched_wake() that races in between turns the block into a no-op instead of being lost.
+///
+/// @returns None (void)
+void sched_prepare_block(void)
+{
+    struct thread *self = this_cpu_read(current);
+
+    __atomic_store_n(&self->state, THREAD_BLOCKED, __ATOMIC_SEQ_CST);
+}
+
+/// @fn      void sched_block(void)
+/// @brief   Blocks the current thread until sched_wake() is called on it.
+///
+/// @returns None (void)
+void sched_block(void)
+{
+    schedule();
+}
+
+/// @fn      bool sched_wake(struct thread *t)
+/// @brief   Makes a blocked thread runnable on the CPU it last ran on.
+///
+/// @param   t the thread to wake
+/// @returns true if the thread was blocked and has been woken, or false if it was not blocked
+bool sched_wake(struct thread *t)
+{
+    uint32_t expected = THREAD_BLOCKED;
+
+    if (!__atomic_compare_exchange_n(&t->state, &expected, THREAD_RUNNABLE, false, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_RELAXED))
+        return false;
+
+    uint64_t flags = irq_save();
+    t->wake_tsc = _rdtsc();
+    sched_make_runnable(t, t->cpu);
+    irq_restore(flags);
+    return true;
+}
+
+/// @fn      void sched_add(struct thread *t, unsigned int cpu)
+/// @brief   Makes a newly initialized thread runnable on a given CPU.
+///
+/// @param   t   the thread, prepared with sched_thread_init()
+/// @param   cpu the CPU to queue it on; it may later be stolen unless THREAD_PINNED is set
+/// @returns None (void)
+void sched_add(struct thread *t, unsigned int cpu)
+{
+    uint64_t flags = irq_save();
+
+    __atomic_store_n(&t->state, THREAD_RUNNABLE, __ATOMIC_RELAXED);
+    sched_make_runnable(t, cpu);
+    irq_restore(flags);
+}
+
+/// @fn      void sched_exit(void)
+/// @brief   Terminates the current thread. Its storage may be reclaimed once on_cpu reads as zero.
+///
+/// @returns Does not return
+void sched_exit(void)
+{
+    struct thread *self = this_cpu_read(current);
+
+    _cli();
+    __atomic_store_n(&self->state, THREAD_DEAD, __ATOMIC_RELAXED);
+    schedule();
+    for (;;)
+        _hlt();
+}
+
+/// @fn      int sched_thread_init(struct thread *t, void (*entry)(void *), void *arg, void *stack_top,
+///                                uint8_t priority, uint8_t flags)
+/// @brief   Prepares a thread control block so that, once added, the thread starts by calling entry(arg).
+///
+/// @details The thread is given the next identifier, which profiler samples record. Identifiers start at 1 (idle
+/// threads keep 0) and are not reused until the counter wraps after 2^32 - 1 threads.
+///
+/// @param   t         the thread control block, owned by the caller
+/// @param   entry     the thread function; returning from it exits the thread
+/// @param   arg       the argument passed to entry
+/// @param   stack_top the top of the thread's kernel stack
+/// @param   priority  the scheduling priority, 0 being the most urgent
+/// @param   flags     THREAD_* flags
+/// @returns 0 on success, or -EINVAL if the priority is out of range
+int sched_thread_init(struct thread *t, void (*entry)(void *), void *arg, void *stack_top, uint8_t priority,
+                      uint8_t flags)
+{
+    if (priority >= CONFIG_SCHED_PRIORITIES)
+        return -EINVAL;
+
+    *t = (struct thread) {
+        .rsp      = context_init(stack_top, entry, arg),
+        .state    = THREAD_BLOCKED,
+        .priority = priority,
+        .flags    = flags,
+        .id       = __atomic_add_fetch(&sched_last_id, 1, __ATOMIC_RELAXED),
+    };
+    return 0;
+}
+
+/// @fn      void sched_init_cpu(unsigned int cpu, struct thread *idle)
+/// @brief   Sets up the executing processor's run queue and adopts the running context as its idle thread.
+///
+/// @details Must run on the processor being initialized, with interrupts disabled, after percpu_init() and
+/// apic_init(), and on the bootstrap processor after tsc_init(). The CPU becomes a stealing victim and thief as soon as
+/// it is counted in sched_nr_cpus.
+///
+/// @param   cpu  the logical index of the executing processor
+/// @param   idle storage for the idle thread, which takes over the current stack
+/// @returns None (void)
+void sched_init_cpu(unsigned int cpu, struct thread *idle)
+{
+    struct runqueue *rq = &runqueues[cpu];
+
+    if (cpu == 0)
+        sched_slice_cycles = tsc_ns_to_cycles(CONFIG_SCHED_SLICE_NS);
+
+    *idle = (struct thread) {
+        .state    = THREAD_RUNNING,
+        .on_cpu   = 1,
+        .cpu      = (uint16_t) cpu,
+        .priority = CONFIG_SCHED_PRIORITIES - 1,
+        .flags    = THREAD_PINNED,
+    };
+
+    rq->cpu          = cpu;
+    rq->idle         = idle;
+    rq->cur_prio     = SCHED_PRIO_IDLE;
+    rq->dispatch_tsc = _rdtsc();
+
+    percpu[cpu].runqueue = rq;
+    percpu[cpu].current  = idle;
+
+    unsigned int nr = __atomic_load_n(&sched_nr_cpus, __ATOMIC_RELAXED);
+    while (nr < cpu + 1 && !__atomic_compare_exchange_n(&sched_nr_cpus, &nr, cpu + 1, true, __ATOMIC_RELEASE,
+                                                        __ATOMIC_RELAXED))
+        ;
+}
+
+/// @fn      void sched_idle(void)
+/// @brief   Runs the idle loop of the executing processor. Called once by each CPU after sched_init_cpu().
+///
+/// @details Each pass clears the wake word, schedules (which steals if nothing is local), then advertises the CPU in
+/// sched_idle_cpus and sleeps in idle_enter() with no timer armed. The inbox is rechecked after the advertisement so
+/// that a wake-up posted concurrently is not slept through; idle_enter() closes the remaining window, against either
+/// the wake-word store or the reschedule IPI.
+///
+/// @returns Does not return
+void sched_idle(void)
+{
+    struct runqueue *rq = this_rq();
+
+    for (;;) {
+        _cli();
+        __atomic_exchange_n(&rq->idle_line.wake, 0, __ATOMIC_SEQ_CST);
+        schedule();
+        telemetry_tick(rq->cpu);
+
+        cpumask_set_atomic(&sched_idle_cpus, rq->cpu);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (!__atomic_load_n(&rq->inbox, __ATOMIC_RELAXED) && !rq->need_resched)
+            idle_enter(rq->cpu, &rq->idle_line);
+        cpumask_clear_atomic(&sched_idle_cpus, rq->cpu);
+    }
+}
+
+/// @fn      void sched_timer_event(uint64_t deadline)
+/// @brief   Requests a timer interrupt on the executing processor for a kernel event, such as interrupt coalescing.
+///
+/// @details The local timer is shared with time slices and fires for whichever comes first. Only one event deadline
+/// is kept; the caller passes the earliest it needs, and 0 cancels it. Called with interrupts disabled.
+///
+/// @param   deadline the TSC value at which intr_timer_expired() should run, or 0
+/// @returns None (void)
+void sched_timer_event(uint64_t deadline)
+{
+    struct runqueue *rq = this_rq();
+
+    rq->event_deadline = deadline;
+    sched_program_timer(rq);
+}
+
+/// @fn      void sched_timer_interrupt(void)
+/// @brief   Handles VECTOR_APIC_TIMER: the current time slice has expired, an event deadline has passed, or both.
+///
+/// @returns None (void)
+void sched_timer_interrupt(void)
+{
+    struct runqueue *rq  = this_rq();
+    uint64_t         now = _rdtsc();
+
+    rq->timer_deadline = 0;
+    if (rq->event_deadline && now >= rq->event_deadline) {
+        rq->event_deadline = 0;
+        intr_timer_expired(now);
+    }
+    if (rq->slice_armed && now >= rq->slice_deadline) {
+        rq->slice_armed  = false;
+        rq->need_resched = true;
+    }
+    sched_program_timer(rq);
+    apic_eoi();
+}
+
+/// @fn      void sched_ipi_interrupt(void)
+/// @brief   Handles VECTOR_IPI_RESCHEDULE: another CPU queued work for this one.
+///
+/// @details The inbox is drained here so that the arrivals are judged as a local wake-up would be: a more urgent
+/// thread preempts, and one of the running thread's priority gets a slice timer so that it runs within a slice. The
+/// same IPI carries CPU-level performance policy changes made elsewhere, so the running thread's P-state request is
+/// brought up to date here rather than at its next switch, which may be far off on a tickless core.
+///
+/// @returns None (void)
+void sched_ipi_interrupt(void)
+{
+    struct runqueue     *rq   = this_rq();
+    const struct thread *self = this_cpu_read(current);
+    unsigned int         prio = rq_drain_inbox(rq);
+
+    if (prio < rq->cur_prio)
+        rq->need_resched = true;
+    else if (prio == rq->cur_prio && !rq->slice_armed)
+        sched_arm_slice(rq, _rdtsc());
+    if (self != rq->idle)
+        pstate_update(rq->cpu, self->perf_policy);
+    apic_eoi();
+}
\ No newline at end of file
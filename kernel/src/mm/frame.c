@@ -0,0 +1,485 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/mm/frame.c                                                                             |
+// | Name          : Physical Frame Allocator (Source)                                                                 |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements per-node buddy lists seeded from the UEFI memory map, fronted by per-CPU magazines.    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/irq.h"
+#include "arch/percpu.h"
+#include "mm/frame.h"
+#include "mm/numa.h"
+#include "sys/efi.h"
+#include "sys/errno.h"
+
+struct frame_map  frame_map;
+struct frame_zone frame_zones[CONFIG_MAX_NODES];
+struct frame_cpu  frame_cpus[CONFIG_MAX_CPUS];
+
+#define FRAME_LOW_PFNS               256            /* first 1 MiB, kept for real-mode AP start-up code */
+#define FRAME_MAGAZINE_ORDER         (__builtin_ctz(CONFIG_FRAME_MAGAZINE_SIZE))
+
+_Static_assert((CONFIG_FRAME_MAGAZINE_SIZE & (CONFIG_FRAME_MAGAZINE_SIZE - 1)) == 0,
+               "CONFIG_FRAME_MAGAZINE_SIZE must be a power of two");
+_Static_assert(CONFIG_FRAME_MAGAZINE_SIZE <= (1 << (CONFIG_FRAME_ORDERS - 1)),
+               "a magazine must fit in the largest buddy block");
+
+/// @fn      static void frame_list_push(struct frame_zone *z, uint32_t idx, unsigned int order)
+/// @brief   Marks a block free and inserts it at the head of its order's free list.
+///
+/// @param   z     the block's zone, locked
+/// @param   idx   index of the block's first frame
+/// @param   order the block's order
+/// @returns None (void)
+static void frame_list_push(struct frame_zone *z, uint32_t idx, unsigned int order)
+{
+    struct frame *f = &frame_map.frames[idx];
+
+    f->order = (uint8_t) order;
+    f->flags = FRAME_FREE;
+    f->prev  = FRAME_NONE;
+    f->next  = z->free_head[order];
+    if (f->next != FRAME_NONE)
+        frame_map.frames[f->next].prev = idx;
+    z->free_head[order] = idx;
+    z->nr_free[order]++;
+}
+
+/// @fn      static void frame_list_remove(struct frame_zone *z, uint32_t idx, unsigned int order)
+/// @brief   Unlinks a free block from its order's free list.
+///
+/// @param   z     the block's zone, locked
+/// @param   idx   index of the block's first frame
+/// @param   order the block's order
+/// @returns None (void)
+static void frame_list_remove(struct frame_zone *z, uint32_t idx, unsigned int order)
+{
+    struct frame *f = &frame_map.frames[idx];
+
+    if (f->prev != FRAME_NONE)
+        frame_map.frames[f->prev].next = f->next;
+    else
+        z->free_head[order] = f->next;
+    if (f->next != FRAME_NONE)
+        frame_map.frames[f->next].prev = f->prev;
+    f->flags &= (uint8_t) ~FRAME_FREE;
+    z->nr_free[order]--;
+}
+
+/// @fn      static uint32_t frame_buddy_alloc(struct frame_zone *z, unsigned int order)
+/// @brief   Takes a block of the given order from a zone, splitting a larger one if necessary.
+///
+/// @param   z     the zone, locked
+/// @param   order the block order
+/// @returns index of the block's first frame, or FRAME_NONE if the zone has no block that large
+static uint32_t frame_buddy_alloc(struct frame_zone *z, unsigned int order)
+{
+    unsigned int o = order;
+
+    while (o < CONFIG_FRAME_ORDERS && z->free_head[o] == FRAME_NONE)
+        o++;
+    if (o == CONFIG_FRAME_ORDERS)
+        return FRAME_NONE;
+
+    uint32_t idx = z->free_head[o];
+    frame_list_remove(z, idx, o);
+    while (o > order) {
+        o--;
+        frame_list_push(z, idx + (1u << o), o);
+    }
+
+    frame_map.frames[idx].order = (uint8_t) order;
+    frame_map.frames[idx].flags = 0;
+    z->free_frames -= 1ULL << order;
+    z->allocs++;
+    return idx;
+}
+
+/// @fn      static void frame_buddy_free(struct frame_zone *z, uint32_t idx, unsigned int order)
+/// @brief   Returns a block to a zone, coalescing it with free buddies of the same node.
+///
+/// @details Frame indices are relative to a base aligned to the largest block, so a block's buddy is found by flipping
+/// one index bit, exactly as with physical frame numbers. Only the descriptors are read.
+///
+/// @param   z     the zone, locked
+/// @param   idx   index of the block's first frame
+/// @param   order the block's order
+/// @returns None (void)
+static void frame_buddy_free(struct frame_zone *z, uint32_t idx, unsigned int order)
+{
+    uint16_t node = frame_map.frames[idx].node;
+
+    z->free_frames += 1ULL << order;
+    z->frees++;
+
+    while (order + 1 < CONFIG_FRAME_ORDERS) {
+        uint32_t buddy = idx ^ (1u << order);
+        if (buddy >= frame_map.nr_frames)
+            break;
+        const struct frame *b = &frame_map.frames[buddy];
+        if (b->flags != FRAME_FREE || b->order != order || b->node != node)
+            break;
+        frame_list_remove(z, buddy, order);
+        idx &= ~(1u << order);
+        order++;
+    }
+    frame_list_push(z, idx, order);
+}
+
+/// @fn      static bool frame_refill(struct frame_cpu *fc, struct frame_magazine *m)
+/// @brief   Fills an empty magazine from the CPU's node under one lock acquisition.
+///
+/// @details A whole magazine-sized block is split when one is available, which keeps consecutive allocations
+/// physically adjacent; otherwise single frames are gathered.
+///
+/// @param   fc the executing processor's front end
+/// @param   m  the empty magazine
+/// @returns true if at least one frame was obtained
+static bool frame_refill(struct frame_cpu *fc, struct frame_magazine *m)
+{
+    struct frame_zone *z = &frame_zones[fc->node];
+
+    spin_lock(&z->lock);
+    uint32_t idx = frame_buddy_alloc(z, FRAME_MAGAZINE_ORDER);
+    if (idx != FRAME_NONE) {
+        for (uint32_t i = 0; i < CONFIG_FRAME_MAGAZINE_SIZE; i++) {
+            uint32_t frame = idx + CONFIG_FRAME_MAGAZINE_SIZE - 1 - i;
+            frame_map.frames[frame].order = 0;
+            frame_map.frames[frame].flags = FRAME_CACHED;
+            m->frames[i] = frame;
+        }
+        m->rounds = CONFIG_FRAME_MAGAZINE_SIZE;
+    } else {
+        while (m->rounds < CONFIG_FRAME_MAGAZINE_SIZE && (idx = frame_buddy_alloc(z, 0)) != FRAME_NONE) {
+            frame_map.frames[idx].flags = FRAME_CACHED;
+            m->frames[m->rounds++] = idx;
+        }
+    }
+    spin_unlock(&z->lock);
+
+    fc->refills++;
+    return m->rounds != 0;
+}
+
+/// @fn      static void frame_drain(struct frame_cpu *fc, struct frame_magazine *m)
+/// @brief   Empties a magazine into the CPU's node under one lock acquisition.
+///
+/// @param   fc the executing processor's front end
+/// @param   m  the magazine
+/// @returns None (void)
+static void frame_drain(struct frame_cpu *fc, struct frame_magazine *m)
+{
+    struct frame_zone *z = &frame_zones[fc->node];
+
+    spin_lock(&z->lock);
+    while (m->rounds) {
+        uint32_t idx = m->frames[--m->rounds];
+        frame_map.frames[idx].flags = 0;
+        frame_buddy_free(z, idx, 0);
+    }
+    spin_unlock(&z->lock);
+
+    fc->drains++;
+}
+
+/// @fn      uint64_t frame_alloc(void)
+/// @brief   Allocates one frame from the calling CPU's node.
+///
+/// @details The common case pops a frame from the loaded magazine with interrupts briefly disabled and no lock or
+/// atomic operation. If both magazines are empty one is refilled; if the node is exhausted the other nodes are tried.
+///
+/// @returns the frame's physical address, or 0 if memory is exhausted
+uint64_t frame_alloc(void)
+{
+    uint64_t               flags = irq_save();
+    struct frame_cpu      *fc    = &frame_cpus[this_cpu_read(cpu)];
+    struct frame_magazine *m     = fc->loaded;
+
+    if (unlikely(!m->rounds)) {
+        if (fc->previous->rounds) {
+            fc->loaded   = fc->previous;
+            fc->previous = m;
+            m            = fc->loaded;
+        } else if (!frame_refill(fc, m)) {
+            irq_restore(flags);
+            return frame_alloc_order(0, FRAME_NODE_LOCAL);
+        }
+    }
+
+    uint32_t idx = m->frames[--m->rounds];
+    frame_map.frames[idx].flags = 0;
+    fc->allocs++;
+    irq_restore(flags);
+    return ((uint64_t) idx + frame_map.base_pfn) << PAGE_SHIFT;
+}
+
+/// @fn      uint64_t frame_alloc_order(unsigned int order, uint32_t node)
+/// @brief   Allocates a naturally aligned block of 2^order frames directly from the buddy lists.
+///
+/// @details The preferred node is tried first, then the others in turn. Without a distance table (SLIT) the fallback
+/// order does not reflect node distances.
+///
+/// @param   order the block order, below CONFIG_FRAME_ORDERS
+/// @param   node  the preferred node, or FRAME_NODE_LOCAL for the calling CPU's
+/// @returns the block's physical address, or 0 if no block that large is free or order is out of range
+uint64_t frame_alloc_order(unsigned int order, uint32_t node)
+{
+    uint32_t idx = FRAME_NONE;
+
+    if (order >= CONFIG_FRAME_ORDERS)
+        return 0;
+
+    uint64_t flags = irq_save();
+    if (node >= numa_info.nr_nodes)
+        node = frame_cpus[this_cpu_read(cpu)].node;
+
+    for (uint32_t i = 0; i < numa_info.nr_nodes && idx == FRAME_NONE; i++) {
+        struct frame_zone *z = &frame_zones[(node + i) % numa_info.nr_nodes];
+        spin_lock(&z->lock);
+        idx = frame_buddy_alloc(z, order);
+        spin_unlock(&z->lock);
+    }
+    irq_restore(flags);
+
+    return idx == FRAME_NONE ? 0 : ((uint64_t) idx + frame_map.base_pfn) << PAGE_SHIFT;
+}
+
+/// @fn      void frame_free(uint64_t phys)
+/// @brief   Frees one frame obtained from frame_alloc() or frame_alloc_order(0, ...).
+///
+/// @details The frame goes into the loaded magazine, swapping in the previous magazine or draining it when the loaded
+/// one is full. A frame of another node bypasses the magazines so that it cannot be handed out as local memory.
+///
+/// @param   phys the frame's physical address
+/// @returns None (void)
+void frame_free(uint64_t phys)
+{
+    uint32_t          idx   = (uint32_t) ((phys >> PAGE_SHIFT) - frame_map.base_pfn);
+    struct frame     *f     = &frame_map.frames[idx];
+    uint64_t          flags = irq_save();
+    struct frame_cpu *fc    = &frame_cpus[this_cpu_read(cpu)];
+
+    if (unlikely(f->node != fc->node)) {
+        struct frame_zone *z = &frame_zones[f->node];
+        spin_lock(&z->lock);
+        frame_buddy_free(z, idx, 0);
+        spin_unlock(&z->lock);
+        fc->remote_frees++;
+    } else {
+        struct frame_magazine *m = fc->loaded;
+        if (unlikely(m->rounds == CONFIG_FRAME_MAGAZINE_SIZE)) {
+            if (fc->previous->rounds == CONFIG_FRAME_MAGAZINE_SIZE)
+                frame_drain(fc, fc->previous);
+            fc->loaded   = fc->previous;
+            fc->previous = m;
+            m            = fc->loaded;
+        }
+        f->flags = FRAME_CACHED;
+        m->frames[m->rounds++] = idx;
+        fc->frees++;
+    }
+    irq_restore(flags);
+}
+
+/// @fn      void frame_free_order(uint64_t phys, unsigned int order)
+/// @brief   Frees a block obtained from frame_alloc_order().
+///
+/// @param   phys  the block's physical address
+/// @param   order the order it was allocated with
+/// @returns None (void)
+void frame_free_order(uint64_t phys, unsigned int order)
+{
+    if (order == 0) {
+        frame_free(phys);
+        return;
+    }
+
+    uint32_t           idx = (uint32_t) ((phys >> PAGE_SHIFT) - frame_map.base_pfn);
+    struct frame_zone *z   = &frame_zones[frame_map.frames[idx].node];
+    uint64_t           flags = irq_save();
+
+    spin_lock(&z->lock);
+    frame_buddy_free(z, idx, order);
+    spin_unlock(&z->lock);
+    irq_restore(flags);
+}
+
+/// @fn      static bool frame_usable(const struct efi_memory_descriptor *d)
+/// @brief   Tests whether a UEFI memory region is free for the kernel once boot services have exited.
+///
+/// @details Loader code and data are excluded: they hold the kernel image, the memory map itself and anything else
+/// the loader handed over.
+///
+/// @param   d the memory descriptor
+/// @returns true if the region may be allocated
+static bool frame_usable(const struct efi_memory_descriptor *d)
+{
+    return d->type == EFI_CONVENTIONAL_MEMORY || d->type == EFI_BOOT_SERVICES_CODE ||
+           d->type == EFI_BOOT_SERVICES_DATA;
+}
+
+/// @fn      static void frame_add_range(uint64_t start, uint64_t end)
+/// @brief   Makes a range of frames allocatable, splitting it where NUMA node boundaries fall.
+///
+/// @details Each node's part is released as the largest naturally aligned blocks that fit, so seeding costs a few list
+/// operations per region rather than one per frame; coalescing joins blocks of adjacent regions.
+///
+/// @param   start the first page frame number
+/// @param   end   the page frame number one past the last
+/// @returns None (void)
+static void frame_add_range(uint64_t start, uint64_t end)
+{
+    while (start < end) {
+        uint64_t limit;
+        uint32_t node = numa_node_of_phys(start << PAGE_SHIFT, &limit);
+        uint64_t stop = limit >> PAGE_SHIFT;
+        if (stop > end || stop <= start)
+            stop = end;
+
+        struct frame_zone *z    = &frame_zones[node];
+        uint32_t           idx  = (uint32_t) (start - frame_map.base_pfn);
+        uint32_t           last = (uint32_t) (stop - frame_map.base_pfn);
+
+        for (uint32_t i = idx; i < last; i++) {
+            frame_map.frames[i].node  = (uint16_t) node;
+            frame_map.frames[i].flags = 0;
+        }
+        z->total_frames += last - idx;
+
+        while (idx < last) {
+            unsigned int order = 0;
+            while (order + 1 < CONFIG_FRAME_ORDERS && !(idx & ((2u << order) - 1)) && idx + (2u << order) <= last)
+                order++;
+            frame_buddy_free(z, idx, order);
+            idx += 1u << order;
+        }
+        start = stop;
+    }
+}
+
+/// @fn      int frame_init(const void *map, size_t map_size, size_t desc_size)
+/// @brief   Builds the frame allocator from the UEFI memory map.
+///
+/// @details Must run on the bootstrap processor after ExitBootServices() and numa_init(), with interrupts disabled.
+/// The descriptor array is carved from the first usable region large enough to hold it. Frames below 1 MiB are left
+/// unmanaged for real-mode start-up code, and memory beyond 2^32 frames (16 TiB) above the lowest usable address is
+/// ignored so that descriptor indices fit in 32 bits.
+///
+/// @param   map       the memory map, accessible through the direct map
+/// @param   map_size  the size of the map in bytes
+/// @param   desc_size the descriptor stride reported by GetMemoryMap()
+/// @returns 0 on success, -EINVAL if desc_size is too small, or -ENOMEM if no usable memory or no room for the
+///          descriptor array was found
+int frame_init(const void *map, size_t map_size, size_t desc_size)
+{
+    const uint8_t *base = map;
+    uint64_t       lo   = UINT64_MAX, hi = 0;
+
+    if (desc_size < sizeof(struct efi_memory_descriptor))
+        return -EINVAL;
+
+    for (size_t off = 0; off + desc_size <= map_size; off += desc_size) {
+        const struct efi_memory_descriptor *d = (const struct efi_memory_descriptor *) (base + off);
+        uint64_t start = d->physical_start >> PAGE_SHIFT, end = start + d->number_of_pages;
+        if (!frame_usable(d) || end <= FRAME_LOW_PFNS)
+            continue;
+        if (start < lo)
+            lo = start < FRAME_LOW_PFNS ? FRAME_LOW_PFNS : start;
+        if (end > hi)
+            hi = end;
+    }
+    if (hi == 0)
+        return -ENOMEM;
+
+    frame_map.base_pfn = lo & ~((1ULL << (CONFIG_FRAME_ORDERS - 1)) - 1);
+    if (hi - frame_map.base_pfn > FRAME_NONE)
+        hi = frame_map.base_pfn + FRAME_NONE;
+    frame_map.nr_frames  = hi - frame_map.base_pfn;
+    frame_map.meta_pages = (frame_map.nr_frames * sizeof(struct frame) + PAGE_SIZE - 1) >> PAGE_SHIFT;
+
+    uint64_t meta = 0;
+    for (size_t off = 0; off + desc_size <= map_size && !meta; off += desc_size) {
+        const struct efi_memory_descriptor *d = (const struct efi_memory_descriptor *) (base + off);
+        uint64_t start = d->physical_start >> PAGE_SHIFT, end = start + d->number_of_pages;
+        if (start < FRAME_LOW_PFNS)
+            start = FRAME_LOW_PFNS;
+        if (frame_usable(d) && end <= hi && end > start && end - start >= frame_map.meta_pages)
+            meta = start;
+    }
+    if (!meta)
+        return -ENOMEM;
+
+    frame_map.meta_phys = meta << PAGE_SHIFT;
+    frame_map.frames    = phys_to_virt(frame_map.meta_phys);
+    for (uint64_t i = 0; i < frame_map.nr_frames; i++)
+        frame_map.frames[i] = (struct frame) { .next = FRAME_NONE, .prev = FRAME_NONE, .flags = FRAME_RESERVED };
+
+    for (unsigned int n = 0; n < CONFIG_MAX_NODES; n++) {
+        frame_zones[n].lock = (struct spinlock) SPINLOCK_INIT;
+        for (unsigned int o = 0; o < CONFIG_FRAME_ORDERS; o++)
+            frame_zones[n].free_head[o] = FRAME_NONE;
+    }
+
+    uint64_t meta_end = meta + frame_map.meta_pages;
+    for (size_t off = 0; off + desc_size <= map_size; off += desc_size) {
+        const struct efi_memory_descriptor *d = (const struct efi_memory_descriptor *) (base + off);
+        uint64_t start = d->physical_start >> PAGE_SHIFT, end = start + d->number_of_pages;
+        if (!frame_usable(d))
+            continue;
+        if (start < FRAME_LOW_PFNS)
+            start = FRAME_LOW_PFNS;
+        if (end > hi)
+            end = hi;
+        if (start >= end)
+            continue;
+        frame_add_range(start, end < meta ? end : (start < meta ? meta : start));
+        frame_add_range(start > meta_end ? start : (end > meta_end ? meta_end : end), end);
+    }
+    return 0;
+}
+
+/// @fn      void frame_init_cpu(unsigned int cpu)
+/// @brief   Prepares the executing processor's magazines and binds it to its NUMA node.
+///
+/// @details Must run on every processor after apic_init() and frame_init(), before it first allocates. A processor
+/// whose node has no memory is bound to the first node with memory in frame_alloc_order()'s fallback order, so that
+/// its magazines are refilled from one zone instead of missing in an empty one on every refill. Without a distance
+/// table (SLIT) that order does not reflect node distances.
+///
+/// @param   cpu the logical index of the executing processor
+/// @returns None (void)
+void frame_init_cpu(unsigned int cpu)
+{
+    struct frame_cpu *fc   = &frame_cpus[cpu];
+    uint32_t          node = numa_node_of_apic(percpu[cpu].apic_id);
+
+    for (uint32_t i = 0; i < numa_info.nr_nodes; i++) {
+        if (frame_zones[(node + i) % numa_info.nr_nodes].total_frames) {
+            node = (node + i) % numa_info.nr_nodes;
+            break;
+        }
+    }
+
+    fc->node     = node;
+    fc->loaded   = &fc->mags[0];
+    fc->previous = &fc->mags[1];
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/mm/numa.c                                                                              |
+// | Name          : NUMA Topology (Source)                                                                            |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Parses the ACPI SRAT into dense node numbers for physical ranges and processors.                  |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "mm/numa.h"
+#include "sys/errno.h"
+
+struct numa_info numa_info = {
+    .nr_nodes = 1,
+};
+
+/* Section 5.2.6, ACPI Specification 6.5 */
+struct acpi_header {
+    char     signature[4];
+    uint32_t length;
+    uint8_t  revision;
+    uint8_t  checksum;
+    char     oem_id[6];
+    char     oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __packed;
+
+/* Section 5.2.16, ACPI Specification 6.5 */
+struct acpi_srat {
+    struct acpi_header header;
+    uint32_t           reserved_0;
+    uint64_t           reserved_1;
+} __packed;
+
+struct srat_entry {
+    uint8_t type;
+    uint8_t length;
+} __packed;
+
+struct srat_lapic {
+    uint8_t  type;
+    uint8_t  length;
+    uint8_t  domain_low;
+    uint8_t  apic_id;
+    uint32_t flags;
+    uint8_t  sapic_eid;
+    uint8_t  domain_high[3];
+    uint32_t clock_domain;
+} __packed;
+
+struct srat_memory {
+    uint8_t  type;
+    uint8_t  length;
+    uint32_t domain;
+    uint16_t reserved_0;
+    uint64_t base;
+    uint64_t size;
+    uint32_t reserved_1;
+    uint32_t flags;
+    uint64_t reserved_2;
+} __packed;
+
+struct srat_x2apic {
+    uint8_t  type;
+    uint8_t  length;
+    uint16_t reserved_0;
+    uint32_t domain;
+    uint32_t x2apic_id;
+    uint32_t flags;
+    uint32_t clock_domain;
+    uint32_t reserved_1;
+} __packed;
+
+#define SRAT_LAPIC                   0
+#define SRAT_MEMORY                  1
+#define SRAT_X2APIC                  2
+#define SRAT_ENABLED                 0x00000001
+
+/// @fn      static int numa_node(struct numa_info *info, uint32_t domain)
+/// @brief   Maps an ACPI proximity domain to a dense node number, allocating one on first sight.
+///
+/// @param   info the topology being built
+/// @param   domain the proximity domain
+/// @returns the node number, or -ENOSPC if more than CONFIG_MAX_NODES domains are present
+static int numa_node(struct numa_info *info, uint32_t domain)
+{
+    for (uint32_t n = 0; n < info->nr_nodes; n++)
+        if (info->domain[n] == domain)
+            return (int) n;
+
+    if (info->nr_nodes == CONFIG_MAX_NODES)
+        return -ENOSPC;
+    info->domain[info->nr_nodes] = domain;
+    return (int) info->nr_nodes++;
+}
+
+/// @fn      static int numa_parse(struct numa_info *info, const struct acpi_srat *srat)
+/// @brief   Collects the enabled memory and processor affinity entries of an SRAT.
+///
+/// @param   info the topology to fill, initially empty
+/// @param   srat the table
+/// @returns 0 on success, or -ENOSPC if the table describes more nodes, ranges or processors than fit
+static int numa_parse(struct numa_info *info, const struct acpi_srat *srat)
+{
+    const uint8_t *p   = (const uint8_t *) (srat + 1);
+    const uint8_t *end = (const uint8_t *) srat + srat->header.length;
+
+    while (p + sizeof(struct srat_entry) <= end) {
+        const struct srat_entry *e = (const struct srat_entry *) p;
+        if (e->length < sizeof(*e) || p + e->length > end)
+            break;
+        p += e->length;
+
+        uint32_t domain, apic_id;
+        if (e->type == SRAT_MEMORY && e->length >= sizeof(struct srat_memory)) {
+            const struct srat_memory *m = (const struct srat_memory *) e;
+            if (!(m->flags & SRAT_ENABLED) || !m->size)
+                continue;
+            int node = numa_node(info, m->domain);
+            if (node < 0 || info->nr_ranges == NUMA_MAX_RANGES)
+                return -ENOSPC;
+            info->ranges[info->nr_ranges++] = (struct numa_range) {
+                .base = m->base, .end = m->base + m->size, .node = (uint32_t) node,
+            };
+            continue;
+        } else if (e->type == SRAT_LAPIC && e->length >= sizeof(struct srat_lapic)) {
+            const struct srat_lapic *l = (const struct srat_lapic *) e;
+            if (!(l->flags & SRAT_ENABLED))
+                continue;
+            domain  = l->domain_low | (uint32_t) l->domain_high[0] << 8 | (uint32_t) l->domain_high[1] << 16 |
+                      (uint32_t) l->domain_high[2] << 24;
+            apic_id = l->apic_id;
+        } else if (e->type == SRAT_X2APIC && e->length >= sizeof(struct srat_x2apic)) {
+            const struct srat_x2apic *x = (const struct srat_x2apic *) e;
+            if (!(x->flags & SRAT_ENABLED))
+                continue;
+            domain  = x->domain;
+            apic_id = x->x2apic_id;
+        } else {
+            continue;
+        }
+
+        int node = numa_node(info, domain);
+        if (node < 0 || info->nr_cpus == CONFIG_MAX_CPUS)
+            return -ENOSPC;
+        info->cpus[info->nr_cpus++] = (struct numa_cpu) { .apic_id = apic_id, .node = (uint32_t) node };
+    }
+    return 0;
+}
+
+/// @fn      int numa_init(const void *srat)
+/// @brief   Builds the node topology from the ACPI SRAT.
+///
+/// @details Must run on the bootstrap processor before frame_init(). On any error, and when srat is NULL, the single
+/// node default is kept, which is always safe: the allocator merely loses locality.
+///
+/// @param   srat the SRAT, accessible through the direct map, or NULL if the firmware provides none
+/// @returns 0 on success or without an SRAT, -EINVAL if the table is malformed, or -ENOSPC if it does not fit
+int numa_init(const void *srat)
+{
+    static struct numa_info parsed;
+    const struct acpi_srat *table = srat;
+    uint8_t                 sum   = 0;
+
+    if (!table)
+        return 0;
+    if (__builtin_memcmp(table->header.signature, "SRAT", 4) || table->header.length < sizeof(*table))
+        return -EINVAL;
+    for (uint32_t i = 0; i < table->header.length; i++)
+        sum += ((const uint8_t *) table)[i];
+    if (sum)
+        return -EINVAL;
+
+    int rc = numa_parse(&parsed, table);
+    if (rc)
+        return rc;
+    if (parsed.nr_nodes && parsed.nr_ranges)
+        numa_info = parsed;
+    return 0;
+}
+
+/// @fn      uint32_t numa_node_of_apic(uint32_t apic_id)
+/// @brief   Returns the node of a processor.
+///
+/// @param   apic_id the processor's (x2)APIC ID
+/// @returns the node number, or 0 if the SRAT does not list the processor
+uint32_t numa_node_of_apic(uint32_t apic_id)
+{
+    for (uint32_t i = 0; i < numa_info.nr_cpus; i++)
+        if (numa_info.cpus[i].apic_id == apic_id)
+            return numa_info.cpus[i].node;
+    return 0;
+}
+
+/// @fn      uint32_t numa_node_of_phys(uint64_t phys, uint64_t *end)
+/// @brief   Returns the node of a physical address and how far that answer extends.
+///
+/// @details Addresses outside every SRAT range are assigned to node 0, up to the start of the next range.
+///
+/// @param   phys the physical address
+/// @param   end  receives the first address above phys whose node may differ
+/// @returns the node number
+uint32_t numa_node_of_phys(uint64_t phys, uint64_t *end)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (uint32_t i = 0; i < numa_info.nr_ranges; i++) {
+        const struct numa_range *r = &numa_info.ranges[i];
+        if (phys >= r->base && phys < r->end) {
+            *end = r->end;
+            return r->node;
+        }
+        if (r->base > phys && r->base < next)
+            next = r->base;
+    }
+    *end = next;
+    return 0;
+}
\ No newline at end of file
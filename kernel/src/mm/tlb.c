@@ -0,0 +1,217 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/mm/tlb.c                                                                               |
+// | Name          : TLB Shootdown                                                                                     |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements batched invalidation with one multicast IPI per flush and per-CPU acknowledgements.    |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "arch/vectors.h"
+#include "mm/layout.h"
+#include "mm/tlb.h"
+#include "mm/vm.h"
+
+struct tlb_cpu tlb_cpus[CONFIG_MAX_CPUS];
+
+static struct cpumask tlb_online;                   /* every processor caches kernel mappings */
+
+/// @fn      void tlb_init_cpu(unsigned int cpu)
+/// @brief   Makes the executing processor a target of kernel-space shootdowns. Called from vm_init_cpu().
+///
+/// @param   cpu the executing processor's logical CPU index
+/// @returns None (void)
+void tlb_init_cpu(unsigned int cpu)
+{
+    cpumask_set_atomic(&tlb_online, cpu);
+}
+
+/// @fn      void tlb_batch_add(struct tlb_batch *batch, uint64_t va, uint64_t size)
+/// @brief   Records a range whose translations must be invalidated.
+///
+/// @param   batch the batch
+/// @param   va    the first address, page aligned
+/// @param   size  the size of the range, a multiple of PAGE_SIZE
+/// @returns None (void)
+void tlb_batch_add(struct tlb_batch *batch, uint64_t va, uint64_t size)
+{
+    uint64_t pages = size >> PAGE_SHIFT;
+
+    if (batch->full)
+        return;
+    if (pages > TLB_FLUSH_MAX_PAGES - batch->pages) {
+        batch->full = true;
+        return;
+    }
+    batch->pages += (uint32_t) pages;
+
+    if (batch->nr && batch->ranges[batch->nr - 1].end == va) {
+        batch->ranges[batch->nr - 1].end += size;
+    } else if (batch->nr == TLB_BATCH_RANGES) {
+        batch->full = true;
+    } else {
+        batch->ranges[batch->nr].start = va;
+        batch->ranges[batch->nr].end   = va + size;
+        batch->nr++;
+    }
+}
+
+/// @fn      static void tlb_flush_local(struct tlb_cpu *tc, const struct tlb_batch *batch)
+/// @brief   Applies a batch to the executing processor's TLB.
+///
+/// @details Upper-half mappings are global and shared by every space, so kernel batches always apply. A user space
+/// that is no longer loaded here is skipped: if it still holds a PCID slot, the slot's generation is now stale and the
+/// next switch to the space flushes it. Ranges are invalidated with INVLPG; a full flush drops the space's PCID with
+/// INVPCID, or reloads CR3 without CR3_NOFLUSH where INVPCID is unavailable.
+///
+/// @param   tc    the executing processor's shootdown state
+/// @param   batch the invalidations
+/// @returns None (void)
+static void tlb_flush_local(struct tlb_cpu *tc, const struct tlb_batch *batch)
+{
+    struct vm_cpu *vc     = &vm_cpus[this_cpu_read(cpu)];
+    bool           kernel = batch->space == &vm_kernel;
+
+    if (!kernel && vc->current != batch->space)
+        return;
+
+    uint16_t pcid = vm_config.pcid && vc->current != &vm_kernel ? (uint16_t) (vc->slot + 1) : 0;
+
+    tc->local_flushes++;
+    if (!batch->full) {
+        for (uint32_t i = 0; i < batch->nr; i++) {
+            for (uint64_t va = batch->ranges[i].start; va < batch->ranges[i].end; va += PAGE_SIZE)
+                _invlpg((const void *) va);
+        }
+    } else if (kernel) {
+        tc->full_flushes++;
+        if (vm_config.invpcid) {
+            _invpcid(INVPCID_ALL_GLOBAL, 0, 0);
+        } else {
+            uint64_t cr4 = _rdcr4();
+            _wrcr4(cr4 & ~CR4_PGE);
+            _wrcr4(cr4);
+        }
+    } else {
+        tc->full_flushes++;
+        if (vm_config.invpcid)
+            _invpcid(INVPCID_SINGLE, pcid, 0);
+        else
+            _wrcr3(batch->space->root | pcid);
+    }
+
+    if (!kernel && vm_config.pcid && vc->pcids[vc->slot].gen == batch->gen - 1)
+        vc->pcids[vc->slot].gen = batch->gen;
+}
+
+/// @fn      static void tlb_handle_pending(unsigned int cpu)
+/// @brief   Serves every request queued for the executing processor and acknowledges each to its initiator.
+///
+/// @param   cpu the executing processor's logical CPU index
+/// @returns None (void)
+static void tlb_handle_pending(unsigned int cpu)
+{
+    struct tlb_cpu *tc = &tlb_cpus[cpu];
+    int             from;
+
+    for_each_cpu(from, &tc->pending) {
+        if (!cpumask_test_and_clear_atomic(&tc->pending, (unsigned int) from))
+            continue;
+        const struct tlb_cpu *initiator = &tlb_cpus[from];
+        tlb_flush_local(tc, &initiator->req);
+        __atomic_store_n(&tc->acks[from], initiator->seq, __ATOMIC_RELEASE);
+        tc->handled++;
+    }
+}
+
+/// @fn      void tlb_flush(struct tlb_batch *batch)
+/// @brief   Invalidates a batch on every processor that may hold the translations, and waits until they have.
+///
+/// @details Called after the page-table entries are cleared and before the pages they mapped are reused, without the
+/// space's lock held. The space's generation is bumped first; because vm_switch() joins the active set before reading
+/// the generation, a processor not seen in the set below will flush the space on its next switch to it, and so does
+/// any processor that ran the space earlier and still caches it under a PCID. Only the processors with the space
+/// loaded are interrupted, with a single multicast IPI. Each acknowledges in its own line, and the initiator serves
+/// requests aimed at it while it waits, so two processors shooting down each other cannot deadlock with interrupts
+/// disabled.
+///
+/// @param   batch the invalidations; batch->gen is set here
+/// @returns None (void)
+void tlb_flush(struct tlb_batch *batch)
+{
+    struct vm_space *space = batch->space;
+
+    if (!batch->nr && !batch->full)
+        return;
+
+    uint64_t        flags = irq_save();
+    unsigned int    self  = this_cpu_read(cpu);
+    struct tlb_cpu *tc    = &tlb_cpus[self];
+    struct cpumask  targets;
+    bool            remote = false;
+    int             cpu;
+
+    batch->gen = __atomic_add_fetch(&space->tlb_gen, 1, __ATOMIC_SEQ_CST);
+    tlb_flush_local(tc, batch);
+
+    const struct cpumask *set = space == &vm_kernel ? &tlb_online : &space->active;
+    for (unsigned int i = 0; i < CPUMASK_WORDS; i++) {
+        targets.bits[i] = __atomic_load_n(&set->bits[i], __ATOMIC_RELAXED);
+        if (i == self / 64)
+            targets.bits[i] &= ~(1ULL << (self % 64));
+        remote |= targets.bits[i] != 0;
+    }
+
+    if (remote) {
+        tc->req = *batch;
+        uint32_t seq = ++tc->seq;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        for_each_cpu(cpu, &targets) {
+            cpumask_set_atomic(&tlb_cpus[cpu].pending, self);
+            tc->targets++;
+        }
+        apic_send_ipi_mask(&targets, VECTOR_IPI_TLB_SHOOTDOWN);
+        tc->shootdowns++;
+
+        for_each_cpu(cpu, &targets) {
+            while (__atomic_load_n(&tlb_cpus[cpu].acks[self], __ATOMIC_ACQUIRE) != seq) {
+                tlb_handle_pending(self);
+                _pause();
+            }
+        }
+    }
+    irq_restore(flags);
+}
+
+/// @fn      void tlb_shootdown_interrupt(void)
+/// @brief   Handles VECTOR_IPI_TLB_SHOOTDOWN: other processors changed a space this one may be running.
+///
+/// @returns None (void)
+void tlb_shootdown_interrupt(void)
+{
+    tlb_handle_pending(this_cpu_read(cpu));
+    apic_eoi();
+}
\ No newline at end of file
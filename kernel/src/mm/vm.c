@@ -0,0 +1,601 @@
+// +-------------------------------------------------------------------------------------------------------------------+
+// | File          : kernel/src/mm/vm.c                                                                                |
+// | Name          : Address Spaces                                                                                    |
+// | Project       : Shasta Microkernel                                                                                |
+// | Author        : Elijah Creed Fedele                                                                               |
+// | Contributors  : see CONTRIBUTORS.md                                                                               |
+// | Version       : 0.0.0                                                                                             |
+// | License       : GNU General Public License (GPL), version 3.0                                                     |
+// | Date Created  : October 18, 2026                                                                                  |
+// | Date Modified : October 18, 2026                                                                                  |
+// | Description   : Implements page tables of 4 or 5 levels, the huge-page direct map and PCID-tagged address spaces. |
+// +-------------------------------------------------------------------------------------------------------------------+
+// | Copyright (C) 2026 Elijah Creed Fedele                                                                            |
+// |                                                                                                                   |
+// | This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public | 
+// | License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any    |
+// | later version.                                                                                                    |
+// |                                                                                                                   |
+// | This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the        | 
+// | implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   | 
+// | more details.                                                                                                     |
+// |                                                                                                                   |
+// | You should have received a copy of the GNU General Public License along with this program.  If not, see           |
+// |     <http://www.gnu.org/licenses/>.                                                                               |
+// +-------------------------------------------------------------------------------------------------------------------+
+
+#include "arch/apic.h"
+#include "arch/cpu.h"
+#include "arch/cr.h"
+#include "arch/inst.h"
+#include "arch/irq.h"
+#include "arch/msr.h"
+#include "arch/paging.h"
+#include "arch/percpu.h"
+#include "arch/spec.h"
+#include "mm/frame.h"
+#include "mm/layout.h"
+#include "mm/tlb.h"
+#include "mm/vm.h"
+#include "sys/efi.h"
+#include "sys/errno.h"
+
+struct vm_config vm_config;
+struct vm_space  vm_kernel = { .lock = SPINLOCK_INIT };
+struct vm_cpu    vm_cpus[CONFIG_MAX_CPUS];
+
+static uint64_t vm_next_id = 1;                     /* 0 is vm_kernel, which never occupies a PCID slot */
+
+_Static_assert(CONFIG_VM_PCID_SLOTS >= 1 && CONFIG_VM_PCID_SLOTS <= CR3_PCID_MASK,
+               "CONFIG_VM_PCID_SLOTS must leave room for PCID 0");
+
+/// @fn      static uint64_t vm_table_alloc(void)
+/// @brief   Allocates and clears one page-table page.
+///
+/// @returns the table's physical address, or 0 if no memory is available
+static uint64_t vm_table_alloc(void)
+{
+    uint64_t phys = frame_alloc();
+
+    if (phys) {
+        uint64_t *table = phys_to_virt(phys);
+        for (unsigned int i = 0; i < PT_ENTRIES; i++)
+            table[i] = 0;
+    }
+    return phys;
+}
+
+/// @fn      static int vm_walk(struct vm_space *space, uint64_t va, unsigned int level, uint64_t **entry)
+/// @brief   Finds the entry that maps va at a given level, creating the tables above it as needed.
+///
+/// @param   space the address space, locked
+/// @param   va    the virtual address
+/// @param   level the level of the wanted entry (PT_LEVEL_PT for a 4 KiB page)
+/// @param   entry receives the entry's address
+/// @returns 0 on success, -ENOMEM if a table could not be allocated, or -EEXIST if a larger page covers va
+static int vm_walk(struct vm_space *space, uint64_t va, unsigned int level, uint64_t **entry)
+{
+    uint64_t *table = phys_to_virt(space->root);
+
+    for (unsigned int l = vm_config.levels; l > level; l--) {
+        uint64_t *e = &table[PT_INDEX(va, l)];
+        if (!(*e & PTE_P)) {
+            uint64_t phys = vm_table_alloc();
+            if (!phys)
+                return -ENOMEM;
+            *e = phys | PTE_P | PTE_W | (va < vm_config.user_end ? PTE_U : 0);
+        } else if (*e & PTE_PS) {
+            return -EEXIST;
+        }
+        table = phys_to_virt(*e & PTE_ADDR);
+    }
+    *entry = &table[PT_INDEX(va, level)];
+    return 0;
+}
+
+/// @fn      static uint64_t *vm_leaf(const struct vm_space *space, uint64_t va, unsigned int *level)
+/// @brief   Finds the entry that translates va, whatever its page size.
+///
+/// @param   space the address space
+/// @param   va    the virtual address
+/// @param   level receives the level of the returned entry, or of the first non-present entry on the path
+/// @returns the leaf entry, or NULL if va is not mapped
+static uint64_t *vm_leaf(const struct vm_space *space, uint64_t va, unsigned int *level)
+{
+    uint64_t *table = phys_to_virt(space->root);
+
+    for (unsigned int l = vm_config.levels;; l--) {
+        uint64_t *e = &table[PT_INDEX(va, l)];
+        *level = l;
+        if (!(*e & PTE_P))
+            return NULL;
+        if (l == PT_LEVEL_PT || (*e & PTE_PS))
+            return e;
+        table = phys_to_virt(*e & PTE_ADDR);
+    }
+}
+
+/// @fn      static unsigned int vm_page_level(uint64_t va, uint64_t pa, uint64_t size)
+/// @brief   Picks the largest page that starts at va, maps pa and fits within size.
+///
+/// @param   va   the virtual address
+/// @param   pa   the physical address
+/// @param   size bytes left to map
+/// @returns PT_LEVEL_PDPT for 1 GiB, PT_LEVEL_PD for 2 MiB, or PT_LEVEL_PT for 4 KiB
+static unsigned int vm_page_level(uint64_t va, uint64_t pa, uint64_t size)
+{
+    for (unsigned int level = vm_config.gbpages ? PT_LEVEL_PDPT : PT_LEVEL_PD; level > PT_LEVEL_PT; level--) {
+        uint64_t page = 1ULL << PT_SHIFT(level);
+        if (!((va | pa) & (page - 1)) && size >= page)
+            return level;
+    }
+    return PT_LEVEL_PT;
+}
+
+/// @fn      static bool vm_direct_mapped(const struct efi_memory_descriptor *d)
+/// @brief   Tests whether a UEFI memory region belongs in the direct map.
+///
+/// @details Everything backed by memory is included; MMIO, reserved and unusable ranges are left to explicit mappings
+/// with the caching their devices need.
+///
+/// @param   d the memory descriptor
+/// @returns true if the region is mapped at DIRECT_MAP_BASE + its physical address
+static bool vm_direct_mapped(const struct efi_memory_descriptor *d)
+{
+    switch (d->type) {
+    case EFI_LOADER_CODE:
+    case EFI_LOADER_DATA:
+    case EFI_BOOT_SERVICES_CODE:
+    case EFI_BOOT_SERVICES_DATA:
+    case EFI_RUNTIME_SERVICES_CODE:
+    case EFI_RUNTIME_SERVICES_DATA:
+    case EFI_CONVENTIONAL_MEMORY:
+    case EFI_ACPI_RECLAIM_MEMORY:
+    case EFI_ACPI_MEMORY_NVS:
+    case EFI_PERSISTENT_MEMORY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// @fn      int vm_init(const void *map, size_t map_size, size_t desc_size)
+/// @brief   Builds the kernel address space: the direct map in huge pages and the adopted kernel image mapping.
+///
+/// @details Called once on the BSP after frame_init(), while the boot loader's tables (and its direct map) are still
+/// loaded; vm_init_cpu() then switches to the new tables. Adjacent regions with the same caching are merged before
+/// mapping, so most of memory is covered by 1 GiB pages where the processor supports them and by 2 MiB pages
+/// otherwise, leaving 4 KiB pages only at unaligned region edges. Direct-map entries are global, so they survive
+/// address-space switches. Every upper-half top-level entry is populated here so that later kernel mappings reach all
+/// spaces; the kernel image (the top 2 GiB) keeps the loader's tables, which live in loader data and are never freed.
+/// The local APIC page, which is MMIO and so not in the direct map, is added last by apic_map(); on the BSP this must
+/// therefore follow apic_init().
+///
+/// @param   map       the UEFI memory map
+/// @param   map_size  the size of the map, in bytes
+/// @param   desc_size the descriptor stride reported by GetMemoryMap()
+/// @returns 0 on success, -EINVAL if desc_size is too small, -ENOMEM if page tables could not be allocated, or
+/// -EEXIST if the map describes overlapping regions or the APIC page inside memory
+int vm_init(const void *map, size_t map_size, size_t desc_size)
+{
+    const uint8_t *base = map;
+
+    if (desc_size < sizeof(struct efi_memory_descriptor))
+        return -EINVAL;
+
+    vm_config.levels   = (_rdcr4() & CR4_LA57) ? PT_LEVEL_PML5 : PT_LEVEL_PML4;
+    vm_config.pcid     = cpu_has(CPU_FEATURE_PCID);
+    vm_config.invpcid  = vm_config.pcid && cpu_has(CPU_FEATURE_INVPCID);
+    vm_config.gbpages  = cpu_has(CPU_FEATURE_PDPE1GB);
+    vm_config.nx       = cpu_has(CPU_FEATURE_NX) ? PTE_NX : 0;
+    vm_config.user_end = 1ULL << (PT_SHIFT(vm_config.levels) + 8);
+
+    vm_kernel.root = vm_table_alloc();
+    if (!vm_kernel.root)
+        return -ENOMEM;
+
+    // With LA57 the last top-level entry covers both the direct map and the kernel image, so the loader's entry is
+    // grafted one level down, into the PML4 under it.
+    uint64_t       *top  = phys_to_virt(vm_kernel.root);
+    const uint64_t *boot = phys_to_virt(_rdcr3() & PTE_ADDR);
+    for (unsigned int l = vm_config.levels; l > PT_LEVEL_PML4; l--)
+        boot = phys_to_virt(boot[PT_ENTRIES - 1] & PTE_ADDR);
+
+    for (unsigned int i = PT_ENTRIES / 2; i < PT_ENTRIES; i++) {
+        if (i == PT_ENTRIES - 1 && vm_config.levels == PT_LEVEL_PML4) {
+            top[i] = boot[i];
+            continue;
+        }
+        uint64_t table = vm_table_alloc();
+        if (!table)
+            return -ENOMEM;
+        top[i] = table | PTE_P | PTE_W;
+    }
+    if (vm_config.levels == PT_LEVEL_PML5) {
+        uint64_t *pml4 = phys_to_virt(top[PT_ENTRIES - 1] & PTE_ADDR);
+        pml4[PT_ENTRIES - 1] = boot[PT_ENTRIES - 1];
+    }
+
+    uint64_t run_start = 0, run_end = 0, run_flags = 0;
+    for (size_t off = 0; off <= map_size; off += desc_size) {
+        uint64_t start = 0, end = 0, flags = 0;
+        if (off + desc_size <= map_size) {
+            const struct efi_memory_descriptor *d = (const struct efi_memory_descriptor *) (base + off);
+            if (!vm_direct_mapped(d))
+                continue;
+            start = d->physical_start;
+            end   = start + (d->number_of_pages << EFI_PAGE_SHIFT);
+            flags = PTE_W | PTE_G | vm_config.nx | ((d->attribute & EFI_MEMORY_WB) ? 0 : PTE_PCD | PTE_PWT);
+            if (start == run_end && flags == run_flags) {
+                run_end = end;
+                continue;
+            }
+        }
+        if (run_end > run_start) {
+            int err = vm_map(&vm_kernel, DIRECT_MAP_BASE + run_start, run_start, run_end - run_start, run_flags);
+            if (err)
+                return err;
+        }
+        run_start = start;
+        run_end   = end;
+        run_flags = flags;
+    }
+    return apic_map();
+}
+
+/// @fn      void vm_init_cpu(unsigned int cpu)
+/// @brief   Enables global pages, PCIDs and no-execute on the executing processor and loads the kernel address space.
+///
+/// @details Called on every processor after vm_init(). CR4.PCIDE may only be set while CR3 selects PCID 0, so CR3 is
+/// loaded first.
+///
+/// @param   cpu the executing processor's logical CPU index
+/// @returns None (void)
+void vm_init_cpu(unsigned int cpu)
+{
+    struct vm_cpu *vc  = &vm_cpus[cpu];
+    uint64_t       cr4 = _rdcr4() | CR4_PGE;
+
+    if (vm_config.nx)
+        _wrmsr(IA32_EFER, _rdmsr(IA32_EFER) | EFER_NXE);
+    _wrcr3(vm_kernel.root);
+    if (vm_config.pcid)
+        cr4 |= CR4_PCIDE;
+    _wrcr4(cr4);
+
+    vc->current   = &vm_kernel;
+    vc->slot      = 0;
+    vc->next_slot = 0;
+    cpumask_set_atomic(&vm_kernel.active, cpu);
+    tlb_init_cpu(cpu);
+}
+
+/// @fn      int vm_space_init(struct vm_space *space)
+/// @brief   Creates an empty user address space sharing the kernel's upper half.
+///
+/// @param   space the space to initialize
+/// @returns 0 on success, or -ENOMEM if the top-level table could not be allocated
+int vm_space_init(struct vm_space *space)
+{
+    uint64_t root = vm_table_alloc();
+
+    if (!root)
+        return -ENOMEM;
+
+    uint64_t       *dst = phys_to_virt(root);
+    const uint64_t *src = phys_to_virt(vm_kernel.root);
+    for (unsigned int i = PT_ENTRIES / 2; i < PT_ENTRIES; i++)
+        dst[i] = src[i];
+
+    space->root       = root;
+    space->id         = __atomic_fetch_add(&vm_next_id, 1, __ATOMIC_RELAXED);
+    space->tlb_gen    = 0;
+    space->lock       = (struct spinlock) SPINLOCK_INIT;
+    space->spec_label = 0;
+    cpumask_clear_all(&space->active);
+    return 0;
+}
+
+/// @fn      static void vm_free_table(uint64_t phys, unsigned int level)
+/// @brief   Frees a page table and the tables below it. Mapped pages are left to their owners.
+///
+/// @param   phys  the table's physical address
+/// @param   level the table's level
+/// @returns None (void)
+static void vm_free_table(uint64_t phys, unsigned int level)
+{
+    const uint64_t *table = phys_to_virt(phys);
+
+    if (level > PT_LEVEL_PT) {
+        for (unsigned int i = 0; i < PT_ENTRIES; i++) {
+            if ((table[i] & PTE_P) && !(table[i] & PTE_PS))
+                vm_free_table(table[i] & PTE_ADDR, level - 1);
+        }
+    }
+    frame_free(phys);
+}
+
+/// @fn      void vm_space_destroy(struct vm_space *space)
+/// @brief   Frees a user address space's page tables.
+///
+/// @details The space must not be loaded on any processor. Stale PCID slots elsewhere are harmless: they are keyed by
+/// the space's id, which is never reused.
+///
+/// @param   space the space to destroy
+/// @returns None (void)
+void vm_space_destroy(struct vm_space *space)
+{
+    const uint64_t *top = phys_to_virt(space->root);
+
+    for (unsigned int i = 0; i < PT_ENTRIES / 2; i++) {
+        if (top[i] & PTE_P)
+            vm_free_table(top[i] & PTE_ADDR, vm_config.levels - 1);
+    }
+    frame_free(space->root);
+    space->root = 0;
+}
+
+/// @fn      int vm_map(struct vm_space *space, uint64_t va, uint64_t pa, uint64_t size, uint64_t flags)
+/// @brief   Maps a physically contiguous range, using the largest pages its alignment allows.
+///
+/// @details No invalidation is needed because only non-present entries are filled. On failure the pages mapped before
+/// the error remain mapped.
+///
+/// @param   space the address space
+/// @param   va    the first virtual address, page aligned
+/// @param   pa    the first physical address, page aligned
+/// @param   size  the size of the range, a non-zero multiple of PAGE_SIZE
+/// @param   flags PTE_* bits other than PTE_P, PTE_PS and the address (PTE_W, PTE_U, PTE_NX, PTE_G, caching)
+/// @returns 0 on success, -EINVAL for a misaligned or empty range, -ENOMEM if a table could not be allocated, or
+/// -EEXIST if part of the range is already mapped
+int vm_map(struct vm_space *space, uint64_t va, uint64_t pa, uint64_t size, uint64_t flags)
+{
+    int err = 0;
+
+    if (!size || ((va | pa | size) & ~PAGE_MASK))
+        return -EINVAL;
+    flags &= ~(PTE_ADDR | PTE_PS | PTE_P);
+
+    uint64_t irq = irq_save();
+    spin_lock(&space->lock);
+    while (size) {
+        unsigned int level = vm_page_level(va, pa, size);
+        uint64_t    *e;
+        if ((err = vm_walk(space, va, level, &e)))
+            break;
+        if (*e & PTE_P) {
+            err = -EEXIST;
+            break;
+        }
+        *e = pa | flags | PTE_P | (level > PT_LEVEL_PT ? PTE_PS : 0);
+
+        uint64_t page = 1ULL << PT_SHIFT(level);
+        va   += page;
+        pa   += page;
+        size -= page;
+    }
+    spin_unlock(&space->lock);
+    irq_restore(irq);
+    return err;
+}
+
+/// @fn      int vm_unmap_batch(struct vm_space *space, uint64_t va, uint64_t size, struct tlb_batch *batch)
+/// @brief   Removes the mappings in a range and records them for invalidation, without flushing any TLB.
+///
+/// @details Lets a caller tearing down several ranges pay for one shootdown. The pages stay reachable through stale
+/// translations until tlb_flush(batch) returns, so they must not be reused before then. Holes in the range are
+/// skipped. A large page must lie wholly inside the range; one that straddles an end stops the walk with -EINVAL,
+/// leaving the part already processed unmapped and recorded.
+///
+/// @param   space the address space
+/// @param   va    the first virtual address, page aligned
+/// @param   size  the size of the range, a non-zero multiple of PAGE_SIZE
+/// @param   batch a batch started for space with tlb_batch_init()
+/// @returns 0 on success, or -EINVAL for a misaligned range, a partially covered large page or a foreign batch
+int vm_unmap_batch(struct vm_space *space, uint64_t va, uint64_t size, struct tlb_batch *batch)
+{
+    uint64_t left = size;
+    int      err  = 0;
+
+    if (!size || ((va | size) & ~PAGE_MASK) || batch->space != space)
+        return -EINVAL;
+
+    uint64_t irq = irq_save();
+    spin_lock(&space->lock);
+    for (;;) {
+        unsigned int level;
+        uint64_t    *e    = vm_leaf(space, va, &level);
+        uint64_t     page = 1ULL << PT_SHIFT(level);
+        uint64_t     next = (va & ~(page - 1)) + page;
+        if (e) {
+            if ((va & (page - 1)) || left < page) {
+                err = -EINVAL;
+                break;
+            }
+            *e = 0;
+            tlb_batch_add(batch, va, page);
+        }
+        if (next - va >= left)
+            break;
+        left -= next - va;
+        va    = next;
+    }
+    spin_unlock(&space->lock);
+    irq_restore(irq);
+    return err;
+}
+
+/// @fn      int vm_unmap(struct vm_space *space, uint64_t va, uint64_t size)
+/// @brief   Removes the mappings in a range and invalidates them on every processor that may cache them.
+///
+/// @details The shootdown runs after the space's lock is dropped; see vm_unmap_batch() and tlb_flush().
+///
+/// @param   space the address space
+/// @param   va    the first virtual address, page aligned
+/// @param   size  the size of the range, a non-zero multiple of PAGE_SIZE
+/// @returns 0 on success, or -EINVAL for a misaligned range or a partially covered large page
+int vm_unmap(struct vm_space *space, uint64_t va, uint64_t size)
+{
+    struct tlb_batch batch;
+
+    tlb_batch_init(&batch, space);
+    int err = vm_unmap_batch(space, va, size, &batch);
+    tlb_flush(&batch);
+    return err;
+}
+
+/// @fn      int vm_translate(struct vm_space *space, uint64_t va, uint64_t *pa, uint64_t *flags)
+/// @brief   Looks up the physical address and permissions behind a virtual address.
+///
+/// @param   space the address space
+/// @param   va    the virtual address
+/// @param   pa    receives the physical address
+/// @param   flags if not NULL, receives the leaf entry's PTE_* bits other than the address
+/// @returns 0 on success, or -EFAULT if va is not mapped
+int vm_translate(struct vm_space *space, uint64_t va, uint64_t *pa, uint64_t *flags)
+{
+    unsigned int level;
+    int          err = -EFAULT;
+
+    uint64_t irq = irq_save();
+    spin_lock(&space->lock);
+    const uint64_t *e = vm_leaf(space, va, &level);
+    if (e) {
+        uint64_t page = 1ULL << PT_SHIFT(level);
+        *pa = (*e & PTE_ADDR & ~(page - 1)) | (va & (page - 1));
+        if (flags)
+            *flags = *e & ~PTE_ADDR;
+        err = 0;
+    }
+    spin_unlock(&space->lock);
+    irq_restore(irq);
+    return err;
+}
+
+/// @fn      static int vm_copy(struct vm_space *space, uint64_t va, uint64_t *buf, size_t size, bool out)
+/// @brief   Copies between kernel memory and user memory of an address space through the direct map.
+///
+/// @details Each user page is looked up, checked for PTE_U (and PTE_W when writing it), and accessed with the space's
+/// lock held, so an unmap cannot retire the frame halfway through. A fault stops the copy with the pages before it
+/// copied. Nothing is kept across calls: the user mapping is translated afresh every time.
+///
+/// @param   space the address space
+/// @param   va    the user address, 8-byte aligned
+/// @param   buf   the kernel buffer, 8-byte aligned
+/// @param   size  the number of bytes, a multiple of 8
+/// @param   out   true to copy buf to user memory, false to copy user memory to buf
+/// @returns 0 on success, -EINVAL for a misaligned or non-user range, or -EFAULT if a page is not mapped for user mode
+/// with the access needed
+static int vm_copy(struct vm_space *space, uint64_t va, uint64_t *buf, size_t size, bool out)
+{
+    uint64_t need = out ? PTE_U | PTE_W : PTE_U;
+    int      err  = 0;
+
+    if (((va | size | (uintptr_t) buf) & 7) || va > vm_config.user_end || size > vm_config.user_end - va)
+        return -EINVAL;
+
+    uint64_t irq = irq_save();
+    spin_lock(&space->lock);
+    while (size) {
+        unsigned int    level;
+        const uint64_t *e = vm_leaf(space, va, &level);
+        if (!e || (*e & need) != need) {
+            err = -EFAULT;
+            break;
+        }
+
+        uint64_t  page  = 1ULL << PT_SHIFT(level);
+        uint64_t  chunk = page - (va & (page - 1));
+        uint64_t *user  = phys_to_virt((*e & PTE_ADDR & ~(page - 1)) | (va & (page - 1)));
+        uint64_t *to    = out ? user : buf;
+        uint64_t *from  = out ? buf : user;
+        if (chunk > size)
+            chunk = size;
+        for (uint64_t i = 0; i < chunk / 8; i++)            /* not a memcpy() call: there is none to link */
+            __atomic_store_n(&to[i], from[i], __ATOMIC_RELAXED);
+
+        buf  += chunk / 8;
+        va   += chunk;
+        size -= chunk;
+    }
+    spin_unlock(&space->lock);
+    irq_restore(irq);
+    return err;
+}
+
+/// @fn      int vm_copy_out(struct vm_space *space, uint64_t va, const void *src, size_t size)
+/// @brief   Copies kernel data into user memory of an address space.
+///
+/// @param   space the destination address space
+/// @param   va    the destination user address, 8-byte aligned
+/// @param   src   the source, 8-byte aligned
+/// @param   size  the number of bytes, a multiple of 8
+/// @returns 0 on success, -EINVAL for a misaligned or non-user range, or -EFAULT if a page is not mapped writable for
+/// user mode
+int vm_copy_out(struct vm_space *space, uint64_t va, const void *src, size_t size)
+{
+    return vm_copy(space, va, (uint64_t *) src, size, true);
+}
+
+/// @fn      int vm_copy_in(struct vm_space *space, uint64_t va, void *dst, size_t size)
+/// @brief   Copies user memory of an address space into kernel memory.
+///
+/// @param   space the source address space
+/// @param   va    the source user address, 8-byte aligned
+/// @param   dst   the destination, 8-byte aligned
+/// @param   size  the number of bytes, a multiple of 8
+/// @returns 0 on success, -EINVAL for a misaligned or non-user range, or -EFAULT if a page is not mapped for user mode
+int vm_copy_in(struct vm_space *space, uint64_t va, void *dst, size_t size)
+{
+    return vm_copy(space, va, dst, size, false);
+}
+
+/// @fn      void vm_switch(unsigned int cpu, struct vm_space *next)
+/// @brief   Loads an address space on the executing processor, keeping its TLB entries when they are still valid.
+///
+/// @details Each processor tags up to CONFIG_VM_PCID_SLOTS user spaces with PCIDs 1..n, reused round robin, so PCIDs
+/// never need to be allocated globally or shot down when recycled. A space found in a slot whose generation matches is
+/// loaded with CR3_NOFLUSH; otherwise the CR3 write itself flushes the PCID. The processor joins next->active before
+/// reading the generation, so an unmap racing with the switch either sees it active or is seen here. The previous
+/// space is left only after CR3 no longer references its tables. Speculation barriers due between the two domains
+/// are issued last.
+///
+/// @param   cpu  the executing processor's logical CPU index
+/// @param   next the space to load
+/// @returns None (void)
+void vm_switch(unsigned int cpu, struct vm_space *next)
+{
+    struct vm_cpu   *vc   = &vm_cpus[cpu];
+    struct vm_space *prev = vc->current;
+    uint64_t         cr3  = next->root;
+
+    cpumask_set_atomic(&next->active, cpu);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t gen = __atomic_load_n(&next->tlb_gen, __ATOMIC_ACQUIRE);
+
+    if (vm_config.pcid && next == &vm_kernel) {
+        cr3 |= CR3_NOFLUSH;
+    } else if (vm_config.pcid) {
+        unsigned int slot = 0;
+        while (slot < CONFIG_VM_PCID_SLOTS && vc->pcids[slot].id != next->id)
+            slot++;
+        if (slot < CONFIG_VM_PCID_SLOTS && vc->pcids[slot].gen == gen) {
+            cr3 |= CR3_NOFLUSH;
+            vc->pcid_hits++;
+        } else if (slot == CONFIG_VM_PCID_SLOTS) {
+            slot          = vc->next_slot;
+            vc->next_slot = (slot + 1) % CONFIG_VM_PCID_SLOTS;
+            vc->pcids[slot].id = next->id;
+        }
+        vc->pcids[slot].gen = gen;
+        vc->slot            = slot;
+        cr3                |= slot + 1;
+    }
+    _wrcr3(cr3);
+
+    vc->current = next;
+    vc->switches++;
+    if (prev && prev != next)
+        cpumask_clear_atomic(&prev->active, cpu);
+    spec_switch(cpu, next);
+}
\ No newline at end of file